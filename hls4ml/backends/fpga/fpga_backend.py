@@ -9,7 +9,8 @@ import re
 from hls4ml.backends.backend import Backend
 from hls4ml.model.layers import Layer
 from hls4ml.model.attributes import Attribute
-from hls4ml.model.types import IntegerPrecisionType, FixedPrecisionType, XnorPrecisionType, ExponentPrecisionType
+from hls4ml.model.types import IntegerPrecisionType, FixedPrecisionType, XnorPrecisionType, ExponentPrecisionType, CodebookPrecisionType
+from hls4ml.model.types import RoundingMode, SaturationMode
 from hls4ml.writer import get_writer
 from hls4ml.model.optimizer import model_optimizer
 
@@ -79,6 +80,12 @@ class FPGABackend(Backend):
             n_out = layer.get_attr('n_out')
             return n_in, n_out
 
+        if layer.class_name in ('Conv1DTranspose', 'Conv2DTranspose'):
+            # One multiplication of the input window computes all stride phases
+            n_in = layer.get_attr('n_chan') * layer.get_attr('sub_filt_height', 1) * layer.get_attr('sub_filt_width')
+            n_out = layer.get_attr('n_filt') * layer.get_attr('stride_height', 1) * layer.get_attr('stride_width')
+            return n_in, n_out
+
         if 'Conv1D' in layer.class_name:
             n_in = layer.get_attr('n_chan') * layer.get_attr('filt_width')
             n_out = layer.get_attr('n_filt')
@@ -284,6 +291,8 @@ class FPGABackend(Backend):
         product = 'mult'
         if isinstance(weight_T, ExponentPrecisionType):
             product = 'weight_exponential'
+        elif isinstance(weight_T, CodebookPrecisionType):
+            product = 'weight_codebook'
         else:
             # if binary
             if isinstance(weight_T, XnorPrecisionType) and isinstance(data_T, XnorPrecisionType):
@@ -298,20 +307,23 @@ class FPGABackend(Backend):
                 product = 'mult'
         return product
 
-    def compute_conv1d_instructions(self, in_W, in_C, kernel_size=3, stride=1, pad=0):
+    def compute_conv1d_instructions(self, in_W, in_C, kernel_size=3, stride=1, pad=0, dilation=1):
 
         # Current limitations
         assert pad == 0
 
-        if kernel_size >= stride:
-            min_W = (math.ceil(kernel_size / stride) - 1) * stride + kernel_size
+        # A dilated kernel behaves like a kernel of its span with the taps dilation pixels apart
+        kernel_span = dilation * (kernel_size - 1) + 1
+
+        if kernel_span >= stride:
+            min_W = (math.ceil(kernel_span / stride) - 1) * stride + kernel_span
         else:
-            min_W = (math.ceil(stride / kernel_size) - 1) * stride + kernel_size
+            min_W = (math.ceil(stride / kernel_span) - 1) * stride + kernel_span
 
-        min_oW = int((min_W - kernel_size) // stride + 1)
+        min_oW = int((min_W - kernel_span) // stride + 1)
 
-        out_W = int((in_W - kernel_size) // stride + 1)
-        scaled_W = (out_W - 1) * stride + kernel_size
+        out_W = int((in_W - kernel_span) // stride + 1)
+        scaled_W = (out_W - 1) * stride + kernel_span
 
         if scaled_W < in_W:
             min_W += 1
@@ -320,7 +332,7 @@ class FPGABackend(Backend):
 
         for i_ow in range(min_oW):
             for i_fw in range(kernel_size):
-                index_data = i_ow * stride + i_fw - pad
+                index_data = i_ow * stride + i_fw * dilation - pad
                 windows_bin[index_data][i_fw] = 1
 
         windows_int = []
@@ -330,7 +342,7 @@ class FPGABackend(Backend):
 
         return (min_W, windows_int)
 
-    def compute_conv2d_instructions(self, in_H, in_W, in_C, kernel_size=3, stride=1, pad=0):
+    def compute_conv2d_instructions(self, in_H, in_W, in_C, kernel_size=3, stride=1, pad=0, dilation=1):
 
         if isinstance(kernel_size, Iterable):
             kernel_height = kernel_size[0]
@@ -346,47 +358,59 @@ class FPGABackend(Backend):
             stride_height = stride
             stride_width = stride
 
+        if isinstance(dilation, Iterable):
+            dilation_height = dilation[0]
+            dilation_width = dilation[1]
+        else:
+            dilation_height = dilation
+            dilation_width = dilation
+
         # Current limitations
         assert kernel_height == kernel_width
         assert stride_height == stride_width
         assert pad == 0
 
-        if kernel_height >= stride_height:
-            min_H = (math.ceil(kernel_height / stride_height) - 1) * stride_height + kernel_height
+        # A dilated kernel behaves like a kernel of its span with the taps dilation pixels apart
+        span_height = dilation_height * (kernel_height - 1) + 1
+        span_width = dilation_width * (kernel_width - 1) + 1
+
+        if span_height >= stride_height:
+            min_H = (math.ceil(span_height / stride_height) - 1) * stride_height + span_height
         else:
-            min_H = (math.ceil(stride_height / kernel_height) - 1) * stride_height + kernel_height
-        
-        if kernel_width >= stride_width:
-            min_W = (math.ceil(kernel_width / stride_width) - 1) * stride_width + kernel_width
+            min_H = (math.ceil(stride_height / span_height) - 1) * stride_height + span_height
+
+        if span_width >= stride_width:
+            min_W = (math.ceil(span_width / stride_width) - 1) * stride_width + span_width
         else:
-            min_W = (math.ceil(stride_width / kernel_width) - 1) * stride_width + kernel_width
+            min_W = (math.ceil(stride_width / span_width) - 1) * stride_width + span_width
 
-        min_oH = int((min_H - kernel_height) // stride_height + 1)
-        min_oW = int((min_W - kernel_width) // stride_width + 1)
+        min_oH = int((min_H - span_height) // stride_height + 1)
+        min_oW = int((min_W - span_width) // stride_width + 1)
 
-        out_H = int((in_H - kernel_height) // stride_height + 1)
-        out_W = int((in_W - kernel_width) // stride_width + 1)
-        scaled_H = (out_H - 1) * stride_height + kernel_height
-        scaled_W = (out_W - 1) * stride_width + kernel_width
+        out_H = int((in_H - span_height) // stride_height + 1)
+        out_W = int((in_W - span_width) // stride_width + 1)
+        scaled_H = (out_H - 1) * stride_height + span_height
+        scaled_W = (out_W - 1) * stride_width + span_width
 
         if scaled_H < in_H:
             min_H += 1
         if scaled_W < in_W:
             min_W += 1
 
-        # Let's hardcode a few common cases:
-        if kernel_height == 1 and kernel_width == 1 and stride == 1 and scaled_H == in_H and scaled_W == in_W:
-            return (1, 1, map(str, [1]))
-        if kernel_height == 3 and kernel_width == 3 and stride == 1 and scaled_H == in_H and scaled_W == in_W:
-            return (5, 5, map(str, [1,3,7,6,4,9,27,63,54,36,73,219,511,438,292,72,216,504,432,288,64,192,448,384,256]))
-        if kernel_height == 5 and kernel_width == 5 and stride == 1 and scaled_H == in_H and scaled_W == in_W:
-            return (9, 9, map(str, [1,3,7,15,31,30,28,24,16,33,99,231,495,1023,990,924,792,528,1057,3171,7399,15855,
-                             32767,31710,29596,25368,16912,33825,101475,236775,507375,1048575,1014750,947100,
-                             811800,541200,1082401,3247203,7576807,16236015,33554431,32472030,30307228,25977624,
-                             17318416,1082400,3247200,7576800,16236000,33554400,32472000,30307200,25977600,17318400,
-                             1082368,3247104,7576576,16235520,33553408,32471040,30306304,25976832,17317888,1081344,
-                             3244032,7569408,16220160,33521664,32440320,30277632,25952256,17301504,1048576,3145728,
-                             7340032,15728640,32505856,31457280,29360128,25165824,16777216]))
+        # Let's hardcode a few common cases (without dilation):
+        if dilation_height == 1 and dilation_width == 1:
+            if kernel_height == 1 and kernel_width == 1 and stride == 1 and scaled_H == in_H and scaled_W == in_W:
+                return (1, 1, map(str, [1]))
+            if kernel_height == 3 and kernel_width == 3 and stride == 1 and scaled_H == in_H and scaled_W == in_W:
+                return (5, 5, map(str, [1,3,7,6,4,9,27,63,54,36,73,219,511,438,292,72,216,504,432,288,64,192,448,384,256]))
+            if kernel_height == 5 and kernel_width == 5 and stride == 1 and scaled_H == in_H and scaled_W == in_W:
+                return (9, 9, map(str, [1,3,7,15,31,30,28,24,16,33,99,231,495,1023,990,924,792,528,1057,3171,7399,15855,
+                                 32767,31710,29596,25368,16912,33825,101475,236775,507375,1048575,1014750,947100,
+                                 811800,541200,1082401,3247203,7576807,16236015,33554431,32472030,30307228,25977624,
+                                 17318416,1082400,3247200,7576800,16236000,33554400,32472000,30307200,25977600,17318400,
+                                 1082368,3247104,7576576,16235520,33553408,32471040,30306304,25976832,17317888,1081344,
+                                 3244032,7569408,16220160,33521664,32440320,30277632,25952256,17301504,1048576,3145728,
+                                 7340032,15728640,32505856,31457280,29360128,25165824,16777216]))
 
         windows_bin = [[0 for _ in range(kernel_height * kernel_width)] for _ in range(min_H * min_W)]
 
@@ -394,7 +418,7 @@ class FPGABackend(Backend):
             for i_ow in range(min_oW):
                 for i_fh in range(kernel_height):
                     for i_fw in range(kernel_width):
-                        index_data = (i_oh * stride_height + i_fh - pad) * min_W + (i_ow * stride_width + i_fw - pad)
+                        index_data = (i_oh * stride_height + i_fh * dilation_height - pad) * min_W + (i_ow * stride_width + i_fw * dilation_width - pad)
                         windows_bin[index_data][i_fh * kernel_width + i_fw] = 1
 
         windows_int = []
@@ -622,6 +646,131 @@ class FPGABackend(Backend):
 
         return generated_code
 
+    def _compute_csd(self, value):
+        """Canonical signed digit (non-adjacent form) of an integer, as a list of (sign, shift) pairs."""
+        digits = []
+        shift = 0
+        while value != 0:
+            if value % 2 != 0:
+                digit = 2 - (value % 4)
+                value -= digit
+                digits.append((digit, shift))
+            value //= 2
+            shift += 1
+        return digits
+
+    def _quantize_fixed(self, values, precision):
+        """Integer mantissas (value * 2^fractional) of values converted to a fixed-point type, with the rounding and
+        overflow mode of the type, as the conversion of the written weights in the C++ code."""
+        frac_bits = precision.width - precision.integer if isinstance(precision, FixedPrecisionType) else 0
+        rounding = getattr(precision, 'rounding_mode', None)
+        saturation = getattr(precision, 'saturation_mode', None)
+        x = np.asarray(values, dtype=np.float64) * 2.0 ** frac_bits
+
+        if not isinstance(precision, FixedPrecisionType):
+            q = np.trunc(x)
+        elif rounding is None or rounding == RoundingMode.TRN:
+            q = np.floor(x)
+        elif rounding == RoundingMode.TRN_ZERO:
+            q = np.trunc(x)
+        elif rounding == RoundingMode.RND:
+            q = np.floor(x + 0.5)
+        elif rounding == RoundingMode.RND_ZERO:
+            q = np.sign(x) * np.ceil(np.abs(x) - 0.5)
+        elif rounding == RoundingMode.RND_INF:
+            q = np.sign(x) * np.floor(np.abs(x) + 0.5)
+        elif rounding == RoundingMode.RND_MIN_INF:
+            q = np.ceil(x - 0.5)
+        else:
+            q = np.round(x) # RND_CONV, ties to even
+        q = q.astype(np.int64)
+
+        if precision.signed:
+            q_min, q_max = -2 ** (precision.width - 1), 2 ** (precision.width - 1) - 1
+        else:
+            q_min, q_max = 0, 2 ** precision.width - 1
+        if saturation is None or saturation == SaturationMode.WRAP:
+            q = (q - q_min) % 2 ** precision.width + q_min
+        elif saturation == SaturationMode.SAT:
+            q = np.clip(q, q_min, q_max)
+        elif saturation == SaturationMode.SAT_ZERO:
+            q = np.where((q < q_min) | (q > q_max), 0, q)
+        else: # SAT_SYM
+            q = np.clip(q, -q_max if precision.signed else q_min, q_max)
+
+        return q, frac_bits
+
+    def generate_dense_shift_add_fn(self, layer_idx, weights, precision):
+        """Generate a C++ class computing a matrix-vector product with constant weights using shift-adds.
+
+        Each weight is decomposed into its canonical signed digits, so a product becomes a sum of
+        (mostly 1-3) shifted copies of the input instead of a multiplication. Zero weights are removed
+        entirely. The generated class is used instead of the loop-based product of `dense_latency`.
+
+        Args:
+            layer_idx (int): Index of layer ('index' attribute).
+            weights (ndarray): Weights as a (n_in, n_out) matrix, in the layout used by `dense_latency`. These are
+                the values as written to the weight files, they are converted to the weight type like the C++ code does.
+            precision (PrecisionType): Precision of the weight type.
+
+        Returns:
+            str: Generated C++ class
+        """
+        n_in, n_out = weights.shape
+        int_weights, frac_bits = self._quantize_fixed(weights, precision)
+
+        generated_code = (
+            "template<class data_T, class res_T, typename CONFIG_T>\n"
+            "class dense_shift_add_{index} : public DenseShiftAdd<data_T, res_T, CONFIG_T> {{\n"
+            "    public:\n"
+            "    static void dense(\n"
+            "        data_T data[CONFIG_T::n_in],\n"
+            "        res_T res[CONFIG_T::n_out],\n"
+            "        typename CONFIG_T::bias_t biases[CONFIG_T::n_out]\n"
+            "    ) {{\n"
+            "        #pragma HLS INLINE\n"
+            "        typedef decltype(data_T(0) * typename CONFIG_T::weight_t(0)) prod_t;\n"
+            "        typename CONFIG_T::accum_t acc[CONFIG_T::n_out];\n"
+            "        #pragma HLS ARRAY_PARTITION variable=acc complete\n"
+            "        prod_t x[CONFIG_T::n_in];\n"
+            "        #pragma HLS ARRAY_PARTITION variable=x complete\n"
+            "        for (unsigned i = 0; i < CONFIG_T::n_in; i++) {{\n"
+            "            #pragma HLS UNROLL\n"
+            "            x[i] = data[i];\n"
+            "        }}\n"
+        ).format(index=layer_idx)
+        indent = '    '
+
+        for j in range(n_out):
+            generated_code += indent * 2 + 'acc[{}] = biases[{}];\n'.format(j, j)
+            for i in range(n_in):
+                terms = ''
+                for k, (sign, shift) in enumerate(reversed(self._compute_csd(int(int_weights[i, j])))):
+                    exp = shift - frac_bits
+                    if exp > 0:
+                        term = '(x[{}] << {})'.format(i, exp)
+                    elif exp < 0:
+                        term = '(x[{}] >> {})'.format(i, -exp)
+                    else:
+                        term = 'x[{}]'.format(i)
+                    if k == 0:
+                        terms += term if sign > 0 else '-' + term
+                    else:
+                        terms += (' + ' if sign > 0 else ' - ') + term
+                if terms:
+                    generated_code += indent * 2 + 'acc[{}] += (typename CONFIG_T::accum_t) ({});\n'.format(j, terms)
+
+        generated_code += (
+            "        for (unsigned j = 0; j < CONFIG_T::n_out; j++) {\n"
+            "            #pragma HLS UNROLL\n"
+            "            res[j] = cast<data_T, res_T, CONFIG_T>(acc[j], j);\n"
+            "        }\n"
+        )
+        generated_code += indent + '}\n'
+        generated_code += '};\n'
+
+        return generated_code
+
     @model_optimizer()
     def write_hls(self, model):
         self.writer.write_hls(model)
@@ -1,6 +1,6 @@
 import numpy as np
 
-from hls4ml.model.types import CompressedType, NamedType, ExponentType, FixedPrecisionType, IntegerPrecisionType, XnorPrecisionType, ExponentPrecisionType, TensorVariable, PackedType, WeightVariable
+from hls4ml.model.types import CompressedType, NamedType, ExponentType, CodebookType, FixedPrecisionType, IntegerPrecisionType, XnorPrecisionType, ExponentPrecisionType, CodebookPrecisionType, TensorVariable, PackedType, WeightVariable
 
 #region Precision types
 
@@ -80,6 +80,7 @@ class APTypeConverter(FixedPrecisionConverter):
                 FixedPrecisionType: APFixedPrecisionDefinition,
                 IntegerPrecisionType: APIntegerPrecisionDefinition,
                 ExponentPrecisionType: APIntegerPrecisionDefinition,
+                CodebookPrecisionType: APIntegerPrecisionDefinition,
                 XnorPrecisionType: APIntegerPrecisionDefinition,
             },
             prefix='AP'
@@ -92,6 +93,7 @@ class ACTypeConverter(FixedPrecisionConverter):
                 FixedPrecisionType: ACFixedPrecisionDefinition,
                 IntegerPrecisionType: ACIntegerPrecisionDefinition,
                 ExponentPrecisionType: ACIntegerPrecisionDefinition,
+                CodebookPrecisionType: ACIntegerPrecisionDefinition,
                 XnorPrecisionType: ACIntegerPrecisionDefinition,
             },
             prefix='AC'
@@ -140,6 +142,22 @@ class ExponentTypeConverter(TypeDefinition, TypePrecisionConverter):
         super().convert_precision(precision_converter)
         self.sign = precision_converter.convert(self.sign)
 
+class CodebookTypeConverter(TypeDefinition, TypePrecisionConverter):
+    def definition_cpp(self):
+        cpp_fmt = (
+            'typedef struct {name} {{'
+            'typedef {value} value_t;'
+            'static const unsigned n_entries = {n_entries};'
+            'static value_t value(unsigned i) {{ static const value_t codebook[{n_entries}] = {{{codebook}}}; return codebook[i]; }}'
+            '{precision} index; }} {name};\n'
+        )
+        codebook = ', '.join([self.value_fmt % v for v in self.codebook])
+        return cpp_fmt.format(name=self.name, value=self.value_precision.definition_cpp(), n_entries=len(self.codebook), codebook=codebook, precision=self.precision.definition_cpp())
+
+    def convert_precision(self, precision_converter):
+        super().convert_precision(precision_converter)
+        self.value_precision = precision_converter.convert(self.value_precision)
+
 class PackedTypeConverter(TypeDefinition, TypePrecisionConverter):
     def definition_cpp(self):
         n_elem_expr = '/' if self.unpack else '*'
@@ -152,6 +170,7 @@ class HLSTypeConverter(object):
             NamedType: NamedTypeConverter,
             CompressedType: CompressedTypeConverter,
             ExponentType: ExponentTypeConverter,
+            CodebookType: CodebookTypeConverter,
             PackedType: PackedTypeConverter,
         }
 
@@ -277,6 +296,9 @@ class StreamVariableConverter(object):
 
         if depth == 0:
             depth = np.prod(tensor_var.shape) // tensor_var.shape[-1]
+            if n_pack < 0:
+                # Unpacked streams carry the last dimension over several words
+                depth *= -n_pack
         tensor_var.pragma = ('stream', depth)
         tensor_var.type = self.type_converter.convert(PackedType(tensor_var.type.name, tensor_var.type.precision, tensor_var.shape[-1], n_pack))
 
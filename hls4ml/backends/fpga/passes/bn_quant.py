@@ -1,8 +1,8 @@
 import numpy as np
 
 from hls4ml.model.optimizer import OptimizerPass
-from hls4ml.model.types import IntegerPrecisionType, NamedType, XnorPrecisionType
-from hls4ml.model.layers import BatchNormalization, register_layer
+from hls4ml.model.types import IntegerPrecisionType, FixedPrecisionType, NamedType, XnorPrecisionType, ExponentPrecisionType
+from hls4ml.model.layers import BatchNormalization, Dense, Conv1D, Conv2D, DepthwiseConv2D, register_layer
 from hls4ml.backends.template import FunctionCallTemplate, LayerConfigTemplate
 from hls4ml.backends.fpga.fpga_layers import BatchNormalizationQuantizedTanh
 
@@ -51,6 +51,7 @@ def register_bn_quant(backend):
     # Register the optimization passes
     backend.register_pass('merge_batch_norm_quantized_tanh', MergeBatchNormAndQuantizedTanh)
     backend.register_pass('quantize_dense_output', QuantizeDenseOutput)
+    backend.register_pass('fuse_requantization', FuseRequantization)
 
     # Register template passes
     backend.register_template(BatchNormalizationQuantizedTanhConfigTemplate)
@@ -155,3 +156,94 @@ class QuantizeDenseOutput(OptimizerPass):
 
         return False
 
+class FuseRequantization(OptimizerPass):
+    ''' Integer-only mode ('IntegerOnly' set in the layer config of a Dense/Conv layer).
+    The per-channel scale and bias of the following BatchNormalization (e.g. the ApplyAlpha layer
+    extracted from a QKeras quantizer) are folded into a requantization epilogue of the layer:
+    a fixed-point multiplier and a bias per output channel, applied to the accumulator before
+    the cast to the output type. The accumulator is narrowed to the exact width of the integer
+    products, so no wide intermediate result is kept.
+    '''
+
+    requant_bits = 18
+
+    def match(self, node):
+        if not (node.class_name in ['BatchNormalization', 'Alpha'] and isinstance(node, BatchNormalization)):
+            return False
+
+        layer = node.get_input_node()
+        if not isinstance(layer, (Dense, Conv1D, Conv2D)) or isinstance(layer, DepthwiseConv2D):
+            return False
+        if not layer.model.config.get_layer_config_value(layer, 'IntegerOnly', False) or layer.get_attr('requant', False):
+            return False
+        if len(layer.get_output_nodes()) != 1:
+            return False
+        if self._n_channels(layer) is None:
+            return False
+
+        # Only plain integer/fixed-point weights and inputs can be requantized this way
+        precisions = [layer.get_input_variable().type.precision, layer.get_weights('weight').type.precision]
+        for precision in precisions:
+            if isinstance(precision, (XnorPrecisionType, ExponentPrecisionType)) or not hasattr(precision, 'integer'):
+                return False
+
+        return True
+
+    def _n_channels(self, layer):
+        if isinstance(layer, Dense):
+            n_chan = layer.get_attr('n_out')
+        else:
+            n_chan = layer.get_attr('n_filt')
+        bn = layer.get_output_nodes()[0]
+        n_scale = bn.get_weights('scale').data.size
+        if n_scale != 1 and n_scale != n_chan:
+            return None
+        return n_chan
+
+    def transform(self, model, node):
+        layer = node.get_input_node()
+        n_chan = self._n_channels(layer)
+
+        scale = np.broadcast_to(node.get_weights('scale').data.flatten(), (n_chan,))
+        bias = np.broadcast_to(node.get_weights('bias').data.flatten(), (n_chan,))
+
+        # The binary point of the multiplier encodes the shift, chosen so the largest scale fits
+        signed = bool(np.any(scale < 0))
+        max_scale = np.max(np.abs(scale))
+        integer = int(np.floor(np.log2(max_scale))) + 1 if max_scale > 0 else 1
+        if signed:
+            integer += 1
+        scale_precision = FixedPrecisionType(width=self.requant_bits, integer=integer, signed=signed)
+        scale_step = 2.0 ** (self.requant_bits - integer)
+        scale = np.round(scale * scale_step) / scale_step
+
+        layer.set_attr('requant', True)
+        layer.set_attr('requant_scale', scale)
+        layer.set_attr('requant_bias', bias)
+        layer.set_attr('requant_scale_t', NamedType('requant_scale{}_t'.format(layer.index), scale_precision))
+        layer.set_attr('requant_bias_t', NamedType('requant_bias{}_t'.format(layer.index), node.get_weights('bias').type.precision))
+
+        # Exact accumulator for the sum of integer products (and the bias, if any)
+        if isinstance(layer, Dense):
+            n_terms = layer.get_attr('n_in')
+        else:
+            n_terms = layer.get_attr('n_chan') * layer.get_attr('filt_width') * layer.get_attr('filt_height', 1)
+        in_precision = layer.get_input_variable().type.precision
+        w_precision = layer.get_weights('weight').type.precision
+        integer = in_precision.integer + (not in_precision.signed) + w_precision.integer + (not w_precision.signed)
+        fractional = (in_precision.width - in_precision.integer) + (w_precision.width - w_precision.integer)
+        layer_bias = layer.get_weights('bias')
+        if np.any(layer_bias.data != 0):
+            b_precision = layer_bias.type.precision
+            integer = max(integer, b_precision.integer + (not b_precision.signed))
+            fractional = max(fractional, b_precision.width - b_precision.integer)
+        integer += int(np.ceil(np.log2(n_terms + 1)))
+        accum_precision = FixedPrecisionType(width=integer + fractional, integer=integer, signed=True)
+        layer.set_attr('accum_t', NamedType('layer{}_accum_t'.format(layer.index), accum_precision))
+
+        # The layer now produces the output of the normalization directly
+        layer.get_output_variable().type.precision = node.get_output_variable().type.precision
+        model.remove_node(node, rewire=True)
+
+        return True
+
@@ -1,6 +1,8 @@
+import numpy as np
+
 from hls4ml.model.optimizer import OptimizerPass
-from hls4ml.model.layers import Conv1D, Conv2D
-from hls4ml.model.types import Source
+from hls4ml.model.layers import Dense, Conv1D, Conv2D, DepthwiseConv2D
+from hls4ml.model.types import Source, IntegerPrecisionType, FixedPrecisionType, ExponentPrecisionType
 
 class GenerateConvIm2col(OptimizerPass):
     ''' Generates tcode for im2col step of 1D/2d convolution '''
@@ -25,7 +27,8 @@ class GenerateConvIm2col(OptimizerPass):
             node.get_input_variable().shape[1],
             kernel=node.get_attr('filt_width'),
             stride=node.get_attr('stride_width'),
-            pad=(node.get_attr('pad_left'), node.get_attr('pad_right'))
+            pad=(node.get_attr('pad_left'), node.get_attr('pad_right')),
+            dilation=node.get_attr('dilation', 1)
         )
 
         node.set_attr('line_buffer_codegen', Source(code_str))
@@ -39,7 +42,51 @@ class GenerateConvIm2col(OptimizerPass):
             node.get_input_variable().shape[2],
             kernel=(node.get_attr('filt_height'), node.get_attr('filt_width')),
             stride=(node.get_attr('stride_height'), node.get_attr('stride_width')),
-            pad=(node.get_attr('pad_top'), node.get_attr('pad_bottom'), node.get_attr('pad_left'), node.get_attr('pad_right'))
+            pad=(node.get_attr('pad_top'), node.get_attr('pad_bottom'), node.get_attr('pad_left'), node.get_attr('pad_right')),
+            dilation=(node.get_attr('dilation_height', 1), node.get_attr('dilation_width', 1))
         )
         
         node.set_attr('line_buffer_codegen', Source(code_str))
+
+class GenerateDenseShiftAdd(OptimizerPass):
+    ''' Generates shift-add code for the products with constant weights of the latency strategy.
+
+    Used for Dense layers and the kernels of streaming convolutions (which call `dense_latency`).
+    Enabled with 'ShiftAdd' in the layer config (off by default, as the generated code grows with n_in * n_out).
+    '''
+
+    def match(self, node):
+        if not isinstance(node, (Dense, Conv1D, Conv2D)) or isinstance(node, DepthwiseConv2D):
+            return False
+        if node.get_attr('shift_add', False):
+            return False
+        if isinstance(node, (Conv1D, Conv2D)) and node.model.config.get_config_value('IOType') != 'io_stream':
+            return False
+        if node.get_attr('strategy', 'latency').lower() != 'latency':
+            return False
+
+        w_precision = node.get_weights('weight').type.precision
+        if isinstance(w_precision, ExponentPrecisionType) or not isinstance(w_precision, (IntegerPrecisionType, FixedPrecisionType)):
+            return False
+        product_type = node.model.config.backend.product_type(node.get_input_variable().type.precision, w_precision)
+        if product_type not in ['mult', 'lut_mult']:
+            return False
+
+        return node.model.config.get_layer_config_value(node, 'ShiftAdd', False)
+
+    def transform(self, model, node):
+        weights = node.get_weights('weight')
+        if isinstance(node, Dense):
+            n_out = node.get_attr('n_out')
+        else:
+            n_out = node.get_attr('n_filt')
+        # The weights as written to the weight files
+        w_written = np.array([float(w) for w in weights]).reshape((-1, n_out))
+
+        code_str = node.model.config.backend.generate_dense_shift_add_fn(node.get_attr('index'), w_written, weights.type.precision)
+
+        node.set_attr('shift_add', True)
+        node.set_attr('shift_add_codegen', Source(code_str))
+
+        return False
+
@@ -35,6 +35,7 @@ conv1d_config_template = """struct config{index} : nnet::conv1d_config {{
 
     static const unsigned filt_width = {filt_width};
     static const unsigned impl_filt_width = {impl_filt_width};
+    static const unsigned winograd_tile = {winograd_tile};
     static const unsigned kernel_size = filt_width;
     
     static const unsigned n_filt = {n_filt};
@@ -52,6 +53,8 @@ conv1d_config_template = """struct config{index} : nnet::conv1d_config {{
     static const nnet::conv1d_implementation implementation = nnet::conv1d_implementation::{implementation};
 
     typedef {accum_t.name} accum_t;
+    typedef {winograd_t.name} winograd_t;
+    typedef {winograd_accum_t.name} winograd_accum_t;
     typedef {bias_t.name} bias_t;
     typedef {weight_t.name} weight_t;
     typedef {config_t} mult_config;
@@ -59,7 +62,7 @@ conv1d_config_template = """struct config{index} : nnet::conv1d_config {{
 """
 
 conv1d_function_template = 'nnet::conv_1d_{data_format}<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
-conv1d_include_list = ['nnet_utils/nnet_conv1d.h']
+conv1d_include_list = ['nnet_utils/nnet_conv1d.h', 'nnet_utils/nnet_conv1d_stream.h']
 
 class Conv1DConfigTemplate(LayerConfigTemplate):
     def __init__(self):
@@ -73,6 +76,9 @@ class Conv1DConfigTemplate(LayerConfigTemplate):
         if conv_params['dilation'] != 1:
             raise Exception('dilation != 1 not supported yet')         
         conv_params['config_t'] = 'config{}_mult'.format(node.index)
+        # Winograd tiles are transformed in accum_t, unless wider types are set by the Winograd optimizer
+        conv_params.setdefault('winograd_t', node.get_attr('accum_t'))
+        conv_params.setdefault('winograd_accum_t', node.get_attr('accum_t'))
         conv_config = self.template.format(**conv_params)
 
         mult_params = self._default_config_params(node)
@@ -112,6 +118,7 @@ conv2d_config_template = """struct config{index} : nnet::conv2d_config {{
     static const unsigned filt_width = {filt_width};
     static const unsigned impl_filt_height = {impl_filt_height};
     static const unsigned impl_filt_width = {impl_filt_width};
+    static const unsigned winograd_tile = {winograd_tile};
     static const unsigned kernel_size = filt_height * filt_width;
     
     static const unsigned pad_top = {pad_top};
@@ -120,6 +127,8 @@ conv2d_config_template = """struct config{index} : nnet::conv2d_config {{
     static const unsigned pad_right = {pad_right};
     static const unsigned stride_height = {stride_height};
     static const unsigned stride_width = {stride_width};
+    static const unsigned dilation_height = {dilation_height};
+    static const unsigned dilation_width = {dilation_width};
     
     static const unsigned reuse_factor = {reuse};
     static const unsigned parallelisation_factor = {parallelization};
@@ -128,13 +137,15 @@ conv2d_config_template = """struct config{index} : nnet::conv2d_config {{
     static const nnet::conv2d_implementation implementation = nnet::conv2d_implementation::{implementation};
 
     typedef {accum_t.name} accum_t;
+    typedef {winograd_t.name} winograd_t;
+    typedef {winograd_accum_t.name} winograd_accum_t;
     typedef {bias_t.name} bias_t;
     typedef {weight_t.name} weight_t;
     typedef {config_t} mult_config;
 }};\n"""
 
 conv2d_function_template = 'nnet::conv_2d_{data_format}<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
-conv2d_include_list = ['nnet_utils/nnet_conv2d.h']
+conv2d_include_list = ['nnet_utils/nnet_conv2d.h', 'nnet_utils/nnet_conv2d_stream.h']
 
 class Conv2DConfigTemplate(LayerConfigTemplate):
     def __init__(self):
@@ -144,10 +155,15 @@ class Conv2DConfigTemplate(LayerConfigTemplate):
 
     def format(self, node):
         conv_params = self._default_config_params(node)
-        conv_params['dilation'] = node.get_attr('dilation', 1)
-        if conv_params['dilation'] != 1:
-            raise Exception('dilation != 1 not supported yet') 
+        conv_params['dilation_height'] = node.get_attr('dilation_height', 1)
+        conv_params['dilation_width'] = node.get_attr('dilation_width', 1)
+        # Only the im2col kernel of io_parallel indexes the input with the dilation rates
+        if (conv_params['dilation_height'], conv_params['dilation_width']) != (1, 1) and node.model.config.get_config_value('IOType') != 'io_parallel':
+            raise Exception('dilation != 1 not supported yet for {}'.format(node.model.config.get_config_value('IOType')))
         conv_params['config_t'] = 'config{}_mult'.format(node.index)
+        # Winograd tiles are transformed in accum_t, unless wider types are set by the Winograd optimizer
+        conv_params.setdefault('winograd_t', node.get_attr('accum_t'))
+        conv_params.setdefault('winograd_accum_t', node.get_attr('accum_t'))
         conv_config = self.template.format(**conv_params)
 
         mult_params = self._default_config_params(node)
@@ -1,13 +1,115 @@
 import math
 import numpy as np
+from fractions import Fraction
 from hls4ml.model.optimizer import OptimizerPass
 from hls4ml.model.layers import Conv1D, Conv2D
+from hls4ml.model.types import NamedType, FixedPrecisionType
+from hls4ml.backends.fpga.fpga_types import ACTypeConverter, HLSTypeConverter
+
+# Output tile sizes (m) supported for each kernel size (r), i.e. the minimal filtering algorithms F(m, r)
+# The matching input-transform (B') and output-transform (A') matrices are hard-coded in nnet_winograd.h
+winograd_tiles = {
+    3: [2, 4, 6],
+    5: [2, 4],
+}
+
+# Interpolation points of the Toom-Cook construction, in order of use; the point at infinity is always added last
+# Small points keep the coefficients of the transformation matrices (and the required precision) low
+winograd_points = [Fraction(0), Fraction(1), Fraction(-1), Fraction(2), Fraction(-2), Fraction(1, 2), Fraction(-1, 2)]
+
+def _poly_coefficients(roots):
+    # Coefficients (ascending powers) of the polynomial prod(x - root)
+    coeffs = [Fraction(1)]
+    for root in roots:
+        shifted = [Fraction(0)] + coeffs
+        scaled = [-root * c for c in coeffs] + [Fraction(0)]
+        coeffs = [s + t for s, t in zip(shifted, scaled)]
+    return coeffs
+
+def _lcm_of_denominators(values):
+    lcm = 1
+    for v in values:
+        lcm = lcm * v.denominator // math.gcd(lcm, v.denominator)
+    return lcm
+
+def winograd_matrices(m, r):
+    '''
+    Transformation matrices of the minimal filtering algorithm F(m, r), from the Toom-Cook construction, such that
+        y = A' [(G g) * (B' d)]
+    computes m outputs of the (valid) correlation of an input tile d of size m + r - 1 with a kernel g of size r.
+    B' and A' are scaled to integers, so their products reduce to shifts and additions in hardware;
+    the compensating factors are folded into G, which is applied offline to the weights.
+    Returns (A', G, B') as lists of lists of Fractions, of shapes (m, n), (n, r) and (n, n), with n = m + r - 1.
+    '''
+    n = m + r - 1
+    if n - 1 > len(winograd_points):
+        raise Exception('Winograd F({}, {}) requires more interpolation points than available'.format(m, r))
+    points = winograd_points[:n - 1]
+
+    # Rows of B' are the polynomials vanishing on all but one point; the last row vanishes on all points
+    BT = [_poly_coefficients(points[:j] + points[j + 1:]) + [Fraction(0)] for j in range(n - 1)]
+    BT.append(_poly_coefficients(points))
+
+    # A' evaluates the Hadamard product at the points (Vandermonde); the last column handles the point at infinity
+    AT = [[p ** i for p in points] + [Fraction(1 if i == m - 1 else 0)] for i in range(m)]
+
+    # G evaluates the kernel at the points, normalised by the Lagrange denominators
+    G = []
+    for j, p in enumerate(points):
+        denominator = Fraction(1)
+        for k, q in enumerate(points):
+            if k != j:
+                denominator *= p - q
+        G.append([p ** k / denominator for k in range(r)])
+    G.append([Fraction(1 if k == r - 1 else 0) for k in range(r)])
+
+    # Scale the rows of B' and the columns of A' to integers; compensate in the corresponding rows of G
+    for j in range(n):
+        b_scale = _lcm_of_denominators(BT[j])
+        a_scale = _lcm_of_denominators([AT[i][j] for i in range(m)])
+        BT[j] = [b * b_scale for b in BT[j]]
+        for i in range(m):
+            AT[i][j] *= a_scale
+        G[j] = [g / (a_scale * b_scale) for g in G[j]]
+
+    return AT, G, BT
 
 class ApplyWinogradKernelTransformation(OptimizerPass):
     ''' 
-    Transforms the weights of a Conv2D kernel to a format suitable for Wingorad convolution
+    Transforms the weights of a Conv1D/Conv2D kernel to a format suitable for Winograd convolution
     For further information, refer to Lavin & Gray, 2015 - Fast Algorithms for Convolutional Neural Networks
+    
+    The output tile size m of F(m, r) is chosen per layer: larger tiles need fewer multiplications per output,
+    (m + r - 1) / m per dimension, but more additions in the transformations and wider intermediate types.
+    Larger tiles are therefore only used once the reuse factor indicates the design is multiplier-bound,
+    and among those, the tile wasting the fewest multiplications on the edges of the output is chosen.
+    The tile can also be set explicitly, with the 'WinogradTile' option of the layer.
     '''
+    def _winograd_tile(self, node, filt_size, out_sizes):
+        # Tiles need to fit at least twice in the output, otherwise the HLS Compiler fails to pipeline the loop
+        candidates = [m for m in winograd_tiles.get(filt_size, []) if all(out > m for out in out_sizes)]
+        if len(candidates) == 0:
+            return None
+
+        tile = node.model.config.get_layer_config_value(node, 'WinogradTile', None)
+        if tile is not None:
+            # A tile that doesn't fit the layer falls back to im2col
+            return tile if tile in candidates else None
+
+        # Latency-oriented designs (reuse_factor = 1) keep the shallowest transformations
+        reuse_factor = node.get_attr('reuse_factor', 1)
+        max_tile = 2 if reuse_factor == 1 else 4 if reuse_factor < 4 else 6
+        candidates = [m for m in candidates if m <= max_tile] or candidates[:1]
+
+        def mults_per_output(m):
+            n = m + filt_size - 1
+            mults = 1
+            for out in out_sizes:
+                mults *= int(math.ceil(out / m)) * n / out
+            return mults
+
+        return min(candidates, key=mults_per_output)
+
     def match(self, node):
         node_matches = isinstance(node, (Conv1D, Conv2D))
 
@@ -19,36 +121,35 @@ class ApplyWinogradKernelTransformation(OptimizerPass):
 
         # Winograd algorithm-specific conditions
         if isinstance(node, Conv1D):
-            # Winograd only applies to specific kernel sizes
-            # Current implementation only supports fs = 3; easily extendable to other filter sizes
-            filter_size_matches = node.get_attr('filt_width', 3) == 3
-            
             # Winograd's minimal filtering algorithm doesn't work with stride != 1
             stride_is_one = node.get_attr('stride_width', 1) == 1
             
-            # HLS Compiler fails to pipeline the entire component if Winograd loop only executes once
-            loop_itr_gt_one = node.get_attr('out_width') > 2 
+            # Winograd only applies to specific kernel sizes, with a tile fitting the output
+            tile_exists = self._winograd_tile(node, node.get_attr('filt_width'), [node.get_attr('out_width')]) is not None
             
-            winograd_conditions = filter_size_matches and stride_is_one and loop_itr_gt_one
+            winograd_conditions = stride_is_one and tile_exists
         
         elif isinstance(node, (Conv2D)):
-            # Winograd only applies to specific kernel sizes
-            # Current implementation only supports fs = 3; easily extendable to other filter sizes
-            filter_size_matches = node.get_attr('filt_height', 3) == 3 and node.get_attr('filt_width', 3) == 3
-            
+            # Only square kernels are supported, using the same tile for both dimensions
+            filter_is_square = node.get_attr('filt_height') == node.get_attr('filt_width')
+
             # Winograd's minimal filtering algorithm doesn't work with striede != 1
             stride_is_one = node.get_attr('stride_height', 1) == 1 and node.get_attr('stride_width', 1) == 1
+
+            # The Winograd tiles are contiguous, so dilated kernels fall back to im2col
+            dilation_is_one = node.get_attr('dilation_height', 1) == 1 and node.get_attr('dilation_width', 1) == 1
             
-            # HLS Compiler fails to pipeline the entire component if Winograd loop only executes once
-            loop_itr_gt_one = node.get_attr('out_height') > 2 and node.get_attr('out_width') > 2 
-            
-            padding_is_equal = node.get_attr('pad_top', 0) == node.get_attr('pad_bottom', 0) and node.get_attr('pad_left', 0) == node.get_attr('pad_right', 0)    
+            # Winograd only applies to specific kernel sizes, with a tile fitting the output
+            tile_exists = filter_is_square and self._winograd_tile(node, node.get_attr('filt_width'), [node.get_attr('out_height'), node.get_attr('out_width')]) is not None
 
-            winograd_conditions = filter_size_matches and stride_is_one and padding_is_equal and loop_itr_gt_one
+            winograd_conditions = stride_is_one and dilation_is_one and tile_exists
         
         else:
             winograd_conditions = False
 
+        # Winograd is only implemented for io_parallel; io_stream uses line buffers and the im2col weight layout
+        winograd_conditions = winograd_conditions and node.model.config.get_config_value('IOType') == 'io_parallel'
+
         # Check any previous transformations
         already_transformed = node.get_attr('_winograd_transformation_applied', False) == True
 
@@ -59,93 +160,95 @@ class ApplyWinogradKernelTransformation(OptimizerPass):
 
     def transform(self, model, node):
         if isinstance(node, Conv1D):
-            if node.get_attr('filt_width', 3) == 3:
-                
-                # First, transpose to a format suitable for the Winograd algorithm (F, C, W)
-                # Note, this assumes a format post-resource strategy optimizer, that is (F, W, C)
-                # Therefore, (F, W, C) => (F, C, W)
-                node.weights['weight'].data = np.transpose(node.weights['weight'].data, axes=[0, 2, 1])     
-
-                # Temporary copy of data
-                weights = node.weights['weight'].data
-                
-                # Expand weight dimensionality (3) => (4)
-                node.weights['weight'].data = np.zeros((weights.shape[0], weights.shape[1], 4))
-
-                # Transformation matrices for 3x1 kernels
-                G = np.array([[1, 0, 0], [0.5, 0.5, 0.5], [0.5, -0.5, 0.5], [0, 0, 1]])
-
-                # Transformation GfG'
-                for filter in range(0, weights.data.shape[0]):
-                    for channel in range(0, weights.data.shape[1]):
-                        node.weights['weight'].data[filter][channel] = np.matmul(G, weights[filter][channel])
-                        node.weights['weight'].data_length = node.weights['weight'].data.size
-        
-                # Winograd's minimal filtering algorithm transforms the weight matrix
-                # This transformation consists of addition and division (by 2&4) of the weight matrix
-                # Therefore, increase precision (if needed), to accomodate for new weights
-                # This error is only noticeable for low precisions, such as those used with QKeras
-                
-                # Integer precision is only updated if it exceeds the one defined in hls4ml config
-                maximum_value_rounded = int(math.ceil(np.abs(node.weights['weight'].data).max()))
-                if maximum_value_rounded.bit_length() + 1 > node.weights['weight'].type.precision.integer:
-                    node.weights['weight'].type.precision.integer = maximum_value_rounded.bit_length() + 1
-                    node.weights['weight'].type.precision.width += (maximum_value_rounded.bit_length() + 1 - node.weights['weight'].type.precision.integer)
-                
-                # Fractional precision is increased by 2 bits (division by 4), for low-precision (less than 8) fractional weights
-                if node.weights['weight'].type.precision.fractional < 8: 
-                    node.weights['weight'].type.precision.fractional += 2
-                    node.weights['weight'].type.precision.width += 2
-
-                # Modified kernel size
-                node.set_attr('impl_filt_width', 4)
+            r = node.get_attr('filt_width')
+            m = self._winograd_tile(node, r, [node.get_attr('out_width')])
+            n_dims = 1
+
+            # First, transpose to a format suitable for the Winograd algorithm (F, C, W)
+            # Note, this assumes a format post-resource strategy optimizer, that is (F, W, C)
+            # Therefore, (F, W, C) => (F, C, W)
+            weights = np.transpose(node.weights['weight'].data, axes=[0, 2, 1])
+            
+            # Transformation Gg, expanding the kernel (r) => (m + r - 1)
+            _, G, _ = winograd_matrices(m, r)
+            G = np.array(G, dtype=np.float64)
+            node.weights['weight'].data = np.einsum('ij,fcj->fci', G, weights)
+
+            # Modified kernel size
+            node.set_attr('impl_filt_width', m + r - 1)
         
         elif isinstance(node, Conv2D):            
-            if node.get_attr('filt_height', 3) == 3 and node.get_attr('filt_width', 3) == 3:
-                
-                # First, transpose to a format suitable for the Winograd algorithm (F, C, H, W)
-                # Note, this assumes a format post-resource strategy optimizer, that is (F, H, W, C)
-                # Therefore, (F, H, W, C) => (F, C, H, W)
-                node.weights['weight'].data = np.transpose(node.weights['weight'].data, axes=[0, 3, 1, 2])     
-
-                # Temporary copy of data
-                weights = node.weights['weight'].data
-                
-                # Expand weight dimensionality (3x3) => (4x4)
-                node.weights['weight'].data = np.zeros((weights.shape[0], weights.shape[1], 4, 4))
-
-                # Transformation matrices for 3x3 kernels
-                G = np.array([[1, 0, 0], [0.5, 0.5, 0.5], [0.5, -0.5, 0.5], [0, 0, 1]])
-                GT = np.array([[1, 0.5, 0.5, 0], [0, 0.5, -0.5, 0], [0, 0.5, 0.5, 1]])
-
-                # Transformation GfG'
-                for filter in range(0, weights.data.shape[0]):
-                    for channel in range(0, weights.data.shape[1]):
-                        node.weights['weight'].data[filter][channel] = np.matmul(np.matmul(G, weights[filter][channel]), GT)
-                        node.weights['weight'].data_length = node.weights['weight'].data.size
-        
-                # Winograd's minimal filtering algorithm transforms the weight matrix
-                # This transformation consists of addition and division (by 2&4) of the weight matrix
-                # Therefore, increase precision (if needed), to accomodate for new weights
-                # This error is only noticeable for low precisions, such as those used with QKeras
-                
-                # Integer precision is only updated if it exceeds the one defined in hls4ml config
-                maximum_value_rounded = int(math.ceil(np.abs(node.weights['weight'].data).max()))
-                if maximum_value_rounded.bit_length() + 1 > node.weights['weight'].type.precision.integer:
-                    node.weights['weight'].type.precision.integer = maximum_value_rounded.bit_length() + 1
-                    node.weights['weight'].type.precision.width += (maximum_value_rounded.bit_length() + 1 - node.weights['weight'].type.precision.integer)
-                
-                # Fractional precision is increased by 2 bits (division by 4), for low-precision (less than 8) fractional weights
-                if node.weights['weight'].type.precision.fractional < 8: 
-                    node.weights['weight'].type.precision.fractional += 2
-                    node.weights['weight'].type.precision.width += 2
-
-                # Modified kernel size
-                node.set_attr('impl_filt_height', 4)
-                node.set_attr('impl_filt_width', 4)
+            r = node.get_attr('filt_width')
+            m = self._winograd_tile(node, r, [node.get_attr('out_height'), node.get_attr('out_width')])
+            n_dims = 2
+
+            # First, transpose to a format suitable for the Winograd algorithm (F, C, H, W)
+            # Note, this assumes a format post-resource strategy optimizer, that is (F, H, W, C)
+            # Therefore, (F, H, W, C) => (F, C, H, W)
+            weights = np.transpose(node.weights['weight'].data, axes=[0, 3, 1, 2])
+
+            # Transformation GgG', expanding the kernel (r x r) => (m + r - 1) x (m + r - 1)
+            _, G, _ = winograd_matrices(m, r)
+            G = np.array(G, dtype=np.float64)
+            node.weights['weight'].data = np.einsum('ij,fcjk,lk->fcil', G, weights, G)
+
+            # Modified kernel size
+            node.set_attr('impl_filt_height', m + r - 1)
+            node.set_attr('impl_filt_width', m + r - 1)
         else:
             raise Exception('Unexpected layer {} with Winograd kernel optimizer'.format(node.class_name))
 
+        node.weights['weight'].data_length = node.weights['weight'].data.size
+        node.set_attr('winograd_tile', m)
+
+        self._set_transform_precision(node, m, r, n_dims)
+
         node.set_attr('_winograd_transformation_applied', True)
 
-        return False 
\ No newline at end of file
+        return False
+
+    def _set_transform_precision(self, node, m, r, n_dims):
+        '''
+        Sets the precision of the transformed weights and the intermediate results, from the worst-case growth of each transformation.
+        The transformations scale values by up to the largest absolute row sum (L1 norm) of B' and A', per dimension;
+        the transformed weights and the intermediate results are widened so the Winograd result stays within the
+        rounding error of im2col, and never overflows.
+        '''
+        AT, _, BT = winograd_matrices(m, r)
+        bt_norm = max(sum(abs(b) for b in row) for row in BT) ** n_dims
+        at_norm = max(sum(abs(a) for a in row) for row in AT) ** n_dims
+        type_converter = HLSTypeConverter(precision_converter=ACTypeConverter())
+
+        # Input tiles, B'd (B'dB); widened by the integer bits of the growth, so they never overflow
+        input_precision = node.get_input_variable().type.precision
+        input_integer = input_precision.integer + (0 if input_precision.signed else 1)
+        input_width = input_precision.width + (0 if input_precision.signed else 1)
+        growth_bits = int(math.ceil(math.log2(bt_norm)))
+        winograd_t = NamedType(node.name + '_winograd_t', FixedPrecisionType(width=input_width + growth_bits, integer=input_integer + growth_bits, signed=True))
+        node.set_attr('winograd_t', type_converter.convert(winograd_t))
+
+        # Transformed weights, G g (G g G')
+        # Rounding errors of the transformed weights are amplified by both B' and A', while those of the original weights by the kernel size
+        # Therefore, add fractional bits to keep the error of the result the same; integer bits follow the largest transformed weight
+        # The widened type is specific to the layer, as the original one may be shared (e.g., the model default)
+        weight = node.weights['weight']
+        weight_precision = weight.type.precision
+        weight_fractional = weight_precision.width - weight_precision.integer
+        weight_fractional += int(math.ceil(math.log2(bt_norm * at_norm / r ** n_dims)))
+        maximum_value_rounded = int(math.ceil(np.abs(weight.data).max()))
+        weight_integer = max(maximum_value_rounded.bit_length() + 1, weight_precision.integer + (0 if weight_precision.signed else 1))
+        weight_t = NamedType('weight{}_t'.format(node.index), FixedPrecisionType(width=weight_integer + weight_fractional, integer=weight_integer, signed=True,
+            rounding_mode=getattr(weight_precision, 'rounding_mode', None), saturation_mode=getattr(weight_precision, 'saturation_mode', None)))
+        weight.type = type_converter.convert(weight_t)
+        node.set_attr('weight_t', weight.type)
+
+        # Hadamard product and output transformation, A'Y (A'YA)
+        # Rounding errors of the products are amplified by A', so add fractional bits over accum_t
+        # The largest intermediate is bounded by the largest transformed weight and input tile, times the growth of A'
+        accum_precision = node.get_attr('accum_t').precision
+        accum_fractional = accum_precision.width - accum_precision.integer + int(math.ceil(math.log2(at_norm)))
+        input_max = 2.0 ** (input_integer - 1)
+        product_max = max(np.abs(weight.data).max() * input_max * bt_norm * at_norm, 1)
+        accum_integer = max(int(math.ceil(math.log2(product_max))) + 1, accum_precision.integer)
+        winograd_accum_t = NamedType(node.name + '_winograd_accum_t', FixedPrecisionType(width=accum_integer + accum_fractional, integer=accum_integer, signed=True))
+        node.set_attr('winograd_accum_t', type_converter.convert(winograd_accum_t))
@@ -14,8 +14,8 @@ Allows lower latency andresource usage, due to less loop invocations
 pointwise_conv1d_function_template = 'nnet::pointwise_conv_1d_{data_format}<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
 pointwise_conv2d_function_template = 'nnet::pointwise_conv_2d_{data_format}<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
 
-sepconv1d_include_list = ['nnet_utils/nnet_conv1d.h']
-sepconv2d_include_list = ['nnet_utils/nnet_conv2d.h']
+sepconv1d_include_list = ['nnet_utils/nnet_conv1d.h', 'nnet_utils/nnet_conv1d_stream.h']
+sepconv2d_include_list = ['nnet_utils/nnet_conv2d.h', 'nnet_utils/nnet_conv2d_stream.h']
 
 class PointwiseConv1DConfigTemplate(Conv1DConfigTemplate):
     def __init__(self):
@@ -248,6 +248,7 @@ class QuartusBackend(FPGABackend):
 
         # impl_filt_width determines the filter size post-Winograd transformation
         layer.set_attr('impl_filt_width', layer.get_attr('filt_width'))
+        layer.set_attr('winograd_tile', 0)
 
         # Implementation:
         # - combination - at compile-time, the decision between Winograd and im2col is made
@@ -277,6 +278,7 @@ class QuartusBackend(FPGABackend):
         # impl_filt_width & impl_filt_height determine the filter size post-Winograd transformation
         layer.set_attr('impl_filt_height', layer.get_attr('filt_height'))
         layer.set_attr('impl_filt_width', layer.get_attr('filt_width'))
+        layer.set_attr('winograd_tile', 0)
 
         # Implementation:
         # - combination - at compile-time, the decision between Winograd and im2col is made
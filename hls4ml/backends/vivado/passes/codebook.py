@@ -0,0 +1,36 @@
+from hls4ml.model.optimizer import OptimizerPass
+from hls4ml.model.layers import Dense, Conv1D, Conv2D, DepthwiseConv2D
+from hls4ml.model.types import CodebookWeightVariable, CodebookType, ExponentPrecisionType, XnorPrecisionType
+
+class CodebookWeights(OptimizerPass):
+    '''
+    Stores the weights of layers that share a small set of distinct values (e.g., clustered with k-means)
+    as indices into a codebook of those values. The codebook product computes the products of each input
+    with the codebook values once and selects one per weight. Enabled with the 'Codebook' option of the layer.
+    '''
+    max_entries = 256
+
+    def match(self, node):
+        if not isinstance(node, (Dense, Conv1D, Conv2D)) or isinstance(node, DepthwiseConv2D):
+            return False
+        if not node.model.config.get_layer_config_value(node, 'Codebook', False):
+            return False
+        if node.get_attr('strategy', '').lower() == 'compressed':
+            return False
+        weights = node.get_weights('weight')
+        if isinstance(weights.type, CodebookType) or isinstance(weights.type.precision, (ExponentPrecisionType, XnorPrecisionType)):
+            return False
+        return True
+
+    def transform(self, model, node):
+        weights = node.get_weights('weight')
+        var = CodebookWeightVariable(weights.name, 'weight{index}_t', weights.type.precision, weights.data, quantizer=weights.quantizer, index=node.index)
+        n_entries = len(var.type.codebook)
+        if n_entries > self.max_entries:
+            print('WARNING: Layer {} has {} distinct weight values, more than a codebook of {}. Keeping the full weights.'.format(node.name, n_entries, self.max_entries))
+            return False
+
+        var.data_unquantized = weights.data_unquantized
+        node.set_attr('weight', var)
+
+        return False
@@ -15,13 +15,33 @@ class GenerateConvStreamingInstructions(OptimizerPass):
         else:
             raise Exception('Cannot generate instructions for node {} ({})'.format(node.name, node_class))
     
+    @staticmethod
+    def _fits_encoded(in_size, kernel_span, stride):
+        # The scaled image of the encoded implementation reproduces both borders of the input. This holds as long as
+        # the input is not narrower than the borders together, which large dilations can violate on small inputs
+        valid_size = ((in_size - kernel_span) // stride) * stride + kernel_span
+        return valid_size >= 2 * abs(kernel_span - stride)
+
+    def _check_dilated_encoded(self, node, dims):
+        if node.get_attr('implementation') != 'encoded':
+            return
+        for in_size, filt, stride, dilation in dims:
+            if dilation > 1 and not self._fits_encoded(in_size, dilation * (filt - 1) + 1, stride):
+                print('WARNING: Dilated kernel of layer "{}" does not fit the encoded implementation, using the line buffer instead.'.format(node.name))
+                node.set_attr('implementation', 'linebuffer')
+                return
+
     def _generate_1d_instructions(self, node):
         if node.model.config.get_config_value('IOType') == 'io_stream':
+            self._check_dilated_encoded(node, [
+                (node.get_input_variable().shape[0], node.get_attr('filt_width'), node.get_attr('stride_width'), node.get_attr('dilation', 1))
+            ])
             min_w, instructions = node.model.config.backend.compute_conv1d_instructions(
                 node.get_input_variable().shape[0],
                 node.get_input_variable().shape[1],
                 node.get_attr('filt_width'),
-                node.get_attr('stride_width'))
+                node.get_attr('stride_width'),
+                dilation=node.get_attr('dilation', 1))
             instructions_str = ','.join(str(i) for i in instructions)
             node.set_attr('min_width', min_w)
             node.set_attr('instructions', instructions_str)
@@ -31,12 +51,17 @@ class GenerateConvStreamingInstructions(OptimizerPass):
 
     def _generate_2d_instructions(self, node):
         if node.model.config.get_config_value('IOType') == 'io_stream':
+            self._check_dilated_encoded(node, [
+                (node.get_input_variable().shape[0], node.get_attr('filt_height'), node.get_attr('stride_height'), node.get_attr('dilation_height', 1)),
+                (node.get_input_variable().shape[1], node.get_attr('filt_width'), node.get_attr('stride_width'), node.get_attr('dilation_width', 1))
+            ])
             min_h, min_w, instructions = node.model.config.backend.compute_conv2d_instructions(
                 node.get_input_variable().shape[0],
                 node.get_input_variable().shape[1],
                 node.get_input_variable().shape[2],
                 node.get_attr('filt_height'),
-                node.get_attr('stride_height'))
+                node.get_attr('stride_height'),
+                dilation=(node.get_attr('dilation_height', 1), node.get_attr('dilation_width', 1)))
             instructions_str = ','.join(str(i) for i in instructions)
             node.set_attr('min_height', min_h)
             node.set_attr('min_width', min_w)
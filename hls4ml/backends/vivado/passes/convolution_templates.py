@@ -1,7 +1,8 @@
 
 from hls4ml.backends.backend import get_backend
-from hls4ml.model.layers import Conv1D, Conv2D, Conv2DBatchnorm, DepthwiseConv2D, SeparableConv1D, SeparableConv2D
+from hls4ml.model.layers import Conv1D, Conv2D, Conv2DBatchnorm, DepthwiseConv2D, SeparableConv1D, SeparableConv2D, Conv1DTranspose, Conv2DTranspose
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
+from hls4ml.backends.vivado.passes.core_templates import requant_params, shift_add_params, skip_zeros_params, incremental_params
 
 # Shared multiplication template
 
@@ -10,12 +11,17 @@ conv_mult_config_template = """struct config{index}_mult : nnet::dense_config {{
     static const unsigned n_out = {n_out};
     static const unsigned reuse_factor = {reuse};
     static const unsigned strategy = nnet::{strategy};
+    static const bool skip_zeros = {skip_zeros};
+    static const unsigned skip_zeros_lanes = {skip_zeros_lanes};
     typedef {accum_t.name} accum_t;
     typedef {bias_t.name} bias_t;
     typedef {weight_t.name} weight_t;
     template<class x_T, class y_T>
     using product = nnet::product::{product_type}<x_T, y_T>;
-}};\n"""
+    static const bool shift_add = {shift_add};
+    template<class data_T, class res_T, class CONFIG_T>
+    using dense_shift_add = nnet::{shift_add_fn}<data_T, res_T, CONFIG_T>;{requant}
+}};\n{requant_values}"""
 
 # Conv1D templates
 
@@ -45,6 +51,8 @@ conv1d_config_template = """struct config{index} : nnet::conv1d_config {{
     typedef {bias_t.name} bias_t;
     typedef {weight_t.name} weight_t;
     typedef {config_t} mult_config;
+    static const bool incremental = {incremental};
+    static const unsigned incremental_offset = {incremental_offset};
 }};
 const ap_uint<config{index}::filt_width> config{index}::pixels[] = {{{instructions}}};\n"""
 
@@ -62,6 +70,7 @@ class Conv1DConfigTemplate(LayerConfigTemplate):
         params = self._default_config_params(node)
         params['dilation'] = node.get_attr('dilation', 1)
         params['nzeros'] = node.get_weights('weight').nzeros
+        params.update(incremental_params(node))
 
         params['config_t'] = 'config{}_mult'.format(node.index)
         if node.model.config.get_config_value('IOType') == 'io_parallel':
@@ -74,6 +83,9 @@ class Conv1DConfigTemplate(LayerConfigTemplate):
         mult_params['n_in'] = node.get_attr('n_chan') * node.get_attr('filt_width')
         mult_params['n_out'] = node.get_attr('n_filt')
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params.update(skip_zeros_params(node))
+        mult_params.update(requant_params(node, 'config{}_mult'.format(node.index)))
         mult_config = self.mult_template.format(**mult_params)
 
         return mult_config + '\n' + conv_config
@@ -107,6 +119,8 @@ conv2d_config_template = """struct config{index} : nnet::conv2d_config {{
     static const unsigned n_filt = {n_filt};
     static const unsigned stride_height = {stride_height};
     static const unsigned stride_width = {stride_width};
+    static const unsigned dilation_height = {dilation_height};
+    static const unsigned dilation_width = {dilation_width};
     static const unsigned out_height = {out_height};
     static const unsigned out_width = {out_width};
     static const unsigned reuse_factor = {reuse};
@@ -142,6 +156,8 @@ class Conv2DConfigTemplate(LayerConfigTemplate):
     def format(self, node):
         params = self._default_config_params(node)
         params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation_height'] = node.get_attr('dilation_height', 1)
+        params['dilation_width'] = node.get_attr('dilation_width', 1)
         params['nzeros'] = node.get_weights('weight').nzeros
 
         params['config_t'] = 'config{}_mult'.format(node.index)
@@ -155,6 +171,9 @@ class Conv2DConfigTemplate(LayerConfigTemplate):
         mult_params['n_in'] = node.get_attr('n_chan') * node.get_attr('filt_height') * node.get_attr('filt_width')
         mult_params['n_out'] = node.get_attr('n_filt')
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params.update(skip_zeros_params(node))
+        mult_params.update(requant_params(node, 'config{}_mult'.format(node.index)))
         mult_config = self.mult_template.format(**mult_params)
 
         return mult_config + '\n' + conv_config
@@ -213,6 +232,7 @@ class SeparableConv1DConfigTemplate(LayerConfigTemplate):
         params['dilation'] = node.get_attr('dilation', 1)
         params['nzeros'] = node.get_weights('depthwise').nzeros
         params['index'] = str(node.index) + '_depthwise'
+        params.update(incremental_params(node))
         params['weight_t'] = node.get_weights('depthwise').type
         params['fill_fn'] = 'FillConv1DBuffer'
 
@@ -226,6 +246,10 @@ class SeparableConv1DConfigTemplate(LayerConfigTemplate):
         mult_params['n_out'] = node.get_attr('n_chan')
         mult_params['weight_t'] = node.get_weights('depthwise').type
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('depthwise').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params['skip_zeros'] = 'false'
+        mult_params['skip_zeros_lanes'] = 1
+        mult_params['requant'] = mult_params['requant_values'] = ''
         depthwise_mult_config = self.depthwise_mult_template.format(**mult_params)
 
         # Pointwise config
@@ -243,6 +267,7 @@ class SeparableConv1DConfigTemplate(LayerConfigTemplate):
         params['dilation'] = node.get_attr('dilation', 1)
         params['nzeros'] = node.get_weights('pointwise').nzeros
         params['index'] = str(node.index) + '_pointwise'
+        params.update(incremental_params(node))
         params['weight_t'] = node.get_weights('pointwise').type
         params['min_width'] = params['in_width']
         params['instructions'] = '0'
@@ -258,6 +283,9 @@ class SeparableConv1DConfigTemplate(LayerConfigTemplate):
         mult_params['n_out'] = node.get_attr('n_filt')
         mult_params['weight_t'] = node.get_weights('pointwise').type
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('pointwise').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params.update(skip_zeros_params(node))
+        mult_params['requant'] = mult_params['requant_values'] = ''
         pointwise_mult_config = self.pointwise_mult_template.format(**mult_params)
 
         return depthwise_mult_config + '\n' + depthwise_config + '\n' + pointwise_mult_config + '\n' + pointwise_config + '\n' + sep_config
@@ -298,8 +326,10 @@ class SeparableConv2DConfigTemplate(LayerConfigTemplate):
         params = self._default_config_params(node)
         params['n_filt'] = params['n_chan'] # In depthwise step n_chan == n_filt
         params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation_height'] = params['dilation_width'] = 1
         params['nzeros'] = node.get_weights('depthwise').nzeros
         params['index'] = str(node.index) + '_depthwise'
+        params.update(incremental_params(node))
         params['weight_t'] = node.get_weights('depthwise').type
         params['fill_fn'] = 'FillConv2DBuffer'
 
@@ -313,6 +343,10 @@ class SeparableConv2DConfigTemplate(LayerConfigTemplate):
         mult_params['n_out'] = node.get_attr('n_chan')
         mult_params['weight_t'] = node.get_weights('depthwise').type
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('depthwise').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params['skip_zeros'] = 'false'
+        mult_params['skip_zeros_lanes'] = 1
+        mult_params['requant'] = mult_params['requant_values'] = ''
         depthwise_mult_config = self.depthwise_mult_template.format(**mult_params)
 
         # Pointwise config
@@ -327,8 +361,10 @@ class SeparableConv2DConfigTemplate(LayerConfigTemplate):
         params['filt_height'] = params['filt_width'] = 1
         params['stride_height'] = params['stride_width'] = 1
         params['dilation'] = node.get_attr('dilation', 1)
+        params['dilation_height'] = params['dilation_width'] = 1
         params['nzeros'] = node.get_weights('pointwise').nzeros
         params['index'] = str(node.index) + '_pointwise'
+        params.update(incremental_params(node))
         params['weight_t'] = node.get_weights('pointwise').type
         params['min_height'] = params['in_height']
         params['min_width'] = params['in_width']
@@ -345,6 +381,9 @@ class SeparableConv2DConfigTemplate(LayerConfigTemplate):
         mult_params['n_out'] = node.get_attr('n_filt')
         mult_params['weight_t'] = node.get_weights('pointwise').type
         mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('pointwise').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params.update(skip_zeros_params(node))
+        mult_params['requant'] = mult_params['requant_values'] = ''
         pointwise_mult_config = self.pointwise_mult_template.format(**mult_params)
 
         return depthwise_mult_config + '\n' + depthwise_config + '\n' + pointwise_mult_config + '\n' + pointwise_config + '\n' + sep_config
@@ -363,3 +402,95 @@ class SeparableConv2DFunctionTemplate(FunctionCallTemplate):
         params['z'] = node.get_weights('zero_bias').name
 
         return self.template.format(**params)
+
+# Conv1DTranspose/Conv2DTranspose Templates
+
+conv1d_transpose_config_template = """struct config{index} : nnet::conv1d_transpose_config {{
+    static const unsigned in_width = {in_width};
+    static const unsigned n_chan = {n_chan};
+    static const unsigned filt_width = {filt_width};
+    static const unsigned n_filt = {n_filt};
+    static const unsigned stride_width = {stride_width};
+    static const unsigned out_width = {out_width};
+    static const unsigned sub_filt_width = {sub_filt_width};
+    static const unsigned crop_left = {crop_left};
+    static const unsigned reuse_factor = {reuse};
+    static const unsigned n_zeros = {nzeros};
+    static const bool store_weights_in_bram = false;
+    static const unsigned strategy = nnet::{strategy};
+    typedef {accum_t.name} accum_t;
+    typedef {bias_t.name} bias_t;
+    typedef {weight_t.name} weight_t;
+    typedef {config_t} mult_config;
+}};\n"""
+
+conv2d_transpose_config_template = """struct config{index} : nnet::conv2d_transpose_config {{
+    static const unsigned in_height = {in_height};
+    static const unsigned in_width = {in_width};
+    static const unsigned n_chan = {n_chan};
+    static const unsigned filt_height = {filt_height};
+    static const unsigned filt_width = {filt_width};
+    static const unsigned n_filt = {n_filt};
+    static const unsigned stride_height = {stride_height};
+    static const unsigned stride_width = {stride_width};
+    static const unsigned out_height = {out_height};
+    static const unsigned out_width = {out_width};
+    static const unsigned sub_filt_height = {sub_filt_height};
+    static const unsigned sub_filt_width = {sub_filt_width};
+    static const unsigned crop_top = {crop_top};
+    static const unsigned crop_left = {crop_left};
+    static const unsigned reuse_factor = {reuse};
+    static const unsigned n_zeros = {nzeros};
+    static const bool store_weights_in_bram = false;
+    static const unsigned strategy = nnet::{strategy};
+    typedef {accum_t.name} accum_t;
+    typedef {bias_t.name} bias_t;
+    typedef {weight_t.name} weight_t;
+    typedef {config_t} mult_config;
+}};\n"""
+
+conv1d_transpose_function_template = 'nnet::conv_1d_transpose_cl<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
+conv2d_transpose_function_template = 'nnet::conv_2d_transpose_cl<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
+
+conv_transpose_include_list = ['nnet_utils/nnet_conv_transpose.h', 'nnet_utils/nnet_conv_transpose_stream.h']
+
+class ConvTransposeConfigTemplate(LayerConfigTemplate):
+    def __init__(self):
+        super().__init__((Conv1DTranspose, Conv2DTranspose))
+        self.templates = {
+            'Conv1DTranspose': conv1d_transpose_config_template,
+            'Conv2DTranspose': conv2d_transpose_config_template,
+        }
+        self.mult_template = conv_mult_config_template
+
+    def format(self, node):
+        params = self._default_config_params(node)
+        params['nzeros'] = node.get_weights('weight').nzeros
+        params['config_t'] = 'config{}_mult'.format(node.index)
+        conv_config = self.templates[node.class_name].format(**params)
+
+        # A single product with the input window computes the outputs of all stride phases
+        mult_params = self._default_config_params(node)
+        mult_params['n_in'], mult_params['n_out'] = get_backend('vivado').get_layer_mult_size(node)
+        mult_params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
+        mult_params.update(shift_add_params(node))
+        mult_params.update(skip_zeros_params(node))
+        mult_params.update(requant_params(node, 'config{}_mult'.format(node.index)))
+        mult_config = self.mult_template.format(**mult_params)
+
+        return mult_config + '\n' + conv_config
+
+class ConvTransposeFunctionTemplate(FunctionCallTemplate):
+    def __init__(self):
+        super().__init__((Conv1DTranspose, Conv2DTranspose), include_header=conv_transpose_include_list)
+        self.templates = {
+            'Conv1DTranspose': conv1d_transpose_function_template,
+            'Conv2DTranspose': conv2d_transpose_function_template,
+        }
+
+    def format(self, node):
+        params = self._default_function_params(node)
+        params['w'] = node.get_weights('weight').name
+        params['b'] = node.get_weights('bias').name
+
+        return self.templates[node.class_name].format(**params)
@@ -1,6 +1,6 @@
 
 from hls4ml.backends.backend import get_backend
-from hls4ml.model.layers import Activation, BatchNormalization, LayerNormalization, Dense, Embedding, PReLU, ParametrizedActivation, Softmax
+from hls4ml.model.layers import Activation, BatchNormalization, LayerNormalization, Dense, Embedding, PReLU, ParametrizedActivation, Softmax, TopK
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
 
 # Dense templates
@@ -15,18 +15,64 @@ dense_config_template = """struct config{index} : nnet::dense_config {{
     static const unsigned n_zeros = {nzeros};
     static const unsigned n_nonzeros = {nonzeros};
     static const bool store_weights_in_bram = false;
+    static const bool skip_zeros = {skip_zeros};
+    static const unsigned skip_zeros_lanes = {skip_zeros_lanes};
     typedef {accum_t.name} accum_t;
     typedef {bias_t.name} bias_t;
     typedef {weight_t.name} weight_t;
     typedef {index_t.name} index_t;
     template<class x_T, class y_T>
     using product = nnet::product::{product_type}<x_T, y_T>;
-}};\n"""
+    static const bool shift_add = {shift_add};
+    template<class data_T, class res_T, class CONFIG_T>
+    using dense_shift_add = nnet::{shift_add_fn}<data_T, res_T, CONFIG_T>;{requant}
+}};\n{requant_values}"""
 
 dense_function_template = 'nnet::dense<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {b});'
 
 dense_include_list = ['nnet_utils/nnet_dense.h', 'nnet_utils/nnet_dense_compressed.h', 'nnet_utils/nnet_dense_stream.h']
 
+# Per-channel requantization epilogue of the integer-only mode, shared with the convolution templates
+
+requant_config_template = """
+    static const bool requant = true;
+    typedef {requant_scale_t.name} requant_scale_t;
+    typedef {requant_bias_t.name} requant_bias_t;
+    static const requant_scale_t requant_scale[{n_chan}];
+    static const requant_bias_t requant_bias[{n_chan}];"""
+
+requant_values_template = """const {config}::requant_scale_t {config}::requant_scale[] = {{{scale}}};
+const {config}::requant_bias_t {config}::requant_bias[] = {{{bias}}};\n"""
+
+def shift_add_params(node):
+    if node.get_attr('shift_add', False):
+        return {'shift_add': 'true', 'shift_add_fn': 'dense_shift_add_{}'.format(node.index)}
+    else:
+        return {'shift_add': 'false', 'shift_add_fn': 'DenseShiftAdd'}
+
+def skip_zeros_params(node):
+    return {
+        'skip_zeros': 'true' if node.get_attr('skip_zeros', False) else 'false',
+        'skip_zeros_lanes': node.get_attr('skip_zeros_lanes', 1),
+    }
+
+def incremental_params(node):
+    return {
+        'incremental': 'true' if node.get_attr('incremental', False) else 'false',
+        'incremental_offset': node.get_attr('incremental_offset', 0),
+    }
+
+def requant_params(node, config):
+    if not node.get_attr('requant', False):
+        return {'requant': '', 'requant_values': ''}
+
+    scale = node.get_attr('requant_scale')
+    bias = node.get_attr('requant_bias')
+    members = requant_config_template.format(n_chan=len(scale), requant_scale_t=node.get_attr('requant_scale_t'), requant_bias_t=node.get_attr('requant_bias_t'))
+    values = requant_values_template.format(config=config, scale=', '.join(str(float(s)) for s in scale), bias=', '.join(str(float(b)) for b in bias))
+
+    return {'requant': members, 'requant_values': values}
+
 class DenseConfigTemplate(LayerConfigTemplate):
     def __init__(self):
         super().__init__(Dense)
@@ -37,6 +83,9 @@ class DenseConfigTemplate(LayerConfigTemplate):
         params['nzeros'] = node.get_weights('weight').nzeros
         params['nonzeros'] = node.get_weights('weight').nonzeros
         params['product_type'] = get_backend('vivado').product_type(node.get_input_variable().type.precision, node.get_weights('weight').type.precision)
+        params.update(shift_add_params(node))
+        params.update(skip_zeros_params(node))
+        params.update(requant_params(node, 'config{}'.format(node.index)))
 
         return self.template.format(**params)
 
@@ -156,6 +205,7 @@ activ_config_template = """struct {type}_config{index} : nnet::activ_config {{
 
 softmax_config_template = """struct {type}_config{index} : nnet::activ_config {{
     static const unsigned n_in = {n_in};
+    static const unsigned n_slice = {n_slice};
     static const unsigned table_size = {table_size};
     static const unsigned io_type = nnet::{iotype};
     static const unsigned reuse_factor = {reuse};
@@ -226,3 +276,39 @@ class PReLUFunctionTemplate(FunctionCallTemplate):
         params['config'] = '{}_config{}'.format(node.get_attr('activation'), node.index)
 
         return self.template.format(**params)
+
+# TopK templates
+
+topk_config_template = """struct config{index} : nnet::topk_config {{
+    static const unsigned n_in = {n_in};
+    static const unsigned k = {k};
+}};\n"""
+
+topk_function_template = 'nnet::topk<{input_t}, {output_t}, {config}>({input}, {output});'
+topk_scores_function_template = 'nnet::topk<{input_t}, {output_t}, {scores_t}, {config}>({input}, {output}, {scores});'
+
+topk_include_list = ['nnet_utils/nnet_topk.h', 'nnet_utils/nnet_topk_stream.h']
+
+class TopKConfigTemplate(LayerConfigTemplate):
+    def __init__(self):
+        super().__init__(TopK)
+        self.template = topk_config_template
+
+    def format(self, node):
+        params = self._default_config_params(node)
+        return self.template.format(**params)
+
+class TopKFunctionTemplate(FunctionCallTemplate):
+    def __init__(self):
+        super().__init__(TopK, include_header=topk_include_list)
+        self.template = topk_function_template
+        self.scores_template = topk_scores_function_template
+
+    def format(self, node):
+        params = self._default_function_params(node)
+        if node.get_attr('output_scores'):
+            scores = node.get_output_variable(node.outputs[1])
+            params['scores_t'] = scores.type.name
+            params['scores'] = scores.name
+            return self.scores_template.format(**params)
+        return self.template.format(**params)
@@ -0,0 +1,109 @@
+from hls4ml.model.optimizer import ModelOptimizerPass
+from hls4ml.model.layers import Input, Conv1D, Pooling1D, LSTM, GRU, MultiHeadAttention, Activation, BatchNormalization, Merge, Concatenate, Dot
+
+class IncrementalInference(ModelOptimizerPass):
+    '''
+    Converts a model over a window of time steps for sliding window inference on a stream. With the 'IncrementalStep'
+    option of the model set to k, each call of the model reads the next k time steps of the series, instead of the whole
+    window, and only computes the outputs of the temporal layers that depend on them. The convolution and pooling
+    layers keep the end of their input window between calls, so each call returns the last k / (product of the strides)
+    outputs of the original model over the window ending at the newest time step, once the window is filled (after
+    in_width / k calls). The MultiHeadAttention layers keep the projected keys and values of the last seq_len tokens
+    (KV cache), so each call only projects the k new tokens and computes their attention over the window. The recurrent
+    layers keep their state between calls instead, i.e., they process the whole series, not only the window. The state
+    is cleared with `ModelGraph.reset_state()`.
+
+    Supported are the io_stream implementation of Conv1D and Pooling1D with 'valid' padding and no dilation, with k a
+    multiple of the strides, the io_parallel implementation of MultiHeadAttention, LSTM and GRU, and the element-wise
+    layers between them. The layers after the temporal axis is reduced (e.g., by a recurrent layer that doesn't return
+    the sequences) are not changed.
+    '''
+    def __init__(self):
+        self.name = 'incremental_inference'
+
+    def transform(self, model):
+        step = model.config.model_incremental_step
+        if not step:
+            return False
+        inputs = [model.graph[name] for name in model.inputs]
+        if all(inp.get_attr('incremental_step') is not None for inp in inputs):
+            return False # Already converted
+        io_type = model.config.get_config_value('IOType')
+
+        # Step of the outputs with a temporal (first) axis, by output name
+        steps = {}
+        for node in model.get_layers():
+            in_steps = [steps[name] for name in node.inputs if name in steps]
+            if isinstance(node, Input):
+                shape = node.get_output_variable().shape
+                if len(shape) < 2 or step > shape[0]:
+                    raise Exception('The input "{}" of shape {} has no temporal axis of at least {} steps'.format(node.name, shape, step))
+                node.set_attr('incremental_step', step)
+                self._set_steps(node, step, steps)
+            elif len(in_steps) == 0:
+                continue
+            elif isinstance(node, (Conv1D, Pooling1D)):
+                if io_type != 'io_stream':
+                    raise Exception('Incremental inference of layer "{}" requires io_stream'.format(node.name))
+                self._convert_window(node, in_steps[0], steps)
+            elif isinstance(node, MultiHeadAttention):
+                if io_type != 'io_parallel':
+                    raise Exception('Incremental inference of layer "{}" requires io_parallel'.format(node.name))
+                if len(in_steps) != len(node.inputs) or len(set(in_steps)) != 1:
+                    raise Exception('The query and key/value of layer "{}" are not computed with the same step'.format(node.name))
+                node.set_attr('kv_cache', True)
+                node.set_attr('n_tokens', in_steps[0])
+                self._set_steps(node, in_steps[0], steps)
+            elif isinstance(node, (LSTM, GRU)):
+                node.set_attr('n_timesteps', in_steps[0])
+                node.set_attr('static', True)
+                node.set_attr('incremental', True)
+                if node.get_attr('return_sequences'):
+                    self._set_steps(node, in_steps[0], steps)
+            elif isinstance(node, (Activation, BatchNormalization)):
+                self._set_steps(node, in_steps[0], steps)
+                node.set_attr('n_in', node.get_output_variable().size())
+            elif isinstance(node, Merge) and not isinstance(node, (Concatenate, Dot)):
+                if len(in_steps) != len(node.inputs) or len(set(in_steps)) != 1:
+                    raise Exception('The inputs of layer "{}" are not computed with the same step'.format(node.name))
+                self._set_steps(node, in_steps[0], steps)
+            else:
+                raise Exception('Layer "{}" ({}) does not support incremental inference'.format(node.name, node.class_name))
+
+        return True
+
+    def _set_steps(self, node, step, steps):
+        for name in node.outputs:
+            var = node.get_output_variable(name)
+            var.shape = [step] + var.shape[1:]
+            steps[name] = step
+
+    def _convert_window(self, node, step, steps):
+        if node.class_name == 'Conv1D':
+            width, n_out, filt_width = node.get_attr('in_width'), node.get_attr('out_width'), node.get_attr('filt_width')
+            if node.get_attr('dilation', 1) != 1:
+                raise Exception('Incremental inference of layer "{}" with dilation is not supported'.format(node.name))
+        else:
+            width, n_out, filt_width = node.get_attr('n_in'), node.get_attr('n_out'), node.get_attr('pool_width')
+        stride = node.get_attr('stride_width')
+        if node.get_attr('pad_left') != 0 or node.get_attr('pad_right') != 0 or node.get_attr('data_format', 'channels_last') != 'channels_last':
+            raise Exception('Incremental inference of layer "{}" requires channels_last data and "valid" padding'.format(node.name))
+        if step % stride != 0 or step // stride > n_out:
+            raise Exception('The step {} of layer "{}" is not a multiple of the stride {} or exceeds the output width'.format(step, node.name, stride))
+
+        # Outputs are computed on the input steps with the same phase (modulo the stride) as the last output of the
+        # original layer, which ends (width - filt_width) % stride steps before the end of the window
+        end_offset = (width - filt_width) % stride
+        out_step = step // stride
+        if node.class_name == 'Conv1D':
+            node.set_attr('in_width', step)
+            node.set_attr('out_width', out_step)
+            stateless = filt_width == 1 and stride == 1
+        else:
+            node.set_attr('n_in', step)
+            node.set_attr('n_out', out_step)
+            stateless = False
+        if not stateless:
+            node.set_attr('incremental', True)
+            node.set_attr('incremental_offset', (stride - 1 - end_offset) % stride)
+        self._set_steps(node, out_step, steps)
@@ -53,7 +53,8 @@ class OptimizePointwiseConv(OptimizerPass):
     def match(self, node):
         return node.class_name in ('Conv1D', 'Conv2D') and \
             node.get_attr('filt_height', 1) == 1 and \
-            node.get_attr('filt_width') == 1
+            node.get_attr('filt_width') == 1 and \
+            not node.get_attr('incremental', False)
 
     def transform(self, model, node):
         dim = node.__class__.__name__[-2:] # '1D' or '2D'
@@ -1,6 +1,7 @@
 
 from hls4ml.model.layers import Pooling1D, Pooling2D, GlobalPooling1D, GlobalPooling2D
 from hls4ml.backends.template import LayerConfigTemplate, FunctionCallTemplate
+from hls4ml.backends.vivado.passes.core_templates import incremental_params
 
 # Pooling templates
 
@@ -20,6 +21,8 @@ pooling1d_config_template = """struct config{index} : nnet::pooling1d_config {{
     static const nnet::conv_implementation implementation = nnet::conv_implementation::{implementation};
     static const unsigned reuse_factor = {reuse};
     typedef {accum_t.name} accum_t;
+    static const bool incremental = {incremental};
+    static const unsigned incremental_offset = {incremental_offset};
 }};\n"""
 
 pooling2d_config_template = """struct config{index} : nnet::pooling2d_config {{
@@ -83,6 +86,7 @@ class PoolingConfigTemplate(LayerConfigTemplate):
 
     def format(self, node):
         params = self._default_config_params(node)
+        params.update(incremental_params(node))
         return self.templates[node.class_name].format(**params)
 
 class PoolingFunctionTemplate(FunctionCallTemplate):
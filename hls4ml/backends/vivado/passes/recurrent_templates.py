@@ -62,9 +62,12 @@ recr_config_template = """struct config{index} : nnet::{recr_type}_config {{
     static const unsigned reuse_factor = {reuse};
     static const bool store_weights_in_bram = false;
     static const bool use_static = {static};
+    static const bool incremental = {incremental};
+    static const unsigned n_contexts = {n_contexts};
 }};\n"""
 
 recr_function_template = 'nnet::{recr_type}_stack<{input_t}, {output_t}, {config}>({input}, {output}, {w}, {wr}, {b}, {br});'
+recr_context_function_template = 'nnet::{recr_type}_stack<{input_t}, {output_t}, {config}>({input}, {output}, context, {w}, {wr}, {b}, {br});'
 
 recr_include_list = ['nnet_utils/nnet_recurrent.h']
 
@@ -97,6 +100,8 @@ class RecurrentConfigTemplate(LayerConfigTemplate):
         params['act_t'] = '{}_config{}'.format(node.get_attr('activation'), node.index)
         params['strategy'] = node.get_attr('strategy')
         params['static'] = 'true' if node.attributes['static'] else 'false'
+        params['incremental'] = 'true' if node.get_attr('incremental', False) else 'false'
+        params['n_contexts'] = node.get_attr('n_contexts', 1)
         params['recr_type'] = node.class_name.lower()
         params['RECR_TYPE'] = node.class_name
 
@@ -156,6 +161,7 @@ class RecurrentFunctionTemplate(FunctionCallTemplate):
     def __init__(self):
         super().__init__((LSTM, GRU), include_header=recr_include_list)
         self.template = recr_function_template
+        self.context_template = recr_context_function_template
 
     def format(self, node):
         params = self._default_function_params(node)
@@ -167,5 +173,8 @@ class RecurrentFunctionTemplate(FunctionCallTemplate):
         params['recurrent_activation'] = node.get_attr('recurrent_activation')
         params['recr_type'] = node.class_name.lower()
 
+        if node.get_attr('n_contexts', 1) > 1:
+            # The state of each context (the 'context' argument of the top level function) is kept between calls
+            return self.context_template.format(**params)
         return self.template.format(**params)
 
@@ -1,7 +1,7 @@
 import numpy as np
 
 from hls4ml.model.optimizer import OptimizerPass
-from hls4ml.model.layers import Layer, Merge, Reshape, Concatenate, register_layer
+from hls4ml.model.layers import Layer, Merge, Reshape, Concatenate, Softmax, register_layer
 from hls4ml.backends.template import FunctionCallTemplate, LayerConfigTemplate
 
 class Repack(Layer):
@@ -83,6 +83,7 @@ def register_repack_stream(backend):
     # Register the optimization passes
     backend.register_pass('reshape_stream', ReshapeStream)
     backend.register_pass('broadcast_stream', BroadcastStream)
+    backend.register_pass('split_softmax_stream', SplitSoftmaxStream)
     
     # Register template passes
     backend.register_template(RepackFunctionTemplate)
@@ -160,3 +161,43 @@ class BroadcastStream(OptimizerPass):
         node.inputs[idx] = brdcst_out
 
         return True
+
+class SplitSoftmaxStream(OptimizerPass):
+    ''' Streams the softmax axis over several narrower words if 'PackSize' is set for the layer '''
+    def match(self, node):
+        return isinstance(node, Softmax) and node.get_attr('n_pack', 1) == 1
+
+    def transform(self, model, node):
+        if model.config.get_config_value('IOType') != 'io_stream':
+            return False
+
+        pack_size = model.config.get_layer_config_value(node, 'PackSize', None)
+        n_slice = node.get_input_variable().shape[-1]
+        if pack_size is None or pack_size >= n_slice:
+            return False
+        if n_slice % pack_size != 0:
+            raise RuntimeError('PackSize ({}) of {} must divide the softmax axis length ({})'.format(pack_size, node.name, n_slice))
+
+        n_pack = -(n_slice // pack_size)
+        if node.get_attr('implementation') == 'legacy':
+            # The legacy implementation needs the whole axis at once
+            node.set_attr('implementation', 'stable')
+
+        attrs = {
+            'target_shape': node.get_input_variable().shape,
+            'n_pack': n_pack
+        }
+        unpack_layer = model.make_node(Repack, 'unpack_' + node.name, attrs, node.inputs.copy())
+        model.insert_node(unpack_layer, before=node)
+        node.set_attr('n_pack', n_pack)
+
+        # Restore full packing for the consumer, if any. A model output is left unpacked.
+        next_node = next((x for x in model.graph.values() if node.outputs[0] in x.inputs), None)
+        if next_node is not None:
+            attrs = {
+                'target_shape': node.get_output_variable().shape
+            }
+            pack_layer = model.make_node(Repack, 'pack_' + node.name, attrs, [node.outputs[0]])
+            model.insert_node(pack_layer, before=next_node, input_idx=next_node.inputs.index(node.outputs[0]))
+
+        return True
@@ -1,13 +1,13 @@
 import numpy as np
 
 from hls4ml.model.optimizer import OptimizerPass
-from hls4ml.model.layers import Conv1D, Conv2D, Dense, SeparableConv1D, SeparableConv2D, LSTM, GRU, MultiHeadAttention
+from hls4ml.model.layers import Conv1D, Conv2D, Conv1DTranspose, Conv2DTranspose, Dense, SeparableConv1D, SeparableConv2D, LSTM, GRU, MultiHeadAttention
 
 class ApplyResourceStrategy(OptimizerPass):
     ''' Transposes the weights to use the dense_resource matrix multiply routine '''
     def match(self, node):
         
-        node_matches = isinstance(node, (Dense, Conv1D, SeparableConv1D, Conv2D, SeparableConv2D, LSTM, GRU, MultiHeadAttention))
+        node_matches = isinstance(node, (Dense, Conv1D, SeparableConv1D, Conv2D, SeparableConv2D, Conv1DTranspose, Conv2DTranspose, LSTM, GRU, MultiHeadAttention))
         is_resource_strategy = node.get_attr('strategy', '').lower() == 'resource'
         already_transformed = node.get_attr('_weights_transposed', False) == True
 
@@ -23,6 +23,10 @@ class ApplyResourceStrategy(OptimizerPass):
             node.weights['pointwise'].data = np.transpose(node.weights['pointwise'].data, axes=[2, 0, 1]) #(W,C,F) => (F,W,C)
         elif isinstance(node, Conv2D):
             node.weights['weight'].data = np.transpose(node.weights['weight'].data, axes=[3, 0, 1, 2]) #(H,W,C,F) => (F,H,W,C)
+        elif isinstance(node, Conv1DTranspose):
+            node.weights['weight'].data = np.transpose(node.weights['weight'].data, axes=[2, 0, 1]) #(W,C,P*F) => (P*F,W,C)
+        elif isinstance(node, Conv2DTranspose):
+            node.weights['weight'].data = np.transpose(node.weights['weight'].data, axes=[3, 0, 1, 2]) #(H,W,C,P*F) => (P*F,H,W,C)
         elif isinstance(node, SeparableConv2D):
             node.weights['depthwise'].data = np.transpose(node.weights['depthwise'].data, axes=[3, 0, 1, 2]) #(H,W,C,F) => (F,H,W,C)
             node.weights['pointwise'].data = np.transpose(node.weights['pointwise'].data, axes=[3, 0, 1, 2]) #(H,W,C,F) => (F,H,W,C)
@@ -37,7 +41,18 @@ class ApplyResourceStrategy(OptimizerPass):
             print("not transpose")
         else:
             raise Exception('Unexpected layer {} with resource strategy'.format(node.class_name))
+
+        if node.get_attr('skip_zeros', False):
+            self._reorder_skip_zeros(node)
         
         node.set_attr('_weights_transposed', True)
 
         return False
+
+    def _reorder_skip_zeros(self, node):
+        # (F, n_in) => (F, n_lanes, n_in / n_lanes), each lane reads its inputs i_in = j * n_lanes + k from its own bank
+        w_name = 'pointwise' if isinstance(node, (SeparableConv1D, SeparableConv2D)) else 'weight'
+        data = node.weights[w_name].data
+        n_lanes = node.get_attr('skip_zeros_lanes')
+        w = np.reshape(data, (data.shape[0], -1, n_lanes))
+        node.weights[w_name].data = np.reshape(np.transpose(w, axes=[0, 2, 1]), data.shape)
@@ -0,0 +1,29 @@
+from hls4ml.model.optimizer import OptimizerPass
+from hls4ml.model.layers import Softmax, TopK
+
+class ReplaceSoftmaxWithTopK(OptimizerPass):
+    '''
+    Replaces a softmax at the output of the model with a top-k layer that returns the indices of the k largest
+    inputs (the argmax for k = 1). Softmax preserves the order of its inputs, so the indices are the same, without
+    the exponential and inversion tables. Enabled with the 'TopK' option of the softmax layer, set to k. With
+    'TopKScores' the layer also outputs the selected inputs of the softmax (the logits, not the probabilities).
+    '''
+    def match(self, node):
+        if not isinstance(node, Softmax):
+            return False
+        if not node.model.config.get_layer_config_value(node, 'TopK', 0):
+            return False
+        return node.outputs[0] in node.model.outputs and len(node.get_input_variable().shape) == 1
+
+    def transform(self, model, node):
+        attrs = {
+            'k': int(model.config.get_layer_config_value(node, 'TopK')),
+            'output_scores': bool(model.config.get_layer_config_value(node, 'TopKScores', False)),
+        }
+        outputs = [node.outputs[0]]
+        if attrs['output_scores']:
+            outputs.append(node.outputs[0] + '_scores')
+        new_node = model.make_node(TopK, node.name, attrs, node.inputs.copy(), outputs)
+        model.replace_node(node, new_node)
+
+        return True
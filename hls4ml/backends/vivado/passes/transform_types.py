@@ -19,7 +19,7 @@ class TransformTypes(GlobalOptimizerPass):
             if isinstance(var, InplaceVariable):
                 new_var = self.inplace_var_converter.convert(var, io_type)
             if io_type == 'io_stream':
-                new_var = self.stream_var_converter.convert(var)
+                new_var = self.stream_var_converter.convert(var, n_pack=node.get_attr('n_pack', 1))
             elif io_type == 'io_parallel':
                 if node.name in node.model.inputs:
                     new_var = self.array_var_converter.convert(var, pragma='reshape')
@@ -49,6 +49,7 @@ mha_config_template = """struct config{index} : nnet::multiheadattention_config
     static const unsigned head_dim_value = {head_dim_value};
     static const unsigned feature_dim = {feature_dim};
     static const unsigned seq_len = {seq_len};
+    static const unsigned n_tokens = {n_tokens};
 
     static const unsigned io_type = nnet::{iotype};
     static const unsigned reuse_factor = {reuse};
@@ -57,6 +58,7 @@ mha_config_template = """struct config{index} : nnet::multiheadattention_config
 
 
 mha_function_template = 'nnet::multiheadattention<{input_t}, {output_t}, {config}>({input_q}, {input_kv}, {output}, {w_o}, {b_o}, {w_k}, {b_k}, {w_q}, {b_q}, {w_v}, {b_v});'
+mha_kv_cache_function_template = 'nnet::multiheadattention_kv_cache<{input_t}, {output_t}, {config}>({input_q}, {input_kv}, {output}, {w_o}, {b_o}, {w_k}, {b_k}, {w_q}, {b_q}, {w_v}, {b_v});'
 
 mha_include_list = ['nnet_utils/nnet_multiheadattention.h']
 
@@ -76,6 +78,7 @@ class MhaConfigTemplate(LayerConfigTemplate):
         params['head_dim_value'] = node.get_attr('head_dim_value')
         params['feature_dim'] = node.get_attr('feature_dim')
         params['seq_len'] = node.get_attr('seq_len')
+        params['n_tokens'] = node.get_attr('n_tokens', node.get_attr('seq_len'))
         params['config_mult_t1'] = 'config{}_1'.format(node.index)
         params['config_mult_t2'] = 'config{}_2'.format(node.index)
         params['config_activ_t1'] = '{}_config{}'.format("softmax", node.index)
@@ -120,6 +123,7 @@ class MhaFunctionTemplate(FunctionCallTemplate):
     def __init__(self):
         super().__init__(MultiHeadAttention, include_header=mha_include_list)
         self.template = mha_function_template
+        self.kv_cache_template = mha_kv_cache_function_template
 
     def format(self, node):
         params = {}
@@ -140,5 +144,7 @@ class MhaFunctionTemplate(FunctionCallTemplate):
         params['w_v'] = node.get_weights('value_weight').name
         params['b_v'] = node.get_weights('value_bias').name
 
+        if node.get_attr('kv_cache', False):
+            return self.kv_cache_template.format(**params)
         return self.template.format(**params)
 
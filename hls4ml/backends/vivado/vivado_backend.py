@@ -7,7 +7,7 @@ from queue import Queue
 from collections.abc import Iterable
 
 from hls4ml.model.types import FixedPrecisionType, NamedType, IntegerPrecisionType
-from hls4ml.model.layers import Layer, Dense, BatchNormalization, LayerNormalization, Embedding, Conv1D, Conv2D, Conv2DBatchnorm, SeparableConv1D, SeparableConv2D, DepthwiseConv2D, Activation, ParametrizedActivation, PReLU, Softmax, Pooling1D, Pooling2D, GlobalPooling1D, GlobalPooling2D, ZeroPadding1D, ZeroPadding2D, Merge, Concatenate, Dot, Resize, Transpose, SimpleRNN, LSTM, GRU, GarNet, GarNetStack, MultiHeadAttention
+from hls4ml.model.layers import Layer, Dense, BatchNormalization, LayerNormalization, Embedding, Conv1D, Conv2D, Conv2DBatchnorm, SeparableConv1D, SeparableConv2D, DepthwiseConv2D, Conv1DTranspose, Conv2DTranspose, Activation, ParametrizedActivation, PReLU, Softmax, Pooling1D, Pooling2D, GlobalPooling1D, GlobalPooling2D, ZeroPadding1D, ZeroPadding2D, Merge, Concatenate, Dot, Resize, Transpose, SimpleRNN, LSTM, GRU, GarNet, GarNetStack, MultiHeadAttention
 from hls4ml.model.attributes import Attribute
 from hls4ml.model.optimizer import get_backend_passes, layer_optimizer, model_optimizer
 from hls4ml.model.flow import register_flow
@@ -16,6 +16,8 @@ from hls4ml.backends.fpga.fpga_types import APTypeConverter, HLSTypeConverter, V
 from hls4ml.report import parse_vivado_report
 
 class VivadoBackend(FPGABackend):
+    lut_mult_max_width = 4
+
     def __init__(self):
         super(VivadoBackend, self).__init__('Vivado')
         self._register_layer_attributes()
@@ -34,11 +36,13 @@ class VivadoBackend(FPGABackend):
         init_flow = register_flow('init_layers', initializers, requires=['optimize'], backend=self.name)
 
         streaming_passes = [
+            'vivado:incremental_inference',
             'vivado:reshape_stream',
             'vivado:clone_output',
             'vivado:insert_zero_padding_before_conv1d',
             'vivado:insert_zero_padding_before_conv2d',
             'vivado:broadcast_stream',
+            'vivado:split_softmax_stream',
         ]
         streaming_flow = register_flow('streaming', streaming_passes, requires=[init_flow], backend=self.name)
 
@@ -46,12 +50,15 @@ class VivadoBackend(FPGABackend):
             'vivado:merge_batch_norm_quantized_tanh',
             'vivado:quantize_dense_output',
             'fuse_consecutive_batch_normalization',
+            'vivado:fuse_requantization',
         ]
         quantization_flow = register_flow('quantization', quantization_passes, requires=[init_flow], backend=self.name)
 
         optimization_passes = [
             'vivado:remove_final_reshape',
             'vivado:optimize_pointwise_conv',
+            'vivado:codebook_weights',
+            'vivado:replace_softmax_with_top_k',
         ]
         optimization_flow = register_flow('optimize', optimization_passes, requires=[init_flow], backend=self.name)
 
@@ -61,6 +68,7 @@ class VivadoBackend(FPGABackend):
             'vivado:generate_conv_streaming_instructions',
             'vivado:apply_resource_strategy',
             'vivado:generate_conv_im2col',
+            'vivado:generate_dense_shift_add',
         ]
         vivado_types_flow = register_flow('specific_types', vivado_types, requires=[init_flow], backend=self.name)
 
@@ -131,6 +139,36 @@ class VivadoBackend(FPGABackend):
             print('WARNING: Cannot use "Latency" model strategy for {} layer. Switching to "Resource" strategy.')
             layer.model.config.model_strategy = 'Resource'
 
+    def _init_skip_zeros(self, layer, n_in, pointwise=True):
+        skip_zeros = layer.model.config.get_layer_config_value(layer, 'SkipZeros', False)
+        if skip_zeros and not pointwise:
+            print('WARNING: SkipZeros in layer "{}" requires a 1x1 kernel, ignoring it.'.format(layer.name))
+            skip_zeros = False
+        if skip_zeros and (layer.model.config.get_config_value('IOType') != 'io_stream' or layer.get_attr('strategy') != 'resource'):
+            print('WARNING: SkipZeros in layer "{}" requires "io_stream" and "Resource" strategy, ignoring it.'.format(layer.name))
+            skip_zeros = False
+        layer.set_attr('skip_zeros', skip_zeros)
+        if skip_zeros:
+            # Each lane multiplies the inputs i_in = j * n_lanes + k, at most reuse_factor of them
+            min_lanes = -(-n_in // layer.get_attr('reuse_factor'))
+            n_lanes = next(n for n in range(min_lanes, n_in + 1) if n_in % n == 0)
+            layer.set_attr('skip_zeros_lanes', n_lanes)
+
+    def _init_contexts(self, layer):
+        n_contexts = int(layer.model.config.get_layer_config_value(layer, 'Contexts', 1))
+        if n_contexts < 1:
+            raise Exception('Invalid number of contexts of layer "{}": {}'.format(layer.name, n_contexts))
+        layer.set_attr('n_contexts', n_contexts)
+
+    def product_type(self, data_T, weight_T):
+        '''
+        Products of two narrow operands are tabulated in a truth table (lut_mult) instead of using a multiplier
+        '''
+        product = super().product_type(data_T, weight_T)
+        if product == 'mult' and all(isinstance(t, (IntegerPrecisionType, FixedPrecisionType)) and t.width <= self.lut_mult_max_width for t in [data_T, weight_T]):
+            product = 'lut_mult'
+        return product
+
     @layer_optimizer(Layer)
     def init_base_layer(self, layer):
         reuse_factor = layer.model.config.get_reuse_factor(layer)
@@ -155,6 +193,7 @@ class VivadoBackend(FPGABackend):
         else:
             layer.set_attr('strategy', 'latency')
         layer.set_attr('index_t', NamedType('layer{}_index'.format(layer.index), index_t))
+        self._init_skip_zeros(layer, layer.get_attr('n_in'))
 
     #TODO consolidate these functions into a single `init_conv`
     @layer_optimizer(Conv1D)
@@ -183,6 +222,10 @@ class VivadoBackend(FPGABackend):
 
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
 
+        # Only the 1x1 kernels (pointwise convolutions) multiply a single pixel at a time
+        pointwise = layer.get_attr('filt_height', 1) == 1 and layer.get_attr('filt_width') == 1
+        self._init_skip_zeros(layer, layer.get_attr('n_chan'), pointwise)
+
         self._validate_conv_strategy(layer)
 
     @layer_optimizer(SeparableConv1D)
@@ -196,6 +239,7 @@ class VivadoBackend(FPGABackend):
         
         layer.set_attr('n_partitions', 1) #TODO Once we have SeparableConv implementation for io_parallel this should be set properly
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
+        self._init_skip_zeros(layer, layer.get_attr('n_chan'))
 
     @layer_optimizer(Conv2D)
     def init_conv2d(self, layer):
@@ -224,8 +268,29 @@ class VivadoBackend(FPGABackend):
 
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
 
+        # Only the 1x1 kernels (pointwise convolutions) multiply a single pixel at a time
+        pointwise = layer.get_attr('filt_height', 1) == 1 and layer.get_attr('filt_width') == 1
+        self._init_skip_zeros(layer, layer.get_attr('n_chan'), pointwise)
+
         self._validate_conv_strategy(layer)
 
+    @layer_optimizer(Conv1DTranspose)
+    def init_conv1d_transpose(self, layer):
+        self._init_conv_transpose(layer)
+
+    @layer_optimizer(Conv2DTranspose)
+    def init_conv2d_transpose(self, layer):
+        self._init_conv_transpose(layer)
+
+    def _init_conv_transpose(self, layer):
+        if layer.model.config.is_resource_strategy(layer):
+            layer.set_attr('strategy', 'resource')
+            self.set_target_reuse_factor(layer)
+            n_in, n_out = self.get_layer_mult_size(layer)
+            self.set_closest_reuse_factor(layer, n_in, n_out)
+        else:
+            layer.set_attr('strategy', 'latency')
+
     @layer_optimizer(SeparableConv2D)
     def init_sepconv2d(self, layer):
         if layer.model.config.is_resource_strategy(layer):
@@ -237,6 +302,7 @@ class VivadoBackend(FPGABackend):
         
         layer.set_attr('n_partitions', 1) #TODO Once we have SeparableConv implementation for io_parallel this should be set properly
         layer.set_attr('implementation', layer.model.config.get_conv_implementation(layer).lower())
+        self._init_skip_zeros(layer, layer.get_attr('n_chan'))
 
     @layer_optimizer(DepthwiseConv2D)
     def init_depconv2d(self, layer):
@@ -281,6 +347,8 @@ class VivadoBackend(FPGABackend):
         if layer.model.config.get_config_value('IOType') == 'io_parallel':
             assert len(layer.get_input_variable().shape) == 1, 'Softmax with io_parallel strategy cannot be used on multidimensional tensors.'
 
+        layer.set_attr('n_slice', layer.get_input_variable().shape[-1])
+
     @layer_optimizer(LayerNormalization)
     def init_layernormalization(self, layer):
         if 'table_t' not in layer.attributes:
@@ -319,6 +387,7 @@ class VivadoBackend(FPGABackend):
             layer.set_attr('strategy', 'latency')
 
         layer.set_attr('index_t', index_t)
+        self._init_contexts(layer)
 
     @layer_optimizer(GRU)
     def init_gru(self, layer):
@@ -342,6 +411,7 @@ class VivadoBackend(FPGABackend):
             layer.set_attr('strategy', 'latency')
 
         layer.set_attr('index_t', index_t)
+        self._init_contexts(layer)
 
     @layer_optimizer(GarNet)
     def init_garnet(self, layer):
@@ -19,6 +19,13 @@ def parse_conv1d_layer(keras_layer, input_names, input_shapes, data_reader, conf
     layer['stride_width'] = keras_layer['config']['strides'][0]
     layer['padding'] = keras_layer['config']['padding']
 
+    dilation = keras_layer['config'].get('dilation_rate', [1])[0]
+    if dilation != 1:
+        if keras_layer['class_name'] != 'Conv1D':
+            raise Exception('ERROR: dilation_rate of {} is not supported'.format(keras_layer['class_name']))
+        layer['dilation'] = dilation
+
+    # Padding and output size follow from the span of the (dilated) kernel
     (
         layer['out_width'],
         layer['pad_left'],
@@ -27,7 +34,7 @@ def parse_conv1d_layer(keras_layer, input_names, input_shapes, data_reader, conf
         layer['padding'],
         layer['in_width'],
         layer['stride_width'],
-        layer['filt_width']
+        dilation * (layer['filt_width'] - 1) + 1
     )
 
     if layer['data_format'] == 'channels_last':
@@ -59,7 +66,15 @@ def parse_conv2d_layer(keras_layer, input_names, input_shapes, data_reader, conf
     layer['stride_height'] = keras_layer['config']['strides'][0]
     layer['stride_width'] = keras_layer['config']['strides'][1]
     layer['padding'] = keras_layer['config']['padding']
-    
+
+    dilation_height, dilation_width = keras_layer['config'].get('dilation_rate', (1, 1))
+    if (dilation_height, dilation_width) != (1, 1):
+        if keras_layer['class_name'] != 'Conv2D':
+            raise Exception('ERROR: dilation_rate of {} is not supported'.format(keras_layer['class_name']))
+        layer['dilation_height'] = dilation_height
+        layer['dilation_width'] = dilation_width
+
+    # Padding and output size follow from the span of the (dilated) kernel
     (
         layer['out_height'],
         layer['out_width'],
@@ -73,8 +88,8 @@ def parse_conv2d_layer(keras_layer, input_names, input_shapes, data_reader, conf
         layer['in_width'],
         layer['stride_height'],
         layer['stride_width'],
-        layer['filt_height'],
-        layer['filt_width']
+        dilation_height * (layer['filt_height'] - 1) + 1,
+        dilation_width * (layer['filt_width'] - 1) + 1
     )
 
     if layer['data_format'] == 'channels_first':
@@ -83,3 +98,77 @@ def parse_conv2d_layer(keras_layer, input_names, input_shapes, data_reader, conf
         output_shape = [input_shapes[0][0], layer['out_height'], layer['out_width'], layer['n_filt']]
 
     return layer, output_shape
+
+
+def compute_transpose_output_1d(padding, in_width, stride, filt_width):
+    # Output size of Keras' transposed convolution and the number of outputs cropped on the left
+    if padding.lower() == 'same':
+        out_width = in_width * stride
+        crop_left = max(filt_width - stride, 0) // 2
+    elif padding.lower() == 'valid':
+        out_width = in_width * stride + max(filt_width - stride, 0)
+        crop_left = 0
+    else:
+        raise Exception('Unknown padding type: {}'.format(padding))
+
+    return out_width, crop_left
+
+
+@keras_handler('Conv1DTranspose')
+def parse_conv1d_transpose_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert('Conv1DTranspose' in keras_layer['class_name'])
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+
+    (
+        layer['in_width'],
+        layer['n_chan']
+    ) = parse_data_format(input_shapes[0], layer['data_format'])
+
+    if keras_layer['config'].get('output_padding') is not None:
+        raise Exception('ERROR: output_padding of Conv1DTranspose is not supported')
+    if keras_layer['config'].get('dilation_rate', [1])[0] != 1:
+        raise Exception('ERROR: dilation_rate of Conv1DTranspose is not supported')
+
+    layer['n_filt'] = keras_layer['config']['filters']
+    layer['filt_width'] = keras_layer['config']['kernel_size'][0]
+    layer['stride_width'] = keras_layer['config']['strides'][0]
+    layer['padding'] = keras_layer['config']['padding']
+
+    layer['out_width'], layer['crop_left'] = compute_transpose_output_1d(layer['padding'], layer['in_width'], layer['stride_width'], layer['filt_width'])
+
+    output_shape = [input_shapes[0][0], layer['out_width'], layer['n_filt']]
+
+    return layer, output_shape
+
+
+@keras_handler('Conv2DTranspose')
+def parse_conv2d_transpose_layer(keras_layer, input_names, input_shapes, data_reader, config):
+    assert('Conv2DTranspose' in keras_layer['class_name'])
+
+    layer = parse_default_keras_layer(keras_layer, input_names)
+
+    (
+        layer['in_height'],
+        layer['in_width'],
+        layer['n_chan']
+    ) = parse_data_format(input_shapes[0], layer['data_format'])
+
+    if keras_layer['config'].get('output_padding') is not None:
+        raise Exception('ERROR: output_padding of Conv2DTranspose is not supported')
+    if tuple(keras_layer['config'].get('dilation_rate', (1, 1))) != (1, 1):
+        raise Exception('ERROR: dilation_rate of Conv2DTranspose is not supported')
+
+    layer['n_filt'] = keras_layer['config']['filters']
+    layer['filt_height'] = keras_layer['config']['kernel_size'][0]
+    layer['filt_width'] = keras_layer['config']['kernel_size'][1]
+    layer['stride_height'] = keras_layer['config']['strides'][0]
+    layer['stride_width'] = keras_layer['config']['strides'][1]
+    layer['padding'] = keras_layer['config']['padding']
+
+    layer['out_height'], layer['crop_top'] = compute_transpose_output_1d(layer['padding'], layer['in_height'], layer['stride_height'], layer['filt_height'])
+    layer['out_width'], layer['crop_left'] = compute_transpose_output_1d(layer['padding'], layer['in_width'], layer['stride_width'], layer['filt_width'])
+
+    output_shape = [input_shapes[0][0], layer['out_height'], layer['out_width'], layer['n_filt']]
+
+    return layer, output_shape
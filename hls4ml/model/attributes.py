@@ -62,8 +62,12 @@ class AttributeDict(MutableMapping):
 
     def __setitem__(self, key, value):
         if isinstance(value, (TensorVariable, InplaceVariable)):
-            self.layer.model.register_output_variable(key, value)
-            self.attributes['result_t'] = value.type
+            primary = key == self.layer.outputs[0]
+            self.layer.model.register_output_variable(key, value, primary=primary)
+            if primary:
+                self.attributes['result_t'] = value.type
+            else:
+                self.attributes[key + '_t'] = value.type
             if key in self._expected_attributes and key in self.layer.outputs:
                 key = 'out_' + key
         elif isinstance(value, WeightVariable):
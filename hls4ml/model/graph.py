@@ -1,5 +1,6 @@
 from __future__ import print_function
 import os
+import copy
 import platform
 import ctypes
 import numpy as np
@@ -41,7 +42,10 @@ class HLSConfig(object):
         self.layer_type_compression = {}
         self.layer_name_compression = {}
 
+        self.model_incremental_step = None
+
         self.trace_output = self.get_config_value('TraceOutput', False)
+        self.timing_model = self.get_config_value('TimingModel', False)
 
         self._parse_hls_config()
         self._validate_hls_config()
@@ -206,6 +210,7 @@ class HLSConfig(object):
             self.model_conv_implementation = model_cfg.get('ConvImplementation', 'LineBuffer')
             self.model_strategy = model_cfg.get('Strategy', 'Latency')
             self.model_compression = bool(model_cfg.get('Compression', 0))
+            self.model_incremental_step = model_cfg.get('IncrementalStep')
 
         layer_type_cfg = hls_config.get('LayerType')
         if layer_type_cfg is not None:
@@ -301,6 +306,11 @@ class ModelGraph(object):
         self.config = HLSConfig(config)
         self.reader = data_reader
 
+        # The original description of the model is kept, so the model can be converted again with different weights (see set_weights)
+        self._layer_list = copy.deepcopy(layer_list)
+        self._model_inputs = copy.copy(inputs)
+        self._model_outputs = copy.copy(outputs)
+
         self._applied_flows = []
 
         # If not provided, assumes layer_list[0] is input, and layer_list[-1] is output
@@ -419,7 +429,7 @@ class ModelGraph(object):
         node = layer_cls(self, name, attributes, inputs, outputs)
         for o in node.outputs:
             out_var = node.get_output_variable(output_name=o)
-            if o in self.outputs:
+            if o in self.outputs and o == node.outputs[0]:
                 out_var.type.name = 'result_t'
             self.output_vars[o] = out_var
         return node
@@ -553,8 +563,9 @@ class ModelGraph(object):
             variables.append(self.graph[inp].get_output_variable())
         return variables
 
-    def register_output_variable(self, out_name, variable):
-        if out_name in self.outputs:
+    def register_output_variable(self, out_name, variable, primary=True):
+        # Only the main output of a layer is renamed, the other outputs (e.g., the scores of TopK) may have a different precision
+        if out_name in self.outputs and primary:
             variable.type.name = 'result_t'
         self.output_vars[out_name] = variable
 
@@ -654,8 +665,23 @@ class ModelGraph(object):
 
         return int(n_sample)
 
+    def _get_batch_function(self, ctype):
+        # Batched entry point, processing all samples in a single call; only provided by some backends
+        suffix = '_batch_float' if ctype == ctypes.c_float else '_batch_double'
+        try:
+            batch_function = getattr(self._top_function_lib, self.config.get_project_name() + suffix)
+        except AttributeError:
+            return None
+
+        n_args = len(self.get_input_variables()) + len(self.get_output_variables())
+        batch_function.restype = None
+        batch_function.argtypes = [npc.ndpointer(ctype, flags="C_CONTIGUOUS") for i in range(n_args)] + [ctypes.c_uint]
+
+        return batch_function
+
     def predict(self, x):
         top_function, ctype = self._get_top_function(x)
+        batch_function = self._get_batch_function(ctype)
         n_samples = self._compute_n_samples(x)
         n_inputs = len(self.get_input_variables())
         n_outputs = len(self.get_output_variables())
@@ -668,21 +694,30 @@ class ModelGraph(object):
             x = [x]
 
         try:
-            for i in range(n_samples):
-                predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.get_output_variables()]
+            if batch_function is not None:
+                # Inputs and outputs of all samples are passed as contiguous arrays
                 if n_inputs == 1:
-                    inp = [np.asarray(x[i])]
+                    inp = [np.ascontiguousarray(x, dtype=ctype).reshape(-1)]
                 else:
-                    inp = [np.asarray(xj[i]) for xj in x]
-                argtuple = inp
-                argtuple += predictions
-                argtuple = tuple(argtuple)
-                top_function(*argtuple)
-                output.append(predictions)
-
-
-            # Convert to list of numpy arrays (one for each output)
-            output = [np.asarray([output[i_sample][i_output] for i_sample in range(n_samples)]) for i_output in range(n_outputs)]
+                    inp = [np.ascontiguousarray(xj, dtype=ctype).reshape(-1) for xj in x]
+                output = [np.zeros((n_samples, yj.size()), dtype=ctype) for yj in self.get_output_variables()]
+                argtuple = tuple(inp + output + [n_samples])
+                batch_function(*argtuple)
+            else:
+                for i in range(n_samples):
+                    predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.get_output_variables()]
+                    if n_inputs == 1:
+                        inp = [np.asarray(x[i])]
+                    else:
+                        inp = [np.asarray(xj[i]) for xj in x]
+                    argtuple = inp
+                    argtuple += predictions
+                    argtuple = tuple(argtuple)
+                    top_function(*argtuple)
+                    output.append(predictions)
+
+                # Convert to list of numpy arrays (one for each output)
+                output = [np.asarray([output[i_sample][i_output] for i_sample in range(n_samples)]) for i_output in range(n_outputs)]
         finally:
             os.chdir(curr_dir)
             
@@ -695,6 +730,126 @@ class ModelGraph(object):
         else:
             return output
 
+    @staticmethod
+    def _get_layer_code(layer):
+        # Everything that determines the code generated for a layer, apart from the values of its weights
+        code = [layer.class_name, layer.index, layer.get_attr('function_cpp', None), layer.get_attr('config_cpp', None)]
+        code += [str(source) for source in layer.code.values()]
+        code += [(t.name, str(t.precision)) for t in layer.types.values()]
+        code += [(var.name, var.type.name, str(var.type.precision), var.shape) for var in layer.get_variables()]
+        code += [(k, w.name, w.weight_class, w.type.name, str(w.type.precision), w.data_length) for k, w in layer.weights.items()]
+        return code
+
+    def set_weights(self, weights):
+        """Replace the weights of the compiled model, without recompiling it.
+
+        The model is converted again with the new weights, which are then copied into the compiled library. This is only
+        possible if the generated code doesn't depend on the values of the weights. For example, compression, codebooks
+        and shift-add code generation ('ShiftAdd') depend on the values, as does the precision if it is inferred from them.
+
+        Args:
+            weights (dict or object): The new weights, either as a dictionary {layer_name: {var_name: array}}, with the
+                names used by the converter (e.g., 'kernel' and 'bias' for Keras), or as an object with a
+                `get_weights_data(layer_name, var_name)` method, such as the reader used by the converter. Weights not
+                present in the dictionary keep their current values.
+
+        Raises:
+            Exception: If the model is not compiled, the backend doesn't support replacing the weights, or the code
+                generated for a layer depends on the values of its weights.
+        """
+        if self._top_function_lib is None:
+            raise Exception('Model not compiled')
+        try:
+            set_weights_func = self._top_function_lib.set_weights
+        except AttributeError:
+            raise Exception('Replacing the weights without recompiling is not supported by the {} backend'.format(self.config.backend.name))
+        set_weights_func.argtypes = [ctypes.c_uint, ctypes.c_void_p, ctypes.c_size_t]
+        set_weights_func.restype = ctypes.c_int
+
+        if isinstance(weights, dict):
+            original_reader = self.reader
+            class WeightsReader(object):
+                def get_weights_data(self, layer_name, var_name):
+                    if var_name in weights.get(layer_name, {}):
+                        return weights[layer_name][var_name]
+                    return original_reader.get_weights_data(layer_name, var_name)
+            reader = WeightsReader()
+        else:
+            reader = weights
+
+        new_model = ModelGraph(self.config.config, reader, copy.deepcopy(self._layer_list), copy.copy(self._model_inputs), copy.copy(self._model_outputs))
+        if list(self.graph.keys()) != list(new_model.graph.keys()):
+            raise Exception('The model has a different structure with the new weights, it has to be recompiled')
+
+        updated_layers = []
+        for layer in self.get_layers():
+            new_layer = new_model.graph[layer.name]
+            if self._get_layer_code(layer) != self._get_layer_code(new_layer):
+                raise Exception('The code generated for layer "{}" depends on the values of its weights, the model has to be recompiled'.format(layer.name))
+            if any(not np.array_equal(w.data, new_layer.weights[k].data) for k, w in layer.weights.items()):
+                updated_layers.append((layer, new_layer))
+
+        curr_dir = os.getcwd()
+        os.chdir(self.config.get_output_dir() + '/firmware')
+
+        try:
+            for layer, new_layer in updated_layers:
+                # All weights of the layer are passed in a single buffer, in the order in which they are defined
+                data = np.concatenate([np.asarray(new_layer.weights[k].data, dtype=np.float64).reshape(-1) for k in layer.weights.keys()])
+                data = np.ascontiguousarray(data)
+                if set_weights_func(layer.index, data.ctypes.data, data.itemsize) != 0:
+                    raise Exception('Weights of layer "{}" cannot be replaced, the model has to be recompiled'.format(layer.name))
+                for k in list(layer.weights.keys()):
+                    layer.weights[k] = new_layer.weights[k]
+        finally:
+            os.chdir(curr_dir)
+
+        self.reader = reader
+
+    def reset_state(self):
+        """Clears the state kept between calls of a model converted for incremental inference ('IncrementalStep'),
+        i.e., the input windows of the convolution and pooling layers and the state of the recurrent layers, and the
+        state of all contexts of the recurrent layers with several contexts ('Contexts'). The next call of `predict`
+        starts a new time series. This is the C simulation counterpart of the reset of the synthesized design, which
+        clears the state since the generated project sets `config_rtl -reset state`.
+
+        Raises:
+            Exception: If the model is not compiled or the backend doesn't support incremental inference.
+        """
+        if self._top_function_lib is None:
+            raise Exception('Model not compiled')
+        try:
+            reset_func = self._top_function_lib.reset_incremental_state
+        except AttributeError:
+            raise Exception('Incremental inference is not supported by the {} backend'.format(self.config.backend.name))
+        reset_func.argtypes = []
+        reset_func.restype = None
+        reset_func()
+
+    def set_context(self, context):
+        """Selects the context of the recurrent layers with several contexts ('Contexts'), i.e., the independent stream
+        whose state is used and updated by the next calls of `predict`. The context is the 'context' argument of the
+        top level function.
+
+        Args:
+            context (int): The context, from 0 to the number of contexts - 1.
+
+        Raises:
+            Exception: If the model is not compiled, has no layers with several contexts or the context is out of range.
+        """
+        layer_contexts = [layer.get_attr('n_contexts', 1) for layer in self.get_layers() if layer.get_attr('n_contexts', 1) > 1]
+        if len(layer_contexts) == 0:
+            raise Exception('The model has no layers with several contexts')
+        n_contexts = min(layer_contexts)
+        if not 0 <= context < n_contexts:
+            raise Exception('Invalid context {}, the model has {} contexts'.format(context, n_contexts))
+        if self._top_function_lib is None:
+            raise Exception('Model not compiled')
+        set_context_func = self._top_function_lib.set_recurrent_context
+        set_context_func.argtypes = [ctypes.c_uint]
+        set_context_func.restype = None
+        set_context_func(context)
+
     def trace(self, x):
         print('Recompiling {} with tracing'.format(self.config.get_project_name()))
         self.config.trace_output = True
@@ -778,6 +933,131 @@ class ModelGraph(object):
         else:
             return output, trace_output
 
+    def estimate_timing(self, x, max_passes=None):
+        """Estimate the latency, initiation interval and FIFO stalls of an io_stream design from C simulation.
+
+        The model is recompiled with a cycle-approximate timing model of the dataflow design (see `hls::timing` in
+        `hls_stream.h`): each layer starts an iteration every `reuse_factor` cycles (1 for layers without weights), produces its
+        outputs after the depth of its pipeline and waits for its inputs and for free space in its output FIFOs, using the FIFO
+        depths of the design. The estimates are meant to compare configurations (e.g., reuse factors and FIFO depths) before
+        synthesis, they are not cycle accurate.
+
+        Args:
+            x (ndarray or list of ndarray): Input samples; the report is the worst case over all samples.
+            max_passes (int, optional): Largest number of simulations of a sample used to resolve the stalls on full FIFOs.
+                Defaults to the number of layers plus one.
+
+        Returns:
+            dict: Latency and interval of the design in cycles, the start, interval and end of each layer ('layers') and the
+                depth, largest occupancy and stall cycles of each FIFO ('fifos'). Stalls on full FIFOs ('full_stalls') are cycles
+                spent by the producer waiting for free space, stalls on empty FIFOs ('empty_stalls') are cycles spent by the
+                consumer waiting for data.
+        """
+        if self.config.get_config_value('IOType') != 'io_stream':
+            raise Exception('The timing model is only available for io_stream designs')
+
+        if not self.config.timing_model:
+            print('Recompiling {} with the timing model'.format(self.config.get_project_name()))
+            self.config.timing_model = True
+            self.compile()
+
+        try:
+            enable_func = self._top_function_lib.enable_timing_model
+        except AttributeError:
+            raise Exception('The timing model is not supported by the {} backend'.format(self.config.backend.name))
+
+        top_function, ctype = self._get_top_function(x)
+        n_samples = self._compute_n_samples(x)
+        n_inputs = len(self.get_input_variables())
+        if max_passes is None:
+            max_passes = len(self.get_layers()) + 1
+
+        class TimingProcessData(ctypes.Structure):
+            _fields_ = [('name', ctypes.c_char_p),
+                        ('start', ctypes.c_ulonglong),
+                        ('interval', ctypes.c_ulonglong),
+                        ('end', ctypes.c_ulonglong)]
+
+        class TimingFifoData(ctypes.Structure):
+            _fields_ = [('name', ctypes.c_char_p),
+                        ('depth', ctypes.c_ulonglong),
+                        ('max_occupancy', ctypes.c_ulonglong),
+                        ('full_stalls', ctypes.c_ulonglong),
+                        ('empty_stalls', ctypes.c_ulonglong)]
+
+        enable_func.argtypes = None
+        enable_func.restype = None
+
+        disable_func = self._top_function_lib.disable_timing_model
+        disable_func.argtypes = None
+        disable_func.restype = None
+
+        begin_pass_func = self._top_function_lib.begin_timing_pass
+        begin_pass_func.argtypes = None
+        begin_pass_func.restype = None
+
+        end_pass_func = self._top_function_lib.end_timing_pass
+        end_pass_func.argtypes = None
+        end_pass_func.restype = ctypes.c_int
+
+        latency_func = self._top_function_lib.get_timing_latency
+        latency_func.argtypes = [ctypes.POINTER(ctypes.c_size_t), ctypes.POINTER(ctypes.c_size_t)]
+        latency_func.restype = ctypes.c_ulonglong
+
+        collect_func = self._top_function_lib.collect_timing
+        collect_func.argtypes = [ctypes.POINTER(TimingProcessData), ctypes.POINTER(TimingFifoData)]
+        collect_func.restype = None
+
+        curr_dir = os.getcwd()
+        os.chdir(self.config.get_output_dir() + '/firmware')
+
+        if n_samples == 1 and n_inputs == 1:
+            x = [x]
+
+        report = {'latency': 0, 'interval': 0, 'layers': {}, 'fifos': {}}
+        try:
+            enable_func()
+
+            for i in range(n_samples):
+                predictions = [np.zeros(yj.size(), dtype=ctype) for yj in self.get_output_variables()]
+                if n_inputs == 1:
+                    inp = [np.asarray(x[i])]
+                else:
+                    inp = [np.asarray(xj[i]) for xj in x]
+                argtuple = tuple(inp + predictions)
+
+                # Each pass uses the read cycles of the previous one to find the stalls on full FIFOs
+                for _ in range(max_passes):
+                    begin_pass_func()
+                    top_function(*argtuple)
+                    if end_pass_func():
+                        break
+                else:
+                    print('WARNING: The timing of {} did not converge after {} passes'.format(self.config.get_project_name(), max_passes))
+
+                n_processes = ctypes.c_size_t()
+                n_fifos = ctypes.c_size_t()
+                latency = latency_func(ctypes.byref(n_processes), ctypes.byref(n_fifos))
+                processes = (TimingProcessData * n_processes.value)()
+                fifos = (TimingFifoData * n_fifos.value)()
+                collect_func(processes, fifos)
+
+                report['latency'] = max(report['latency'], latency)
+                for process in processes:
+                    layer_report = report['layers'].setdefault(str(process.name, 'utf-8'), {'start': 0, 'interval': 0, 'end': 0})
+                    for key in layer_report.keys():
+                        layer_report[key] = max(layer_report[key], getattr(process, key))
+                    report['interval'] = max(report['interval'], process.interval)
+                for fifo in fifos:
+                    fifo_report = report['fifos'].setdefault(str(fifo.name, 'utf-8'), {'depth': fifo.depth, 'max_occupancy': 0, 'full_stalls': 0, 'empty_stalls': 0})
+                    for key in ['max_occupancy', 'full_stalls', 'empty_stalls']:
+                        fifo_report[key] = max(fifo_report[key], getattr(fifo, key))
+        finally:
+            disable_func()
+            os.chdir(curr_dir)
+
+        return report
+
     def build(self, **kwargs):
         """ Builds the generated project using HLS compiler.
 
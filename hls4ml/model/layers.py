@@ -532,6 +532,111 @@ class DepthwiseConv2D(Conv2D):
 
         self.add_bias(quantizer=self.get_attr('bias_quantizer'))
 
+def subpixel_kernel(kernel, strides):
+    """Decomposes the kernel of a transposed convolution, (filt_height, filt_width, n_filt, n_chan) as in Keras,
+    into the dense sub-kernels of the stride phases, (sub_filt_height, sub_filt_width, n_chan, n_phases * n_filt).
+
+    Phase (ph, pw) computes the outputs at q * stride + phase from the inputs q - j, with kernel tap phase + j * stride.
+    The taps are stored in the order of the input window (oldest input first), taps past the end of the kernel are zero.
+    """
+    filt_height, filt_width, n_filt, n_chan = kernel.shape
+    stride_height, stride_width = strides
+    sub_height = -(-filt_height // stride_height)
+    sub_width = -(-filt_width // stride_width)
+    sub = np.zeros((sub_height, sub_width, n_chan, stride_height, stride_width, n_filt), dtype=kernel.dtype)
+    for mh in range(sub_height):
+        for ph in range(stride_height):
+            th = ph + (sub_height - 1 - mh) * stride_height
+            if th >= filt_height:
+                continue
+            for mw in range(sub_width):
+                for pw in range(stride_width):
+                    tw = pw + (sub_width - 1 - mw) * stride_width
+                    if tw >= filt_width:
+                        continue
+                    sub[mh, mw, :, ph, pw, :] = kernel[th, tw].T
+    return sub.reshape(sub_height, sub_width, n_chan, stride_height * stride_width * n_filt)
+
+class Conv1DTranspose(Layer):
+    _expected_attributes = [
+        Attribute('in_width'),
+        Attribute('out_width'),
+
+        Attribute('n_chan'),
+        Attribute('n_filt'),
+
+        Attribute('filt_width'),
+        Attribute('stride_width'),
+
+        Attribute('crop_left'),
+
+        WeightAttribute('weight'),
+        WeightAttribute('bias'),
+
+        TypeAttribute('weight'),
+        TypeAttribute('bias'),
+    ]
+
+    def initialize(self):
+        if self.get_attr('data_format') != 'channels_last':
+            raise Exception('ERROR: Conv1DTranspose layer {} only supports channels_last data format'.format(self.name))
+        shape = [self.attributes['out_width'], self.attributes['n_filt']]
+        dims = ['N_OUTPUTS_{}'.format(self.index), 'N_FILT_{}'.format(self.index)]
+        self.add_output_variable(shape, dims)
+
+        stride = self.get_attr('stride_width')
+        self.set_attr('sub_filt_width', -(-self.get_attr('filt_width') // stride))
+        kernel = self.model.get_weights_data(self.name, 'kernel')
+        weight = subpixel_kernel(kernel[np.newaxis], (1, stride))[0]
+        self.add_weights_variable(name='weight', var_name='w{index}', data=weight, quantizer=self.get_attr('weight_quantizer'))
+        bias = self.model.get_weights_data(self.name, 'bias')
+        if bias is None:
+            bias = np.zeros(self.get_attr('n_filt'))
+        self.add_weights_variable(name='bias', var_name='b{index}', data=np.tile(bias, stride), quantizer=self.get_attr('bias_quantizer'))
+
+class Conv2DTranspose(Layer):
+    _expected_attributes = [
+        Attribute('in_height'),
+        Attribute('in_width'),
+
+        Attribute('out_height'),
+        Attribute('out_width'),
+
+        Attribute('n_chan'),
+        Attribute('n_filt'),
+
+        Attribute('filt_height'),
+        Attribute('filt_width'),
+        Attribute('stride_height'),
+        Attribute('stride_width'),
+
+        Attribute('crop_top'),
+        Attribute('crop_left'),
+
+        WeightAttribute('weight'),
+        WeightAttribute('bias'),
+
+        TypeAttribute('weight'),
+        TypeAttribute('bias'),
+    ]
+
+    def initialize(self):
+        if self.get_attr('data_format') != 'channels_last':
+            raise Exception('ERROR: Conv2DTranspose layer {} only supports channels_last data format'.format(self.name))
+        shape = [self.attributes['out_height'], self.attributes['out_width'], self.attributes['n_filt']]
+        dims = ['OUT_HEIGHT_{}'.format(self.index), 'OUT_WIDTH_{}'.format(self.index), 'N_FILT_{}'.format(self.index)]
+        self.add_output_variable(shape, dims)
+
+        strides = (self.get_attr('stride_height'), self.get_attr('stride_width'))
+        self.set_attr('sub_filt_height', -(-self.get_attr('filt_height') // strides[0]))
+        self.set_attr('sub_filt_width', -(-self.get_attr('filt_width') // strides[1]))
+        weight = subpixel_kernel(self.model.get_weights_data(self.name, 'kernel'), strides)
+        self.add_weights_variable(name='weight', var_name='w{index}', data=weight, quantizer=self.get_attr('weight_quantizer'))
+        bias = self.model.get_weights_data(self.name, 'bias')
+        if bias is None:
+            bias = np.zeros(self.get_attr('n_filt'))
+        self.add_weights_variable(name='bias', var_name='b{index}', data=np.tile(bias, strides[0] * strides[1]), quantizer=self.get_attr('bias_quantizer'))
+
 class Pooling1D(Layer):
     _expected_attributes = [
         Attribute('n_in'),
@@ -704,6 +809,31 @@ class Softmax(Activation):
     def initialize(self):
         super(Softmax, self).initialize()
 
+class TopK(Layer):
+    _expected_attributes = [
+        Attribute('n_in'),
+        Attribute('k', default=1),
+        Attribute('output_scores', value_type=bool, default=False),
+    ]
+
+    def initialize(self):
+        inp = self.get_input_variable()
+        if len(inp.shape) > 1:
+            raise Exception('ERROR: TopK layer {} only supports 1D inputs, got shape {}'.format(self.name, inp.shape))
+        n_in = inp.size()
+        k = self.get_attr('k')
+        if k < 1 or k > n_in:
+            raise Exception('ERROR: TopK layer {} selects {} of {} inputs'.format(self.name, k, n_in))
+        self.set_attr('n_in', n_in)
+
+        # The main output holds the indices of the k largest inputs, in decreasing order of their values
+        index_width = max(int(np.ceil(np.log2(n_in))), 1)
+        self.add_output_variable([k], ['N_TOPK_{}'.format(self.index)], precision=IntegerPrecisionType(width=index_width, signed=False))
+        if self.get_attr('output_scores'):
+            if len(self.outputs) < 2:
+                self.outputs.append(self.name + '_scores')
+            self.add_output_variable([k], ['N_TOPK_{}'.format(self.index)], out_name=self.outputs[1], var_name='layer{index}_scores', type_name='layer{index}_scores_t', precision=inp.type.precision)
+
 class TernaryTanh(Activation):
     def initialize(self):
         super(TernaryTanh, self).initialize()
@@ -1247,6 +1377,7 @@ layer_map = {
     'PReLU'                  : PReLU,
     'Softmax'                : Softmax,
     'TernaryTanh'            : TernaryTanh,
+    'TopK'                   : TopK,
     'Reshape'                : Reshape,
     'Dense'                  : Dense,
     'BinaryDense'            : Dense,
@@ -1261,6 +1392,8 @@ layer_map = {
     'SeparableConv1D'        : SeparableConv1D,
     'SeparableConv2D'        : SeparableConv2D,
     'DepthwiseConv2D'        : DepthwiseConv2D,
+    'Conv1DTranspose'        : Conv1DTranspose,
+    'Conv2DTranspose'        : Conv2DTranspose,
     'BatchNormalization'     : BatchNormalization,
     'QBatchNormalization'    : BatchNormalization,
     'LayerNormalization'     : LayerNormalization,
@@ -7,6 +7,8 @@ class FuseBatchNormalization(OptimizerPass):
             isinstance(node.get_input_node(), (Dense, Conv1D, Conv2D)) and \
             node.get_input_node().get_attr('weight_quantizer') is None and \
             node.get_input_node().get_attr('bias_quantizer') is None
+        # In the integer-only mode the scale is applied by the requantization of the layer instead
+        is_match = is_match and not node.model.config.get_layer_config_value(node.get_input_node(), 'IntegerOnly', False)
         return is_match
 
     def transform(self, model, node):
@@ -130,6 +130,13 @@ class ExponentPrecisionType(IntegerPrecisionType):
     def __init__(self, width=16, signed=True):
         super().__init__(width=width, signed=signed)
 
+class CodebookPrecisionType(IntegerPrecisionType):
+    '''
+    Convenience class to differentiate 'regular' integers from indices into a codebook of shared weight values.
+    '''
+    def __init__(self, width=1):
+        super().__init__(width=width, signed=False)
+
 def find_minimum_width(data, signed=True):
     """
     Helper function to find the minimum integer width to express all entries in the data array
@@ -171,6 +178,14 @@ class ExponentType(NamedType):
         super(ExponentType, self).__init__(name, precision, **kwargs)
         self.sign = XnorPrecisionType()
 
+class CodebookType(NamedType):
+    def __init__(self, name, precision, value_precision, codebook, **kwargs):
+        if not name.startswith('codebook_'):
+            name = 'codebook_' + name
+        super(CodebookType, self).__init__(name, precision, **kwargs)
+        self.value_precision = value_precision
+        self.codebook = codebook
+
 class PackedType(NamedType):
     def __init__(self, name, precision, n_elem, n_pack, **kwargs):
         super(PackedType, self).__init__(name, precision, **kwargs)
@@ -351,6 +366,31 @@ class ExponentWeightVariable(WeightVariable):
 
     next = __next__
 
+class CodebookWeightVariable(WeightVariable):
+    def __init__(self, var_name, type_name, precision, data, quantizer=None, **kwargs):
+        super(CodebookWeightVariable, self).__init__(var_name, type_name, precision, data, quantizer, **kwargs)
+        '''
+        WeightVariable for weights sharing a small set of distinct values (e.g., after k-means clustering).
+        The data is stored as indices into the codebook of distinct values, which goes into the type definition.
+        '''
+        codebook, indices = np.unique(data, return_inverse=True)
+        index_width = max(1, int(np.ceil(np.log2(len(codebook)))))
+        self.type = CodebookType(type_name, CodebookPrecisionType(width=index_width), precision, codebook, **kwargs)
+        self.type.value_fmt = self.precision_fmt
+        self.data = np.reshape(indices, data.shape)
+        self.precision_fmt = '%d'
+
+    def update_precision(self, new_precision):
+        if isinstance(self.type, CodebookType):
+            self.type.value_precision = new_precision
+        else:
+            super().update_precision(new_precision)
+
+    def __next__(self):
+        return '{%s}' % super().__next__()
+
+    next = __next__
+
 class Source(object):
     def __init__(self, code):
         self.code = code
@@ -0,0 +1,34 @@
+#!/bin/bash
+# Sourced by build_lib.sh of every backend, after CC, CFLAGS and INCFLAGS are set
+# Sets CACHE_ROOT, HASH and CC_VERSION (also used by the object cache of build_lib.sh) and adds the precompiled header to CFLAGS
+
+CACHE_ROOT=${HLS4ML_CACHE_DIR:-${XDG_CACHE_HOME:-$HOME/.cache}/hls4ml}
+if command -v sha1sum >/dev/null 2>&1; then
+    HASH="sha1sum"
+else
+    HASH="shasum -a 1"
+fi
+CC_VERSION=$(${CC} --version | head -n 1)
+
+# Headers that do not depend on the model (nnet_utils/nnet_precompiled.h) are precompiled and included before every translation unit
+# The precompiled header is cached and shared by all projects, keyed by the compiler version, flags and the preprocessed header
+PCH_HEADER=firmware/nnet_utils/nnet_precompiled.h
+PCH_DIR=${CACHE_ROOT}/pch
+rm -f ${PCH_HEADER}.gch
+if mkdir -p "${PCH_DIR}" 2>/dev/null; then
+    PCH_DIR=$(cd "${PCH_DIR}" && pwd)
+    PCH_KEY=$( { echo "${CC_VERSION} ${CFLAGS} ${INCFLAGS}"; ${CC} ${CFLAGS} ${INCFLAGS} -x c++-header -E -P ${PCH_HEADER}; } | ${HASH} | cut -d ' ' -f 1 )
+    PCH=${PCH_DIR}/${PCH_KEY}.gch
+    if [ ! -f ${PCH} ]; then
+        ${CC} ${CFLAGS} ${INCFLAGS} -x c++-header ${PCH_HEADER} -o ${PCH}.$$ && mv -f ${PCH}.$$ ${PCH}
+        rm -f ${PCH}.$$
+    fi
+    if [ -f ${PCH} ]; then
+        touch ${PCH}
+        ln -s ${PCH} ${PCH_HEADER}.gch
+    fi
+    # Precompiled headers that have not been used for 30 days are removed from the cache
+    find ${PCH_DIR} -name '*.gch' -mtime +30 -delete 2>/dev/null
+fi
+# If the header could not be precompiled, it is included as is
+CFLAGS="${CFLAGS} -include ${PCH_HEADER}"
@@ -0,0 +1,1223 @@
+#ifndef AC_FAST_H
+#define AC_FAST_H
+
+/*
+* Host-side emulation of ac_int and ac_fixed, used during GCC compilation / hls4ml model.predict(...)
+* The reference headers (ac_int.h, ac_fixed.h) store every number as a vector of 32-bit words
+* and implement all arithmetic through generic multi-word routines, which dominates the run-time of the C simulation
+* Here, a number of width W is stored in a single native integer (64-bit for W <= 64, 128-bit up to W = 128),
+* sign-extended for signed and zero-extended for unsigned types, so arithmetic compiles to a handful of instructions
+* Result types, quantization and overflow modes, conversions and bit-level access follow the reference headers bit-exactly
+* Wider types are rejected at compile-time; compile without HLS4ML_FAST_AC_TYPES to use the reference headers instead
+* Only the API used by hls4ml is provided; it cannot be used for HLS synthesis
+*/
+
+#if defined(__AC_INT_H) || defined(__AC_FIXED_H)
+#error "ac_fast.h cannot be combined with the reference ac_int.h / ac_fixed.h"
+#endif
+
+// Turn any later inclusion of the reference headers into a no-op
+#define __AC_INT_H
+#define __AC_FIXED_H
+
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+
+#ifndef AC_MAX
+#define AC_MAX(a,b) ((a) > (b) ? (a) : (b))
+#endif
+#ifndef AC_MIN
+#define AC_MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+typedef unsigned long long Ulong;
+typedef signed long long Slong;
+
+enum ac_base_mode { AC_BIN=2, AC_OCT=8, AC_DEC=10, AC_HEX=16 };
+enum ac_special_val { AC_VAL_DC, AC_VAL_0, AC_VAL_MIN, AC_VAL_MAX, AC_VAL_QUANTUM };
+enum ac_q_mode { AC_TRN, AC_RND, AC_TRN_ZERO, AC_RND_ZERO, AC_RND_INF, AC_RND_MIN_INF, AC_RND_CONV, AC_RND_CONV_ODD };
+enum ac_o_mode { AC_WRAP, AC_SAT, AC_SAT_ZERO, AC_SAT_SYM };
+
+template<int W, bool S = true>
+class ac_int;
+
+template<int W, int I, bool S = true, ac_q_mode Q = AC_TRN, ac_o_mode O = AC_WRAP>
+class ac_fixed;
+
+namespace ac_fast {
+
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+
+static const int long_w = 8 * sizeof(long);
+
+template<class T> struct unsigned_of;
+template<> struct unsigned_of<long long> { typedef unsigned long long type; };
+template<> struct unsigned_of<int128> { typedef uint128 type; };
+template<> struct unsigned_of<unsigned long long> { typedef unsigned long long type; };
+template<> struct unsigned_of<uint128> { typedef uint128 type; };
+
+template<class T> struct nbits { enum { value = 8 * sizeof(T) }; };
+
+// Storage of a W-bit number; an unsigned number needs an extra (zero) bit
+template<int W, bool S>
+struct storage {
+    static_assert(W >= 1, "ac_int / ac_fixed width must be positive");
+    static_assert(W + !S <= 128, "ac_int / ac_fixed wider than 128 bits are not supported by ac_fast.h, compile without HLS4ML_FAST_AC_TYPES");
+    typedef typename std::conditional<(W + !S <= 64), long long, int128>::type type;
+};
+
+template<class T1, class T2>
+struct wider {
+    typedef typename std::conditional<(sizeof(T1) >= sizeof(T2)), T1, T2>::type type;
+};
+
+// Implicit conversion of ac_int to C integers, only available up to 64 bits, as in the reference
+struct no_conversion {};
+template<int W, bool S, bool Enable = (W <= 64)>
+struct int_conversion {
+    typedef no_conversion type;
+    template<class T> static type get(T) { return type(); }
+};
+template<int W, bool S>
+struct int_conversion<W, S, true> {
+    typedef typename std::conditional<S, Slong, Ulong>::type type;
+    template<class T> static type get(T x) { return (type) x; }
+};
+
+// Shifts by a compile-time amount, defined for any amount
+template<int D, class T>
+inline T shl(T x) {
+    typedef typename unsigned_of<T>::type U;
+    return D >= nbits<T>::value ? 0 : (T) ((U) x << (D % nbits<T>::value));
+}
+template<int D, class T>
+inline T shr(T x) {
+    return D >= nbits<T>::value ? (x < 0 ? -1 : 0) : x >> (D % nbits<T>::value);
+}
+
+// Shifts by a run-time amount, defined for any amount
+template<class T>
+inline T shl(T x, unsigned n) {
+    typedef typename unsigned_of<T>::type U;
+    return n >= (unsigned) nbits<T>::value ? 0 : (T) ((U) x << n);
+}
+template<class T>
+inline T shr(T x, unsigned n) {
+    return n >= (unsigned) nbits<T>::value ? (x < 0 ? -1 : 0) : x >> n;
+}
+
+// Keeps the W least significant bits, sign- or zero-extended (two's complement wrap-around)
+template<int W, bool S, class T>
+inline T wrap(T x) {
+    typedef typename unsigned_of<T>::type U;
+    enum { B = nbits<T>::value, SH = W < B ? B - W : 0 };
+    if (W >= B) return x;
+    if (S) return (T) ((U) x << SH) >> SH;
+    return (T) ((U) x & (((U) 1 << (W % B)) - 1));
+}
+
+// Checks if x is representable with N bits
+template<int N, bool S, class T>
+inline bool fits(T x) {
+    enum { B = nbits<T>::value };
+    if (N <= 0) return x == 0;
+    if (S) return N >= B || (x >> ((N - 1) % B)) == (x >> (B - 1));
+    return x >= 0 && (N >= B - 1 || (x >> (N % B)) == 0);
+}
+
+template<int W, bool S, class T>
+inline T max_value() {
+    typedef typename unsigned_of<T>::type U;
+    return (T) (((U) 1 << ((W - S) % nbits<T>::value)) - 1);
+}
+template<int W, bool S, class T>
+inline T min_value() {
+    return S ? -max_value<W, S, T>() - 1 : 0;
+}
+
+// Increment of the truncated value, given the quantization bit (MSB of the deleted bits), the OR of the remaining deleted bits,
+// the sign of the source and the LSB of the truncated value
+template<ac_q_mode Q>
+inline bool quantization_carry(bool qb, bool r, bool s, bool lsb) {
+    switch (Q) {
+        case AC_TRN:          return false;
+        case AC_RND:          return qb;
+        case AC_TRN_ZERO:     return s && (qb || r);
+        case AC_RND_ZERO:     return qb && (s || r);
+        case AC_RND_INF:      return qb && (!s || r);
+        case AC_RND_MIN_INF:  return qb && r;
+        case AC_RND_CONV:     return qb && (lsb || r);
+        case AC_RND_CONV_ODD: return qb && (!lsb || r);
+    }
+    return false;
+}
+
+// Removes the D > 0 least significant bits of x, applying quantization mode Q
+template<ac_q_mode Q, bool S2, int D, class T>
+inline T quantize(T x) {
+    typedef typename unsigned_of<T>::type U;
+    enum { B = nbits<T>::value, QB = D > 0 ? D - 1 : 0 };
+    const T q = shr<D>(x);
+    if (Q == AC_TRN || (Q == AC_TRN_ZERO && !S2)) return q;
+    const bool qb = QB >= B ? x < 0 : (bool) ((x >> (QB % B)) & 1);
+    const bool r = QB >= B ? x != 0 : (QB > 0 && ((U) x << ((B - QB) % B)) != 0);
+    return q + quantization_carry<Q>(qb, r, S2 && x < 0, q & 1);
+}
+
+// d * 2^N; the scale factor is a compile-time constant, so this is a single (exact) multiplication
+template<int N>
+inline double scale(double d) {
+    return (N > 1000 || N < -1000) ? std::ldexp(d, N) : d * std::ldexp(1.0, N);
+}
+
+// Splits t into its floor and the quantization bits of the remaining fraction
+// If the floor does not fit in 128 bits, o is set and the floor is only kept modulo 2^128
+inline int128 floor_double(double t, bool &qb, bool &r, bool &o) {
+    static const double limit_64 = 9.2233720368547758e18; // 2^63
+    static const double limit_128 = 1.7014118346046923e38; // 2^127
+    o = false;
+    if (std::fabs(t) < limit_64) {
+        long long fl = (long long) t;
+        fl -= t < (double) fl;
+        const double fr = t - (double) fl;
+        qb = fr >= 0.5;
+        r = fr != (qb ? 0.5 : 0.0);
+        return fl;
+    }
+    // Larger values are integers
+    qb = r = false;
+    if (std::fabs(t) < limit_128) return (int128) t;
+    o = true;
+    int e;
+    const long long m = (long long) std::ldexp(std::frexp(t, &e), 53);
+    return shl((int128) m, (unsigned) (e - 53));
+}
+
+// Conversion to double of a W-bit number, rounding the same way as the reference, one 32-bit word at a time
+template<int W, bool S, class T>
+inline double to_double(T x) {
+    enum { N = (W + 31 + !S) / 32 };
+    if (N <= 2) return (double) (long long) x;
+    double a = (int) shr<32 * (N - 1)>(x);
+    for (int i = N - 2; i >= 0; i--) {
+        a *= 4294967296.0;
+        a += (unsigned) shr(x, 32 * i);
+    }
+    return a;
+}
+
+// Three-way comparison of x and y * 2^D, D >= 0, where y is a WY-bit number
+template<int D, int WY, class T1, class T2>
+inline int compare_shifted(T1 x, T2 y) {
+    typedef typename wider<T1, T2>::type T;
+    enum { B = nbits<T>::value };
+    if (WY + D >= B && !fits<B - D, true>((T) y)) return y < 0 ? 1 : -1;
+    const T ys = shl<D>((T) y);
+    return ((T) x > ys) - ((T) x < ys);
+}
+
+// Three-way comparison of the W-bit number x * 2^-F and d
+template<int W, int F, class T>
+inline int compare_double(T x, double d) {
+    if (W <= 53) {
+        const double a = scale<-F>((double) x);
+        return (a > d) - (a < d);
+    }
+    bool qb, r, o;
+    const int128 fl = floor_double(scale<F>(d), qb, r, o);
+    if (o) return d < 0 ? 1 : -1;
+    if ((int128) x != fl) return (int128) x > fl ? 1 : -1;
+    return (qb || r) ? -1 : 0;
+}
+
+// Replaces the bits [lsb, lsb + WS) of x
+template<int WS, class T, class T2>
+inline T set_bits(T x, unsigned lsb, T2 val) {
+    typedef typename unsigned_of<T>::type U;
+    const U mask = shl((U) shl<WS % nbits<U>::value>((U) 1) - 1, lsb);
+    return (T) (((U) x & ~mask) | (shl((U) (T) val, lsb) & mask));
+}
+
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//  ac_int
+//////////////////////////////////////////////////////////////////////////////
+
+template<int W, bool S>
+class ac_int {
+  public:
+    typedef typename ac_fast::storage<W, S>::type storage_t;
+
+  private:
+    storage_t v;
+
+    template<int W2, bool S2> friend class ac_int;
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2> friend class ac_fixed;
+
+    inline void bit_adjust() { v = ac_fast::wrap<W, S>(v); }
+
+  public:
+    static const int width = W;
+    static const int i_width = W;
+    static const bool sign = S;
+    static const ac_q_mode q_mode = AC_TRN;
+    static const ac_o_mode o_mode = AC_WRAP;
+    static const int e_width = 0;
+
+    template<int W2, bool S2>
+    struct rt {
+        enum {
+            mult_w = W + W2,
+            mult_s = S || S2,
+            plus_w = AC_MAX(W + (S2 && !S), W2 + (S && !S2)) + 1,
+            plus_s = S || S2,
+            minus_w = AC_MAX(W + (S2 && !S), W2 + (S && !S2)) + 1,
+            minus_s = true,
+            div_w = W + S2,
+            div_s = S || S2,
+            mod_w = AC_MIN(W, W2 + (!S2 && S)),
+            mod_s = S,
+            logic_w = AC_MAX(W + (S2 && !S), W2 + (S && !S2)),
+            logic_s = S || S2
+        };
+        typedef ac_int<mult_w, mult_s> mult;
+        typedef ac_int<plus_w, plus_s> plus;
+        typedef ac_int<minus_w, minus_s> minus;
+        typedef ac_int<logic_w, logic_s> logic;
+        typedef ac_int<div_w, div_s> div;
+        typedef ac_int<mod_w, mod_s> mod;
+        typedef ac_int<W, S> arg1;
+    };
+
+    struct rt_unary {
+        enum {
+            neg_w = W + 1,
+            neg_s = true,
+            mag_w = W + S,
+            mag_s = false
+        };
+        typedef ac_int<neg_w, neg_s> neg;
+        typedef ac_int<mag_w, mag_s> mag;
+    };
+
+    // Constructors ------------------------------------------------------------
+    ac_int() {}
+    template<int W2, bool S2>
+    inline ac_int(const ac_int<W2, S2> &op) : v(ac_fast::wrap<W, S>((storage_t) op.v)) {}
+
+    inline ac_int(bool b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(char b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(signed char b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(unsigned char b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(signed short b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(unsigned short b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(signed int b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(unsigned int b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(signed long b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(unsigned long b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(Slong b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(Ulong b) : v(ac_fast::wrap<W, S>((storage_t) b)) {}
+    inline ac_int(double d) {
+        bool qb, r, o;
+        v = ac_fast::wrap<W, S>((storage_t) ac_fast::floor_double(d, qb, r, o));
+    }
+
+    template<ac_special_val V>
+    inline ac_int &set_val() {
+        if (V == AC_VAL_MIN) v = ac_fast::min_value<W, S, storage_t>();
+        else if (V == AC_VAL_MAX) v = ac_fast::max_value<W, S, storage_t>();
+        else if (V == AC_VAL_QUANTUM) v = 1;
+        else v = 0;
+        return *this;
+    }
+
+    // Conversions to C built-in types -----------------------------------------
+    inline int to_int() const { return (int) v; }
+    inline unsigned to_uint() const { return (unsigned) v; }
+    inline long to_long() const { return (long) v; }
+    inline unsigned long to_ulong() const { return (unsigned long) v; }
+    inline Slong to_int64() const { return (Slong) v; }
+    inline Ulong to_uint64() const { return (Ulong) v; }
+    inline double to_double() const { return ac_fast::to_double<W, S>(v); }
+
+    inline operator typename ac_fast::int_conversion<W, S>::type () const {
+        return ac_fast::int_conversion<W, S>::get(v);
+    }
+
+    inline int length() const { return W; }
+
+    // Arithmetic : Binary -----------------------------------------------------
+    template<int W2, bool S2>
+    typename rt<W2, S2>::mult operator *(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::mult r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v * (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, bool S2>
+    typename rt<W2, S2>::plus operator +(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::plus r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v + (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, bool S2>
+    typename rt<W2, S2>::minus operator -(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::minus r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v - (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, bool S2>
+    typename rt<W2, S2>::div operator /(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::div r_T;
+        typedef typename ac_fast::wider<typename r_T::storage_t, typename ac_int<W2, S2>::storage_t>::type T;
+        r_T r;
+        r.v = (typename r_T::storage_t) ac_fast::wrap<r_T::width, r_T::sign>((T) v / (T) op2.v);
+        return r;
+    }
+    template<int W2, bool S2>
+    typename rt<W2, S2>::mod operator %(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::mod r_T;
+        typedef typename ac_fast::wider<storage_t, typename ac_int<W2, S2>::storage_t>::type T;
+        r_T r;
+        r.v = (typename r_T::storage_t) ac_fast::wrap<r_T::width, r_T::sign>((T) v % (T) op2.v);
+        return r;
+    }
+
+    // Arithmetic assign -------------------------------------------------------
+    template<int W2, bool S2>
+    ac_int &operator *=(const ac_int<W2, S2> &op2) { *this = this->operator *(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator +=(const ac_int<W2, S2> &op2) { *this = this->operator +(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator -=(const ac_int<W2, S2> &op2) { *this = this->operator -(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator /=(const ac_int<W2, S2> &op2) { *this = this->operator /(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator %=(const ac_int<W2, S2> &op2) { *this = this->operator %(op2); return *this; }
+
+    // Arithmetic prefix and postfix increment, decrement ----------------------
+    ac_int &operator ++() { v = ac_fast::wrap<W, S>(v + 1); return *this; }
+    ac_int &operator --() { v = ac_fast::wrap<W, S>(v - 1); return *this; }
+    const ac_int operator ++(int) { ac_int t = *this; operator ++(); return t; }
+    const ac_int operator --(int) { ac_int t = *this; operator --(); return t; }
+
+    // Arithmetic : Unary ------------------------------------------------------
+    ac_int operator +() const { return *this; }
+    typename rt_unary::neg operator -() const {
+        typename rt_unary::neg r;
+        r.v = -(typename rt_unary::neg::storage_t) v;
+        return r;
+    }
+    bool operator !() const { return v == 0; }
+    ac_int<W + !S, true> operator ~() const {
+        ac_int<W + !S, true> r;
+        r.v = ~(typename ac_int<W + !S, true>::storage_t) v;
+        return r;
+    }
+    ac_int<W, false> bit_complement() const {
+        ac_int<W, false> r;
+        r.v = ac_fast::wrap<W, false>((typename ac_int<W, false>::storage_t) ~v);
+        return r;
+    }
+
+    // Bitwise : and, or, xor --------------------------------------------------
+    template<int W2, bool S2>
+    typename rt<W2, S2>::logic operator &(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::logic r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v & (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, bool S2>
+    typename rt<W2, S2>::logic operator |(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::logic r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v | (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, bool S2>
+    typename rt<W2, S2>::logic operator ^(const ac_int<W2, S2> &op2) const {
+        typedef typename rt<W2, S2>::logic r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v ^ (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, bool S2>
+    ac_int &operator &=(const ac_int<W2, S2> &op2) { *this = this->operator &(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator |=(const ac_int<W2, S2> &op2) { *this = this->operator |(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator ^=(const ac_int<W2, S2> &op2) { *this = this->operator ^(op2); return *this; }
+
+    // Shift (result constrained by left operand); a negative signed amount shifts in the opposite direction
+    template<int W2>
+    ac_int operator <<(const ac_int<W2, true> &op2) const {
+        const int s = op2.to_int();
+        ac_int r;
+        r.v = ac_fast::wrap<W, S>(s >= 0 ? ac_fast::shl(v, s) : ac_fast::shr(v, 0u - s));
+        return r;
+    }
+    template<int W2>
+    ac_int operator <<(const ac_int<W2, false> &op2) const {
+        ac_int r;
+        r.v = ac_fast::wrap<W, S>(ac_fast::shl(v, op2.to_uint()));
+        return r;
+    }
+    template<int W2>
+    ac_int operator >>(const ac_int<W2, true> &op2) const {
+        const int s = op2.to_int();
+        ac_int r;
+        r.v = ac_fast::wrap<W, S>(s >= 0 ? ac_fast::shr(v, s) : ac_fast::shl(v, 0u - s));
+        return r;
+    }
+    template<int W2>
+    ac_int operator >>(const ac_int<W2, false> &op2) const {
+        ac_int r;
+        r.v = ac_fast::shr(v, op2.to_uint());
+        return r;
+    }
+    template<int W2, bool S2>
+    ac_int &operator <<=(const ac_int<W2, S2> &op2) { *this = this->operator <<(op2); return *this; }
+    template<int W2, bool S2>
+    ac_int &operator >>=(const ac_int<W2, S2> &op2) { *this = this->operator >>(op2); return *this; }
+
+    // Relational --------------------------------------------------------------
+    template<int W2, bool S2>
+    bool operator ==(const ac_int<W2, S2> &op2) const { return compare(op2) == 0; }
+    template<int W2, bool S2>
+    bool operator !=(const ac_int<W2, S2> &op2) const { return compare(op2) != 0; }
+    template<int W2, bool S2>
+    bool operator <(const ac_int<W2, S2> &op2) const { return compare(op2) < 0; }
+    template<int W2, bool S2>
+    bool operator >=(const ac_int<W2, S2> &op2) const { return compare(op2) >= 0; }
+    template<int W2, bool S2>
+    bool operator >(const ac_int<W2, S2> &op2) const { return compare(op2) > 0; }
+    template<int W2, bool S2>
+    bool operator <=(const ac_int<W2, S2> &op2) const { return compare(op2) <= 0; }
+
+    template<int W2, bool S2>
+    inline int compare(const ac_int<W2, S2> &op2) const {
+        typedef typename ac_fast::wider<storage_t, typename ac_int<W2, S2>::storage_t>::type T;
+        return ((T) v > (T) op2.v) - ((T) v < (T) op2.v);
+    }
+
+    // Bit and slice select ----------------------------------------------------
+    template<int WS, int WX, bool SX>
+    inline const ac_int<WS, S> slc(const ac_int<WX, SX> &index) const {
+        return slc<WS>(ac_int<WX - SX, false>(index).to_uint());
+    }
+    template<int WS>
+    inline const ac_int<WS, S> slc(signed index) const {
+        return slc<WS>((unsigned) (index & ((unsigned) ~0 >> 1)));
+    }
+    template<int WS>
+    inline const ac_int<WS, S> slc(unsigned uindex) const {
+        typedef typename ac_int<WS, S>::storage_t r_T;
+        ac_int<WS, S> r;
+        r.v = ac_fast::wrap<WS, S>((r_T) ac_fast::shr(v, uindex));
+        return r;
+    }
+
+    template<int W2, bool S2, int WX, bool SX>
+    inline ac_int &set_slc(const ac_int<WX, SX> lsb, const ac_int<W2, S2> &slc) {
+        return set_slc(ac_int<WX - SX, false>(lsb).to_uint(), slc);
+    }
+    template<int W2, bool S2>
+    inline ac_int &set_slc(signed lsb, const ac_int<W2, S2> &slc) {
+        return set_slc((unsigned) (lsb & ((unsigned) ~0 >> 1)), slc);
+    }
+    template<int W2, bool S2>
+    inline ac_int &set_slc(unsigned ulsb, const ac_int<W2, S2> &slc) {
+        if (W == W2) v = ac_fast::wrap<W, S>((storage_t) slc.v);
+        else v = ac_fast::wrap<W, S>(ac_fast::set_bits<W2>(v, ulsb, slc.v));
+        return *this;
+    }
+
+    class ac_bitref {
+        ac_int &d_bv;
+        unsigned d_index;
+      public:
+        ac_bitref(ac_int *bv, unsigned index = 0) : d_bv(*bv), d_index(index) {}
+        operator bool () const { return d_index < W ? (bool) (ac_fast::shr(d_bv.v, d_index) & 1) : false; }
+
+        template<int W2, bool S2>
+        operator ac_int<W2, S2> () const { return operator bool (); }
+
+        inline ac_bitref operator =(int val) {
+            if (d_index < W) d_bv.v = ac_fast::wrap<W, S>(ac_fast::set_bits<1>(d_bv.v, d_index, val & 1));
+            return *this;
+        }
+        template<int W2, bool S2>
+        inline ac_bitref operator =(const ac_int<W2, S2> &val) { return operator =(val.to_int()); }
+        inline ac_bitref operator =(const ac_bitref &val) { return operator =((int) (bool) val); }
+    };
+
+    ac_bitref operator [](unsigned int uindex) { return ac_bitref(this, uindex); }
+    ac_bitref operator [](int index) { return ac_bitref(this, index & ((unsigned) ~0 >> 1)); }
+    template<int W2, bool S2>
+    ac_bitref operator [](const ac_int<W2, S2> &index) { return ac_bitref(this, ac_int<W2 - S2, false>(index).to_uint()); }
+    bool operator [](unsigned int uindex) const { return uindex < W ? (bool) (ac_fast::shr(v, uindex) & 1) : false; }
+    bool operator [](int index) const { return operator []((unsigned) (index & ((unsigned) ~0 >> 1))); }
+    template<int W2, bool S2>
+    bool operator [](const ac_int<W2, S2> &index) const { return operator [](ac_int<W2 - S2, false>(index).to_uint()); }
+};
+
+template<int W, bool S>
+inline std::ostream &operator <<(std::ostream &os, const ac_int<W, S> &x) {
+    if (W <= 64) os << (S ? (double) x.to_int64() : (double) x.to_uint64());
+    else os << x.to_double();
+    return os;
+}
+
+// Mixed operators with C integers ---------------------------------------------
+
+#define AC_FAST_BIN_OP_WITH_INT(BIN_OP, C_TYPE, WI, SI, RTYPE) \
+    template<int W, bool S> \
+    inline typename ac_int<WI, SI>::template rt<W, S>::RTYPE operator BIN_OP (C_TYPE i_op, const ac_int<W, S> &op) { \
+        return ac_int<WI, SI>(i_op).operator BIN_OP (op); \
+    } \
+    template<int W, bool S> \
+    inline typename ac_int<W, S>::template rt<WI, SI>::RTYPE operator BIN_OP (const ac_int<W, S> &op, C_TYPE i_op) { \
+        return op.operator BIN_OP (ac_int<WI, SI>(i_op)); \
+    }
+
+#define AC_FAST_REL_OP_WITH_INT(REL_OP, C_TYPE, W2, S2) \
+    template<int W, bool S> \
+    inline bool operator REL_OP (const ac_int<W, S> &op, C_TYPE op2) { \
+        return op.operator REL_OP (ac_int<W2, S2>(op2)); \
+    } \
+    template<int W, bool S> \
+    inline bool operator REL_OP (C_TYPE op2, const ac_int<W, S> &op) { \
+        return ac_int<W2, S2>(op2).operator REL_OP (op); \
+    }
+
+#define AC_FAST_ASSIGN_OP_WITH_INT(ASSIGN_OP, C_TYPE, W2, S2) \
+    template<int W, bool S> \
+    inline ac_int<W, S> &operator ASSIGN_OP (ac_int<W, S> &op, C_TYPE op2) { \
+        return op.operator ASSIGN_OP (ac_int<W2, S2>(op2)); \
+    }
+
+#define AC_FAST_OPS_WITH_INT(C_TYPE, WI, SI) \
+    AC_FAST_BIN_OP_WITH_INT(*, C_TYPE, WI, SI, mult) \
+    AC_FAST_BIN_OP_WITH_INT(+, C_TYPE, WI, SI, plus) \
+    AC_FAST_BIN_OP_WITH_INT(-, C_TYPE, WI, SI, minus) \
+    AC_FAST_BIN_OP_WITH_INT(/, C_TYPE, WI, SI, div) \
+    AC_FAST_BIN_OP_WITH_INT(%, C_TYPE, WI, SI, mod) \
+    AC_FAST_BIN_OP_WITH_INT(>>, C_TYPE, WI, SI, arg1) \
+    AC_FAST_BIN_OP_WITH_INT(<<, C_TYPE, WI, SI, arg1) \
+    AC_FAST_BIN_OP_WITH_INT(&, C_TYPE, WI, SI, logic) \
+    AC_FAST_BIN_OP_WITH_INT(|, C_TYPE, WI, SI, logic) \
+    AC_FAST_BIN_OP_WITH_INT(^, C_TYPE, WI, SI, logic) \
+    \
+    AC_FAST_REL_OP_WITH_INT(==, C_TYPE, WI, SI) \
+    AC_FAST_REL_OP_WITH_INT(!=, C_TYPE, WI, SI) \
+    AC_FAST_REL_OP_WITH_INT(>, C_TYPE, WI, SI) \
+    AC_FAST_REL_OP_WITH_INT(>=, C_TYPE, WI, SI) \
+    AC_FAST_REL_OP_WITH_INT(<, C_TYPE, WI, SI) \
+    AC_FAST_REL_OP_WITH_INT(<=, C_TYPE, WI, SI) \
+    \
+    AC_FAST_ASSIGN_OP_WITH_INT(+=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(-=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(*=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(/=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(%=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(>>=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(<<=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(&=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(|=, C_TYPE, WI, SI) \
+    AC_FAST_ASSIGN_OP_WITH_INT(^=, C_TYPE, WI, SI)
+
+AC_FAST_OPS_WITH_INT(bool, 1, false)
+AC_FAST_OPS_WITH_INT(char, 8, true)
+AC_FAST_OPS_WITH_INT(signed char, 8, true)
+AC_FAST_OPS_WITH_INT(unsigned char, 8, false)
+AC_FAST_OPS_WITH_INT(short, 16, true)
+AC_FAST_OPS_WITH_INT(unsigned short, 16, false)
+AC_FAST_OPS_WITH_INT(int, 32, true)
+AC_FAST_OPS_WITH_INT(unsigned int, 32, false)
+AC_FAST_OPS_WITH_INT(long, ac_fast::long_w, true)
+AC_FAST_OPS_WITH_INT(unsigned long, ac_fast::long_w, false)
+AC_FAST_OPS_WITH_INT(Slong, 64, true)
+AC_FAST_OPS_WITH_INT(Ulong, 64, false)
+
+// Mixed operators with pointers ------------------------------------------------
+
+template<class T, int W, bool S>
+inline T *operator +(T *ptr, const ac_int<W, S> &op2) { return ptr + op2.to_int64(); }
+template<class T, int W, bool S>
+inline T *operator +(const ac_int<W, S> &op2, T *ptr) { return ptr + op2.to_int64(); }
+template<class T, int W, bool S>
+inline T *operator -(T *ptr, const ac_int<W, S> &op2) { return ptr - op2.to_int64(); }
+
+// Predefined for ease of use, as in the reference -------------------------------
+
+#define AC_FAST_INTN(N) typedef ac_int<N, true> int##N; typedef ac_int<N, false> uint##N;
+
+namespace ac_intN {
+    AC_FAST_INTN(1) AC_FAST_INTN(2) AC_FAST_INTN(3) AC_FAST_INTN(4) AC_FAST_INTN(5) AC_FAST_INTN(6) AC_FAST_INTN(7) AC_FAST_INTN(8)
+    AC_FAST_INTN(9) AC_FAST_INTN(10) AC_FAST_INTN(11) AC_FAST_INTN(12) AC_FAST_INTN(13) AC_FAST_INTN(14) AC_FAST_INTN(15) AC_FAST_INTN(16)
+    AC_FAST_INTN(17) AC_FAST_INTN(18) AC_FAST_INTN(19) AC_FAST_INTN(20) AC_FAST_INTN(21) AC_FAST_INTN(22) AC_FAST_INTN(23) AC_FAST_INTN(24)
+    AC_FAST_INTN(25) AC_FAST_INTN(26) AC_FAST_INTN(27) AC_FAST_INTN(28) AC_FAST_INTN(29) AC_FAST_INTN(30) AC_FAST_INTN(31) AC_FAST_INTN(32)
+    AC_FAST_INTN(33) AC_FAST_INTN(34) AC_FAST_INTN(35) AC_FAST_INTN(36) AC_FAST_INTN(37) AC_FAST_INTN(38) AC_FAST_INTN(39) AC_FAST_INTN(40)
+    AC_FAST_INTN(41) AC_FAST_INTN(42) AC_FAST_INTN(43) AC_FAST_INTN(44) AC_FAST_INTN(45) AC_FAST_INTN(46) AC_FAST_INTN(47) AC_FAST_INTN(48)
+    AC_FAST_INTN(49) AC_FAST_INTN(50) AC_FAST_INTN(51) AC_FAST_INTN(52) AC_FAST_INTN(53) AC_FAST_INTN(54) AC_FAST_INTN(55) AC_FAST_INTN(56)
+    AC_FAST_INTN(57) AC_FAST_INTN(58) AC_FAST_INTN(59) AC_FAST_INTN(60) AC_FAST_INTN(61) AC_FAST_INTN(62) AC_FAST_INTN(63)
+}
+
+#ifndef AC_NOT_USING_INTN
+using namespace ac_intN;
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+//  ac_fixed
+//////////////////////////////////////////////////////////////////////////////
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+class ac_fixed {
+  public:
+    typedef typename ac_fast::storage<W, S>::type storage_t;
+
+  private:
+    storage_t v;
+
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2> friend class ac_fixed;
+    template<int W2, bool S2> friend class ac_int;
+
+    static const int F = W - I;
+
+    inline void bit_adjust() { v = ac_fast::wrap<W, S>(v); }
+
+    // Applies the overflow mode to the wrapped value v, given the overflow and the sign of the (quantized) source
+    inline void overflow_adjust(bool overflow, bool neg, bool sym_check) {
+        if (O == AC_SAT_SYM && S && sym_check && neg && v == ac_fast::min_value<W, S, storage_t>()) overflow = true;
+        if (!overflow) return;
+        if (O == AC_SAT_ZERO) v = 0;
+        else if (neg) v = S ? ac_fast::min_value<W, S, storage_t>() | (O == AC_SAT_SYM) : 0;
+        else v = ac_fast::max_value<W, S, storage_t>();
+    }
+
+    // Value of x * 2^-F2, aligned to F3 >= F2 fractional bits
+    template<int F2, int F3, class T, class T2>
+    static inline T align(T2 x) { return ac_fast::shl<F3 - F2>((T) x); }
+
+  public:
+    static const int width = W;
+    static const int i_width = I;
+    static const bool sign = S;
+    static const ac_o_mode o_mode = O;
+    static const ac_q_mode q_mode = Q;
+    static const int e_width = 0;
+
+    template<int W2, int I2, bool S2>
+    struct rt {
+        enum {
+            F = W - I,
+            F2 = W2 - I2,
+            mult_w = W + W2,
+            mult_i = I + I2,
+            mult_s = S || S2,
+            plus_w = AC_MAX(I + (S2 && !S), I2 + (S && !S2)) + 1 + AC_MAX(F, F2),
+            plus_i = AC_MAX(I + (S2 && !S), I2 + (S && !S2)) + 1,
+            plus_s = S || S2,
+            minus_w = AC_MAX(I + (S2 && !S), I2 + (S && !S2)) + 1 + AC_MAX(F, F2),
+            minus_i = AC_MAX(I + (S2 && !S), I2 + (S && !S2)) + 1,
+            minus_s = true,
+            div_w = W + AC_MAX(W2 - I2, 0) + S2,
+            div_i = I + (W2 - I2) + S2,
+            div_s = S || S2,
+            logic_w = AC_MAX(I + (S2 && !S), I2 + (S && !S2)) + AC_MAX(F, F2),
+            logic_i = AC_MAX(I + (S2 && !S), I2 + (S && !S2)),
+            logic_s = S || S2
+        };
+        typedef ac_fixed<mult_w, mult_i, mult_s> mult;
+        typedef ac_fixed<plus_w, plus_i, plus_s> plus;
+        typedef ac_fixed<minus_w, minus_i, minus_s> minus;
+        typedef ac_fixed<logic_w, logic_i, logic_s> logic;
+        typedef ac_fixed<div_w, div_i, div_s> div;
+        typedef ac_fixed<W, I, S> arg1;
+    };
+
+    struct rt_unary {
+        enum {
+            neg_w = W + 1,
+            neg_i = I + 1,
+            neg_s = true,
+            mag_w = W + S,
+            mag_i = I + S,
+            mag_s = false
+        };
+        typedef ac_fixed<neg_w, neg_i, neg_s> neg;
+        typedef ac_fixed<mag_w, mag_i, mag_s> mag;
+    };
+
+    // Constructors ------------------------------------------------------------
+    ac_fixed() {}
+
+    // Conversion from another ac_fixed, with quantization and overflow handling
+    // As in the reference, overflow is only checked if the source range can exceed the target range
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    inline ac_fixed(const ac_fixed<W2, I2, S2, Q2, O2> &op) {
+        enum {
+            F2 = W2 - I2,
+            QUAN_INC = F2 > F && !(Q == AC_TRN || (Q == AC_TRN_ZERO && !S2)),
+            CHECK = O != AC_WRAP && ((!S && S2) || I - S < I2 - S2 + (QUAN_INC || (S2 && O == AC_SAT_SYM && (O2 != AC_SAT_SYM || F2 > F))))
+        };
+        typedef typename ac_fast::wider<storage_t, typename ac_fixed<W2, I2, S2>::storage_t>::type T;
+        if (F2 > F) {
+            const T q = ac_fast::quantize<Q, S2, (F2 > F ? F2 - F : 0)>((T) op.v);
+            v = ac_fast::wrap<W, S>((storage_t) q);
+            if (CHECK) overflow_adjust(!ac_fast::fits<W, S>(q), q < 0, S2);
+        } else {
+            v = ac_fast::wrap<W, S>(ac_fast::shl<(F > F2 ? F - F2 : 0)>((storage_t) op.v));
+            if (CHECK) overflow_adjust(!ac_fast::fits<W - (F - F2), S>(op.v), op.v < 0, S2);
+        }
+    }
+
+    template<int W2, bool S2>
+    inline ac_fixed(const ac_int<W2, S2> &op) {
+        ac_fixed<W2, W2, S2> f_op;
+        f_op.v = op.v;
+        *this = f_op;
+    }
+
+    inline ac_fixed(bool b) { *this = (ac_int<1, false>) b; }
+    inline ac_fixed(char b) { *this = (ac_int<8, true>) b; }
+    inline ac_fixed(signed char b) { *this = (ac_int<8, true>) b; }
+    inline ac_fixed(unsigned char b) { *this = (ac_int<8, false>) b; }
+    inline ac_fixed(signed short b) { *this = (ac_int<16, true>) b; }
+    inline ac_fixed(unsigned short b) { *this = (ac_int<16, false>) b; }
+    inline ac_fixed(signed int b) { *this = (ac_int<32, true>) b; }
+    inline ac_fixed(unsigned int b) { *this = (ac_int<32, false>) b; }
+    inline ac_fixed(signed long b) { *this = (ac_int<ac_fast::long_w, true>) b; }
+    inline ac_fixed(unsigned long b) { *this = (ac_int<ac_fast::long_w, false>) b; }
+    inline ac_fixed(Slong b) { *this = (ac_int<64, true>) b; }
+    inline ac_fixed(Ulong b) { *this = (ac_int<64, false>) b; }
+
+    inline ac_fixed(double d) {
+        bool qb, r, o;
+        ac_fast::int128 q = ac_fast::floor_double(ac_fast::scale<F>(d), qb, r, o);
+        q += ac_fast::quantization_carry<Q>(qb, r, d < 0, q & 1);
+        v = ac_fast::wrap<W, S>((storage_t) q);
+        if (O != AC_WRAP) overflow_adjust(o || !ac_fast::fits<W, S>(q), o ? d < 0 : q < 0, true);
+    }
+
+    template<ac_special_val V>
+    inline ac_fixed &set_val() {
+        if (V == AC_VAL_MIN) v = W == 1 && O == AC_SAT_SYM ? 0 : ac_fast::min_value<W, S, storage_t>() | (S && O == AC_SAT_SYM);
+        else if (V == AC_VAL_MAX) v = ac_fast::max_value<W, S, storage_t>();
+        else if (V == AC_VAL_QUANTUM) v = 1;
+        else v = 0;
+        return *this;
+    }
+
+    // Conversions to ac_int (integer bits, truncated) and C built-in types --------
+    inline ac_int<AC_MAX(I, 1), S> to_ac_int() const {
+        return ((ac_fixed<AC_MAX(I, 1), AC_MAX(I, 1), S>) *this).template slc<AC_MAX(I, 1)>(0);
+    }
+
+    inline int to_int() const { return ((I - W) >= 32) ? 0 : to_ac_int().to_int(); }
+    inline unsigned to_uint() const { return ((I - W) >= 32) ? 0 : to_ac_int().to_uint(); }
+    inline long to_long() const { return ((I - W) >= ac_fast::long_w) ? 0 : to_ac_int().to_long(); }
+    inline unsigned long to_ulong() const { return ((I - W) >= ac_fast::long_w) ? 0 : to_ac_int().to_ulong(); }
+    inline Slong to_int64() const { return ((I - W) >= 64) ? 0 : to_ac_int().to_int64(); }
+    inline Ulong to_uint64() const { return ((I - W) >= 64) ? 0 : to_ac_int().to_uint64(); }
+    inline double to_double() const { return ac_fast::scale<I - W>(ac_fast::to_double<W, S>(v)); }
+
+    inline int length() const { return W; }
+
+    // Arithmetic : Binary -----------------------------------------------------
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::mult operator *(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::mult r_T;
+        r_T r;
+        r.v = (typename r_T::storage_t) v * (typename r_T::storage_t) op2.v;
+        return r;
+    }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::plus operator +(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::plus r_T;
+        typedef typename r_T::storage_t T;
+        enum { F2 = W2 - I2, FR = AC_MAX(F, F2) };
+        r_T r;
+        r.v = align<F, FR, T>(v) + align<F2, FR, T>(op2.v);
+        return r;
+    }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::minus operator -(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::minus r_T;
+        typedef typename r_T::storage_t T;
+        enum { F2 = W2 - I2, FR = AC_MAX(F, F2) };
+        r_T r;
+        r.v = align<F, FR, T>(v) - align<F2, FR, T>(op2.v);
+        return r;
+    }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::div operator /(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::div r_T;
+        typedef typename ac_fast::wider<typename r_T::storage_t, typename ac_fixed<W2, I2, S2>::storage_t>::type T;
+        enum { F2 = W2 - I2 };
+        r_T r;
+        const T num = ac_fast::shl<AC_MAX(F2, 0)>((T) v);
+        r.v = (typename r_T::storage_t) ac_fast::wrap<r_T::width, r_T::sign>(num / (T) op2.v);
+        return r;
+    }
+
+    // Arithmetic assign -------------------------------------------------------
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator *=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator *(op2); return *this; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator +=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator +(op2); return *this; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator -=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator -(op2); return *this; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator /=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator /(op2); return *this; }
+
+    // Increment, decrement by quantum (smallest difference that can be represented)
+    ac_fixed &operator ++() {
+        ac_fixed<1, I - W + 1, false> q;
+        q.template set_val<AC_VAL_QUANTUM>();
+        return operator +=(q);
+    }
+    ac_fixed &operator --() {
+        ac_fixed<1, I - W + 1, false> q;
+        q.template set_val<AC_VAL_QUANTUM>();
+        return operator -=(q);
+    }
+    const ac_fixed operator ++(int) { ac_fixed t = *this; operator ++(); return t; }
+    const ac_fixed operator --(int) { ac_fixed t = *this; operator --(); return t; }
+
+    // Arithmetic : Unary ------------------------------------------------------
+    ac_fixed operator +() const { return *this; }
+    typename rt_unary::neg operator -() const {
+        typename rt_unary::neg r;
+        r.v = -(typename rt_unary::neg::storage_t) v;
+        return r;
+    }
+    bool operator !() const { return v == 0; }
+    ac_fixed<W + !S, I + !S, true> operator ~() const {
+        ac_fixed<W + !S, I + !S, true> r;
+        r.v = ~(typename ac_fixed<W + !S, I + !S, true>::storage_t) v;
+        return r;
+    }
+    ac_fixed<W, I, false> bit_complement() const {
+        ac_fixed<W, I, false> r;
+        r.v = ac_fast::wrap<W, false>((typename ac_fixed<W, I, false>::storage_t) ~v);
+        return r;
+    }
+
+    // Bitwise (not arithmetic) : and, or, xor ---------------------------------
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::logic operator &(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::logic r_T;
+        typedef typename r_T::storage_t T;
+        enum { F2 = W2 - I2, FR = AC_MAX(F, F2) };
+        r_T r;
+        r.v = align<F, FR, T>(v) & align<F2, FR, T>(op2.v);
+        return r;
+    }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::logic operator |(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::logic r_T;
+        typedef typename r_T::storage_t T;
+        enum { F2 = W2 - I2, FR = AC_MAX(F, F2) };
+        r_T r;
+        r.v = align<F, FR, T>(v) | align<F2, FR, T>(op2.v);
+        return r;
+    }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    typename rt<W2, I2, S2>::logic operator ^(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        typedef typename rt<W2, I2, S2>::logic r_T;
+        typedef typename r_T::storage_t T;
+        enum { F2 = W2 - I2, FR = AC_MAX(F, F2) };
+        r_T r;
+        r.v = align<F, FR, T>(v) ^ align<F2, FR, T>(op2.v);
+        return r;
+    }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator &=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator &(op2); return *this; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator |=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator |(op2); return *this; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    ac_fixed &operator ^=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) { *this = this->operator ^(op2); return *this; }
+
+    // Shift (result constrained by left operand, no quantization or overflow handling)
+    template<int W2>
+    ac_fixed operator <<(const ac_int<W2, true> &op2) const {
+        const int s = op2.to_int();
+        ac_fixed r;
+        r.v = ac_fast::wrap<W, S>(s >= 0 ? ac_fast::shl(v, s) : ac_fast::shr(v, 0u - s));
+        return r;
+    }
+    template<int W2>
+    ac_fixed operator <<(const ac_int<W2, false> &op2) const {
+        ac_fixed r;
+        r.v = ac_fast::wrap<W, S>(ac_fast::shl(v, op2.to_uint()));
+        return r;
+    }
+    template<int W2>
+    ac_fixed operator >>(const ac_int<W2, true> &op2) const {
+        const int s = op2.to_int();
+        ac_fixed r;
+        r.v = ac_fast::wrap<W, S>(s >= 0 ? ac_fast::shr(v, s) : ac_fast::shl(v, 0u - s));
+        return r;
+    }
+    template<int W2>
+    ac_fixed operator >>(const ac_int<W2, false> &op2) const {
+        ac_fixed r;
+        r.v = ac_fast::shr(v, op2.to_uint());
+        return r;
+    }
+    template<int W2, bool S2>
+    ac_fixed operator <<=(const ac_int<W2, S2> &op2) { *this = this->operator <<(op2); return *this; }
+    template<int W2, bool S2>
+    ac_fixed operator >>=(const ac_int<W2, S2> &op2) { *this = this->operator >>(op2); return *this; }
+
+    // Relational --------------------------------------------------------------
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    bool operator ==(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const { return compare(op2) == 0; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    bool operator !=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const { return compare(op2) != 0; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    bool operator <(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const { return compare(op2) < 0; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    bool operator >=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const { return compare(op2) >= 0; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    bool operator >(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const { return compare(op2) > 0; }
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    bool operator <=(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const { return compare(op2) <= 0; }
+
+    bool operator ==(double d) const { return ac_fast::compare_double<W, F>(v, d) == 0; }
+    bool operator !=(double d) const { return ac_fast::compare_double<W, F>(v, d) != 0; }
+    bool operator <(double d) const { return ac_fast::compare_double<W, F>(v, d) < 0; }
+    bool operator >=(double d) const { return ac_fast::compare_double<W, F>(v, d) >= 0; }
+    bool operator >(double d) const { return ac_fast::compare_double<W, F>(v, d) > 0; }
+    bool operator <=(double d) const { return ac_fast::compare_double<W, F>(v, d) <= 0; }
+
+    template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
+    inline int compare(const ac_fixed<W2, I2, S2, Q2, O2> &op2) const {
+        enum { F2 = W2 - I2 };
+        if (F >= F2) return ac_fast::compare_shifted<AC_MAX(F - F2, 0), W2>(v, op2.v);
+        return -ac_fast::compare_shifted<AC_MAX(F2 - F, 0), W>(op2.v, v);
+    }
+
+    // Bit and slice select ----------------------------------------------------
+    template<int WS, int WX, bool SX>
+    inline const ac_int<WS, S> slc(const ac_int<WX, SX> &index) const {
+        return slc<WS>(ac_int<WX - SX, false>(index).to_uint());
+    }
+    template<int WS>
+    inline const ac_int<WS, S> slc(signed index) const {
+        return slc<WS>((unsigned) (index & ((unsigned) ~0 >> 1)));
+    }
+    template<int WS>
+    inline const ac_int<WS, S> slc(unsigned uindex) const {
+        typedef typename ac_int<WS, S>::storage_t r_T;
+        ac_int<WS, S> r;
+        r.v = ac_fast::wrap<WS, S>((r_T) ac_fast::shr(v, uindex));
+        return r;
+    }
+
+    template<int W2, bool S2, int WX, bool SX>
+    inline ac_fixed &set_slc(const ac_int<WX, SX> lsb, const ac_int<W2, S2> &slc) {
+        return set_slc(ac_int<WX - SX, false>(lsb).to_uint(), slc);
+    }
+    template<int W2, bool S2>
+    inline ac_fixed &set_slc(signed lsb, const ac_int<W2, S2> &slc) {
+        return set_slc((unsigned) (lsb & ((unsigned) ~0 >> 1)), slc);
+    }
+    template<int W2, bool S2>
+    inline ac_fixed &set_slc(unsigned ulsb, const ac_int<W2, S2> &slc) {
+        if (W == W2) v = ac_fast::wrap<W, S>((storage_t) slc.v);
+        else v = ac_fast::wrap<W, S>(ac_fast::set_bits<W2>(v, ulsb, slc.v));
+        return *this;
+    }
+
+    class ac_bitref {
+        ac_fixed &d_bv;
+        unsigned d_index;
+      public:
+        ac_bitref(ac_fixed *bv, unsigned index = 0) : d_bv(*bv), d_index(index) {}
+        operator bool () const { return d_index < W ? (bool) (ac_fast::shr(d_bv.v, d_index) & 1) : false; }
+
+        inline ac_bitref operator =(int val) {
+            if (d_index < W) d_bv.v = ac_fast::wrap<W, S>(ac_fast::set_bits<1>(d_bv.v, d_index, val & 1));
+            return *this;
+        }
+        template<int W2, bool S2>
+        inline ac_bitref operator =(const ac_int<W2, S2> &val) { return operator =(val.to_int()); }
+        inline ac_bitref operator =(const ac_bitref &val) { return operator =((int) (bool) val); }
+    };
+
+    ac_bitref operator [](unsigned int uindex) { return ac_bitref(this, uindex); }
+    ac_bitref operator [](int index) { return ac_bitref(this, index & ((unsigned) ~0 >> 1)); }
+    template<int W2, bool S2>
+    ac_bitref operator [](const ac_int<W2, S2> &index) { return ac_bitref(this, ac_int<W2 - S2, false>(index).to_uint()); }
+    bool operator [](unsigned int uindex) const { return uindex < W ? (bool) (ac_fast::shr(v, uindex) & 1) : false; }
+    bool operator [](int index) const { return operator []((unsigned) (index & ((unsigned) ~0 >> 1))); }
+    template<int W2, bool S2>
+    bool operator [](const ac_int<W2, S2> &index) const { return operator [](ac_int<W2 - S2, false>(index).to_uint()); }
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline std::ostream &operator <<(std::ostream &os, const ac_fixed<W, I, S, Q, O> &x) {
+    os << x.to_double();
+    return os;
+}
+
+// Mixed operators with C integers ---------------------------------------------
+
+#define AC_FAST_FX_BIN_OP_WITH_INT_2I(BIN_OP, C_TYPE, WI, SI) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline ac_fixed<W, I, S, Q, O> operator BIN_OP (const ac_fixed<W, I, S, Q, O> &op, C_TYPE i_op) { \
+        return op.operator BIN_OP (ac_int<WI, SI>(i_op)); \
+    }
+
+#define AC_FAST_FX_BIN_OP_WITH_INT(BIN_OP, C_TYPE, WI, SI, RTYPE) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline typename ac_fixed<WI, WI, SI>::template rt<W, I, S>::RTYPE operator BIN_OP (C_TYPE i_op, const ac_fixed<W, I, S, Q, O> &op) { \
+        return ac_fixed<WI, WI, SI>(i_op).operator BIN_OP (op); \
+    } \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline typename ac_fixed<W, I, S>::template rt<WI, WI, SI>::RTYPE operator BIN_OP (const ac_fixed<W, I, S, Q, O> &op, C_TYPE i_op) { \
+        return op.operator BIN_OP (ac_fixed<WI, WI, SI>(i_op)); \
+    }
+
+#define AC_FAST_FX_REL_OP_WITH_INT(REL_OP, C_TYPE, W2, S2) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline bool operator REL_OP (const ac_fixed<W, I, S, Q, O> &op, C_TYPE op2) { \
+        return op.operator REL_OP (ac_fixed<W2, W2, S2>(op2)); \
+    } \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline bool operator REL_OP (C_TYPE op2, const ac_fixed<W, I, S, Q, O> &op) { \
+        return ac_fixed<W2, W2, S2>(op2).operator REL_OP (op); \
+    }
+
+#define AC_FAST_FX_ASSIGN_OP_WITH_INT_2(ASSIGN_OP, C_TYPE, W2, S2) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline ac_fixed<W, I, S, Q, O> &operator ASSIGN_OP (ac_fixed<W, I, S, Q, O> &op, C_TYPE op2) { \
+        return op.operator ASSIGN_OP (ac_fixed<W2, W2, S2>(op2)); \
+    }
+
+#define AC_FAST_FX_ASSIGN_OP_WITH_INT_2I(ASSIGN_OP, C_TYPE, W2, S2) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
+    inline ac_fixed<W, I, S> operator ASSIGN_OP (ac_fixed<W, I, S, Q, O> &op, C_TYPE op2) { \
+        return op.operator ASSIGN_OP (ac_int<W2, S2>(op2)); \
+    }
+
+#define AC_FAST_FX_OPS_WITH_INT(C_TYPE, WI, SI) \
+    AC_FAST_FX_BIN_OP_WITH_INT(*, C_TYPE, WI, SI, mult) \
+    AC_FAST_FX_BIN_OP_WITH_INT(+, C_TYPE, WI, SI, plus) \
+    AC_FAST_FX_BIN_OP_WITH_INT(-, C_TYPE, WI, SI, minus) \
+    AC_FAST_FX_BIN_OP_WITH_INT(/, C_TYPE, WI, SI, div) \
+    AC_FAST_FX_BIN_OP_WITH_INT_2I(>>, C_TYPE, WI, SI) \
+    AC_FAST_FX_BIN_OP_WITH_INT_2I(<<, C_TYPE, WI, SI) \
+    AC_FAST_FX_BIN_OP_WITH_INT(&, C_TYPE, WI, SI, logic) \
+    AC_FAST_FX_BIN_OP_WITH_INT(|, C_TYPE, WI, SI, logic) \
+    AC_FAST_FX_BIN_OP_WITH_INT(^, C_TYPE, WI, SI, logic) \
+    \
+    AC_FAST_FX_REL_OP_WITH_INT(==, C_TYPE, WI, SI) \
+    AC_FAST_FX_REL_OP_WITH_INT(!=, C_TYPE, WI, SI) \
+    AC_FAST_FX_REL_OP_WITH_INT(>, C_TYPE, WI, SI) \
+    AC_FAST_FX_REL_OP_WITH_INT(>=, C_TYPE, WI, SI) \
+    AC_FAST_FX_REL_OP_WITH_INT(<, C_TYPE, WI, SI) \
+    AC_FAST_FX_REL_OP_WITH_INT(<=, C_TYPE, WI, SI) \
+    \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(+=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(-=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(*=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(/=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2I(>>=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2I(<<=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(&=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(|=, C_TYPE, WI, SI) \
+    AC_FAST_FX_ASSIGN_OP_WITH_INT_2(^=, C_TYPE, WI, SI)
+
+AC_FAST_FX_OPS_WITH_INT(bool, 1, false)
+AC_FAST_FX_OPS_WITH_INT(char, 8, true)
+AC_FAST_FX_OPS_WITH_INT(signed char, 8, true)
+AC_FAST_FX_OPS_WITH_INT(unsigned char, 8, false)
+AC_FAST_FX_OPS_WITH_INT(short, 16, true)
+AC_FAST_FX_OPS_WITH_INT(unsigned short, 16, false)
+AC_FAST_FX_OPS_WITH_INT(int, 32, true)
+AC_FAST_FX_OPS_WITH_INT(unsigned int, 32, false)
+AC_FAST_FX_OPS_WITH_INT(long, ac_fast::long_w, true)
+AC_FAST_FX_OPS_WITH_INT(unsigned long, ac_fast::long_w, false)
+AC_FAST_FX_OPS_WITH_INT(Slong, 64, true)
+AC_FAST_FX_OPS_WITH_INT(Ulong, 64, false)
+
+// Mixed operators with ac_int -------------------------------------------------
+
+#define AC_FAST_FX_BIN_OP_WITH_AC_INT(BIN_OP, RTYPE) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
+    inline typename ac_fixed<WI, WI, SI>::template rt<W, I, S>::RTYPE operator BIN_OP (const ac_int<WI, SI> &i_op, const ac_fixed<W, I, S, Q, O> &op) { \
+        return ac_fixed<WI, WI, SI>(i_op).operator BIN_OP (op); \
+    } \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
+    inline typename ac_fixed<W, I, S>::template rt<WI, WI, SI>::RTYPE operator BIN_OP (const ac_fixed<W, I, S, Q, O> &op, const ac_int<WI, SI> &i_op) { \
+        return op.operator BIN_OP (ac_fixed<WI, WI, SI>(i_op)); \
+    }
+
+#define AC_FAST_FX_REL_OP_WITH_AC_INT(REL_OP) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
+    inline bool operator REL_OP (const ac_fixed<W, I, S, Q, O> &op, const ac_int<WI, SI> &op2) { \
+        return op.operator REL_OP (ac_fixed<WI, WI, SI>(op2)); \
+    } \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
+    inline bool operator REL_OP (const ac_int<WI, SI> &op2, const ac_fixed<W, I, S, Q, O> &op) { \
+        return ac_fixed<WI, WI, SI>(op2).operator REL_OP (op); \
+    }
+
+#define AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(ASSIGN_OP) \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
+    inline ac_fixed<W, I, S, Q, O> &operator ASSIGN_OP (ac_fixed<W, I, S, Q, O> &op, const ac_int<WI, SI> &op2) { \
+        return op.operator ASSIGN_OP (ac_fixed<WI, WI, SI>(op2)); \
+    } \
+    template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
+    inline ac_int<WI, SI> &operator ASSIGN_OP (ac_int<WI, SI> &op, const ac_fixed<W, I, S, Q, O> &op2) { \
+        return op.operator ASSIGN_OP (op2.to_ac_int()); \
+    }
+
+AC_FAST_FX_BIN_OP_WITH_AC_INT(*, mult)
+AC_FAST_FX_BIN_OP_WITH_AC_INT(+, plus)
+AC_FAST_FX_BIN_OP_WITH_AC_INT(-, minus)
+AC_FAST_FX_BIN_OP_WITH_AC_INT(/, div)
+AC_FAST_FX_BIN_OP_WITH_AC_INT(&, logic)
+AC_FAST_FX_BIN_OP_WITH_AC_INT(|, logic)
+AC_FAST_FX_BIN_OP_WITH_AC_INT(^, logic)
+
+AC_FAST_FX_REL_OP_WITH_AC_INT(==)
+AC_FAST_FX_REL_OP_WITH_AC_INT(!=)
+AC_FAST_FX_REL_OP_WITH_AC_INT(>)
+AC_FAST_FX_REL_OP_WITH_AC_INT(>=)
+AC_FAST_FX_REL_OP_WITH_AC_INT(<)
+AC_FAST_FX_REL_OP_WITH_AC_INT(<=)
+
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(+=)
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(-=)
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(*=)
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(/=)
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(&=)
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(|=)
+AC_FAST_FX_ASSIGN_OP_WITH_AC_INT(^=)
+
+// Relational operators with double --------------------------------------------
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline bool operator ==(double op, const ac_fixed<W, I, S, Q, O> &op2) { return op2.operator ==(op); }
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline bool operator !=(double op, const ac_fixed<W, I, S, Q, O> &op2) { return op2.operator !=(op); }
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline bool operator >(double op, const ac_fixed<W, I, S, Q, O> &op2) { return op2.operator <(op); }
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline bool operator <(double op, const ac_fixed<W, I, S, Q, O> &op2) { return op2.operator >(op); }
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline bool operator <=(double op, const ac_fixed<W, I, S, Q, O> &op2) { return op2.operator >=(op); }
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+inline bool operator >=(double op, const ac_fixed<W, I, S, Q, O> &op2) { return op2.operator <=(op); }
+
+#endif
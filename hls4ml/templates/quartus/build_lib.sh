@@ -2,16 +2,53 @@
 
 CC=g++
 if [[ "$OSTYPE" == "linux-gnu" ]]; then
-    CFLAGS="-O3 -fPIC -std=c++11 -fno-gnu-unique"
+    CFLAGS="-O3 -fPIC -std=c++11 -fno-gnu-unique -DHLS4ML_FAST_AC_TYPES -DHLS4ML_SPLIT_LAYERS"
 elif [[ "$OSTYPE" == "darwin"* ]]; then
-    CFLAGS="-O3 -fPIC -std=c++11"
+    CFLAGS="-O3 -fPIC -std=c++11 -DHLS4ML_FAST_AC_TYPES -DHLS4ML_SPLIT_LAYERS"
 fi
 LDFLAGS=
 INCFLAGS="-Ifirmware/ac_types/ -Ifirmware/ap_types/"
 PROJECT=myproject
 LIB_STAMP=mystamp
 
-${CC} ${CFLAGS} ${INCFLAGS} -c firmware/${PROJECT}.cpp -o ${PROJECT}.o
-${CC} ${CFLAGS} ${INCFLAGS} -c ${PROJECT}_bridge.cpp -o ${PROJECT}_bridge.o
-${CC} ${CFLAGS} ${INCFLAGS} -shared ${PROJECT}.o ${PROJECT}_bridge.o -o firmware/${PROJECT}-${LIB_STAMP}.so
-rm -f *.o
\ No newline at end of file
+# Model-independent headers are precompiled, see build_pch.sh
+source build_pch.sh
+
+# Every layer is instantiated in its own translation unit (firmware/layers/), so the units are compiled in parallel
+# Object files are cached, keyed by the hash of the preprocessed source, compiler version and flags
+# Therefore, after a change to a single layer, only that layer (and the top-level function) is recompiled
+JOBS=${HLS4ML_BUILD_JOBS:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)}
+CACHE_DIR=${CACHE_ROOT}/objects
+if ! mkdir -p "${CACHE_DIR}" 2>/dev/null; then
+    CACHE_DIR=build_cache
+    mkdir -p "${CACHE_DIR}"
+fi
+BUILD_DIR=build_obj
+rm -rf ${BUILD_DIR}
+mkdir -p ${BUILD_DIR}
+
+compile_cached() {
+    local src=$1
+    local obj=${BUILD_DIR}/$(echo ${src%.cpp} | tr '/' '_').o
+    local key=$( { echo "${CC_VERSION} ${CFLAGS} ${INCFLAGS}"; ${CC} ${CFLAGS} ${INCFLAGS} -E -P ${src}; } | ${HASH} | cut -d ' ' -f 1 )
+    local cached=${CACHE_DIR}/${key}.o
+    if [ ! -f ${cached} ]; then
+        ${CC} ${CFLAGS} ${INCFLAGS} -c ${src} -o ${cached}.$$ || { rm -f ${cached}.$$; return 1; }
+        mv -f ${cached}.$$ ${cached}
+    fi
+    touch ${cached}
+    cp ${cached} ${obj}
+}
+export -f compile_cached
+export CC CFLAGS INCFLAGS BUILD_DIR CACHE_DIR HASH CC_VERSION
+
+ls firmware/layers/*.cpp firmware/${PROJECT}.cpp ${PROJECT}_bridge.cpp 2>/dev/null | \
+    xargs -n 1 -P ${JOBS} bash -c 'compile_cached "$1"' _ || { rm -rf ${BUILD_DIR}; exit 1; }
+
+${CC} ${CFLAGS} ${INCFLAGS} -shared ${BUILD_DIR}/*.o -o firmware/${PROJECT}-${LIB_STAMP}.so
+RET=$?
+rm -rf ${BUILD_DIR}
+
+# Objects that have not been used for 30 days are removed from the cache
+find ${CACHE_DIR} -name '*.o' -mtime +30 -delete 2>/dev/null
+exit ${RET}
@@ -12,8 +12,12 @@
 
 #ifndef __INTELFPGA_COMPILER__
 
+#ifdef HLS4ML_FAST_AC_TYPES
+#include "ac_fast.h"
+#else
 #include "ac_int.h"
 #include "ac_fixed.h"
+#endif
 #define hls_register
 
 #include "stream.h"
@@ -42,13 +46,17 @@ using stream_out = ihc::stream_out<T>;
 // Include nnet::array - a custom array-like struct, mainly used with io_stream
 #include "nnet_utils/nnet_types.h"
 
+// Translation units of individual layers (firmware/layers/) define their own numbers and types
+#ifndef HLS4ML_LAYER_UNIT
 //hls-fpga-machine-learning insert numbers
 
 
 //hls-fpga-machine-learning insert layer-precision
 
+#endif
 
 #define DIV_ROUNDUP(n,d) ((n + d - 1) / d)
 #define MIN(n,d) (n > d ? d : n)
+#define MAX(n,d) (n > d ? n : d)
 
 #endif
@@ -21,8 +21,12 @@
 #define MYPROJECT_H_
 
 #ifndef __INTELFPGA_COMPILER__
+#ifdef HLS4ML_FAST_AC_TYPES
+#include "ac_fast.h"
+#else
 #include "ac_int.h"
 #include "ac_fixed.h"
+#endif
 #define hls_register
 #else
 #include "HLS/hls.h"
@@ -21,8 +21,12 @@
 #define NNET_COMMON_H_
 
 #ifndef __INTELFPGA_COMPILER__
+#ifdef HLS4ML_FAST_AC_TYPES
+#include "ac_fast.h"
+#else
 #include "ac_int.h"
 #include "ac_fixed.h"
+#endif
 #include "math.h"
 #else
 #include "HLS/ac_int.h"
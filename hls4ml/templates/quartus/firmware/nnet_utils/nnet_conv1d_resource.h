@@ -3,6 +3,7 @@
 
 #include "nnet_common.h"
 #include "nnet_dense.h"
+#include "nnet_winograd.h"
 
 namespace nnet {
 
@@ -72,32 +73,32 @@ void conv_1d_im2col_cl(
 }
 
 // ****************************************************************
-//       1D Convolution for 3x1 kernels from Winograd's algoirithm
+//       1D Convolution from Winograd's minimal filtering algorithm
 // ****************************************************************
 
-// Explicity transofrmed input (B'dB) needed for Winograd convolution, as explained by Lavin & Gray (2015)
-template<typename data_T, typename res_T>
-inline void winograd_transform_input_tile_3x1_kernel(const data_T I[4], res_T D[4]) {
-    D[0] = I[0]-I[2];
-    D[1] = I[1]+I[2];
-    D[2] = -I[1]+I[2];
-    D[3] = I[1]-I[3];
-}
-
+/*
+* F(M, R) computes a tile of M outputs from an (M + R - 1)-wide input tile, with M + R - 1 multiplications instead of M * R
+* The tile size M is CONFIG_T::winograd_tile, chosen by the backend; the weights are transformed (G g) offline
+* The input tiles are transformed in CONFIG_T::winograd_t and the output tiles in CONFIG_T::winograd_accum_t,
+* both widened by the backend to hold the growth of the transformations
+*/
 template<class data_T, class res_T, typename CONFIG_T>
-void winograd_conv1d_3x1_kernel_cl(
+void winograd_conv1d_cl(
     data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
     res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
     const typename CONFIG_T::weight_t weights[CONFIG_T::impl_filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
     const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
 ) {
+    static constexpr int m = CONFIG_T::winograd_tile;
+    static constexpr int n = CONFIG_T::impl_filt_width;
+
     // Ensure Winograd conditions are met
-    assert(CONFIG_T::filt_width == 3);
+    assert(CONFIG_T::impl_filt_width == CONFIG_T::winograd_tile + CONFIG_T::filt_width - 1);
     assert(CONFIG_T::stride_width == 1);
-    assert(CONFIG_T::out_width > 2);
+    assert(CONFIG_T::out_width > CONFIG_T::winograd_tile);
     
     // Unroll factor for loop traversing input image, derived from parallelisation_factor
-    static constexpr int pf = MIN(CONFIG_T::parallelisation_factor, CONFIG_T::out_width);
+    static constexpr int pf = MIN(CONFIG_T::parallelisation_factor, DIV_ROUNDUP(CONFIG_T::out_width, m));
 
     // Initialise result to bias
     // Unroll fully, as loop performs a simple operation - assigning the outputs to a constant value
@@ -112,42 +113,47 @@ void winograd_conv1d_3x1_kernel_cl(
 
     WidthLoop:
     #pragma unroll pf
-    for (int col = 0; col < CONFIG_T::out_width; col+=2) {            
+    for (int col = 0; col < CONFIG_T::out_width; col += m) {
         ChannelLoop:
         #pragma unroll
         for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {                   
-            // Get current 4x1 tile    
-            hls_register data_T T[16];
-            hls_register uint8_t p = 0;
+            // Get current input tile; the last tile may extend past the input, which is zero-padded
+            hls_register data_T T[n];
             
             #pragma unroll
-            for (int c = col - (int) CONFIG_T::pad_left ; c < col + 4 - (int) CONFIG_T::pad_left; c++) {
+            for (int i = 0; i < n; i++) {
+                hls_register int c = col + i - (int) CONFIG_T::pad_left;
                 if (c < CONFIG_T::in_width && c >= 0) {
-                    T[p++] = data[c * CONFIG_T::n_chan + channel];
+                    T[i] = data[c * CONFIG_T::n_chan + channel];
                 } else {
-                    T[p++] = 0;
+                    T[i] = 0;
                 }
             }
 
             // Transform input tile
-            hls_register typename CONFIG_T::accum_t D[4];
-            winograd_transform_input_tile_3x1_kernel<data_T, typename CONFIG_T::accum_t>(T, D);
+            hls_register typename CONFIG_T::winograd_t D[n];
+            winograd_transform_input_tile_1d<data_T, typename CONFIG_T::winograd_t, m, CONFIG_T::filt_width>(T, D);
 
             #pragma unroll
             for (int filter = 0 ; filter < CONFIG_T::n_filt; filter++) {    
-                hls_register int filter_offset = 4 * (CONFIG_T::n_chan * filter + channel); 
+                hls_register int filter_offset = n * (CONFIG_T::n_chan * filter + channel); 
 
                 // Hadamard product between transformed input tile and kernel
-                hls_register typename CONFIG_T::accum_t Y[4];
+                hls_register typename CONFIG_T::winograd_accum_t Y[n];
                 #pragma unroll
-                for (int i = 0 ; i < 4 ; i++) {
-                    Y[i] = static_cast<typename CONFIG_T::accum_t>(D[i] * weights[filter_offset + i]);
+                for (int i = 0 ; i < n ; i++) {
+                    Y[i] = static_cast<typename CONFIG_T::winograd_accum_t>(D[i] * weights[filter_offset + i]);
                 }
 
-                // Explicitly transform intermediate result Z = A'YA and save to output
-                res[CONFIG_T::n_filt * col + filter] += static_cast<res_T>(Y[0]+Y[1]+Y[2]);
-                if ((col + 1) < CONFIG_T::out_width)
-                    res[CONFIG_T::n_filt * (col + 1) + filter] += static_cast<res_T>(Y[1]-Y[2]-Y[3]);
+                // Transform intermediate result Z = A'Y and save to output
+                hls_register typename CONFIG_T::winograd_accum_t Z[m];
+                winograd_transform_output_tile_1d<typename CONFIG_T::winograd_accum_t, typename CONFIG_T::winograd_accum_t, m, CONFIG_T::filt_width>(Y, Z);
+                
+                #pragma unroll
+                for (int i = 0; i < m; i++) {
+                    if ((col + i) < CONFIG_T::out_width)
+                        res[CONFIG_T::n_filt * (col + i) + filter] += static_cast<res_T>(Z[i]);
+                }
             }
         }
     }   
@@ -214,28 +220,25 @@ void pointwise_conv_1d_resource_cl(
 // ****************************************************************
 //      Top-level function - handles different implementations
 // ****************************************************************
+// The backend decides between im2col and Winograd (winograd_tile > 0), since the weights are transformed accordingly
 template<class data_T, class res_T, typename CONFIG_T>
-void conv_1d_resource_cl(
+typename std::enable_if<CONFIG_T::winograd_tile == 0>::type conv_1d_resource_cl(
     data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
     res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
     const typename CONFIG_T::weight_t weights[CONFIG_T::impl_filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
     const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
 ) {
-    static constexpr bool winograd_conditions = 
-                                                // Winograd's minimal filtering algorithm not applicable to stride != 1
-                                                CONFIG_T::stride_width == 1 &&         
-
-                                                // Intel HLS will fail to pipeline the entire component if the Winograd loop only runs once
-                                                CONFIG_T::out_width > 2 &&
+    conv_1d_im2col_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+}
 
-                                                // Verify user opted for Winograd
-                                                CONFIG_T::implementation == nnet::conv1d_implementation::combination || CONFIG_T::implementation == nnet::conv1d_implementation::winograd;
-    
-    if (CONFIG_T::filt_width == 3 && winograd_conditions) {
-        winograd_conv1d_3x1_kernel_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
-    } else {
-        conv_1d_im2col_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
-    }
+template<class data_T, class res_T, typename CONFIG_T>
+typename std::enable_if<(CONFIG_T::winograd_tile > 0)>::type conv_1d_resource_cl(
+    data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::impl_filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
+) {
+    winograd_conv1d_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
 }
 
 }
@@ -0,0 +1,136 @@
+#ifndef NNET_CONV1D_STREAM_H_
+#define NNET_CONV1D_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+// ****************************************************************
+//       Streaming 1D Convolution with a sliding kernel window
+// ****************************************************************
+
+/*
+* The kernel window holds the last filt_width pixels of the (padded) input
+* Every incoming pixel shifts the window by one pixel to the left
+* An output pixel is computed whenever the window is aligned with the stride
+* Padding is inserted by the kernel itself, so no separate padding layer is needed
+*/
+
+template<class data_T, typename CONFIG_T>
+inline void kernel_shift_1d(
+    const data_T &in_elem,
+    typename data_T::value_type kernel_window[CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+    // Shift kernel_window by one step to the left
+    KernelShiftWidth:
+    #pragma unroll
+    for (int col = 0; col < CONFIG_T::filt_width - 1; col++) {
+        KernelShiftChannel:
+        #pragma unroll
+        for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+            kernel_window[col * CONFIG_T::n_chan + channel] = kernel_window[(col + 1) * CONFIG_T::n_chan + channel];
+        }
+    }
+
+    // Insert the new pixel into the right-most column of the kernel
+    KernelPushChannel:
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        kernel_window[(CONFIG_T::filt_width - 1) * CONFIG_T::n_chan + channel] = in_elem[channel];
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline void compute_output_buffer_1d(
+    const data_T &in_elem,
+    stream<res_T> &res_stream,
+    typename data_T::value_type kernel_window[CONFIG_T::filt_width * CONFIG_T::n_chan],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt],
+    int &pX,
+    int &sX
+) {
+    // Thresholds
+    static constexpr int lShiftX = CONFIG_T::filt_width - 1;
+
+    // Add pixel to the kernel window
+    kernel_shift_1d<data_T, CONFIG_T>(in_elem, kernel_window);
+
+    // Check to see if we have a full kernel
+    if ((sX - lShiftX) == 0 && pX > lShiftX - 1) {
+        // Dense multiply
+        hls_register typename res_T::value_type res_out[CONFIG_T::n_filt];
+        dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_window, res_out, weights, biases);
+
+        // Pack output
+        hls_register res_T res_pack;
+        CastLoop:
+        #pragma unroll
+        for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+            res_pack[filter] = res_out[filter];
+        }
+
+        // Write output to stream when output ready
+        res_stream.write(res_pack);
+    }
+
+    // Counter housekeeping; the end of the padded row resets the counters
+    if (pX + 1 == CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right) {
+        pX = 0;
+        sX = 0;
+    } else {
+        pX = pX + 1;
+        // Update stride (threshold) ? subtract stride : increment stride
+        sX = ((sX - lShiftX) == 0) ? sX - CONFIG_T::stride_width + 1 : sX + 1;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res,
+    const typename CONFIG_T::weight_t weights[CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
+) {
+    // Streaming convolution performs no filter transformations (e.g. Winograd)
+    assert(CONFIG_T::filt_width == CONFIG_T::impl_filt_width);
+
+    // Kernel window, in the same layout as the im2col columns
+    hls_register typename data_T::value_type kernel_window[CONFIG_T::filt_width * CONFIG_T::n_chan];
+
+    // Counters
+    int pX = 0;
+    int sX = 0;
+
+    // Zero pixel, inserted for the padding
+    hls_register data_T padds;
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        padds[channel] = 0;
+    }
+
+    ReadInputWidth:
+    #pragma ii CONFIG_T::reuse_factor
+    for (int col = 0; col < CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right; col++) {
+        bool is_padding = col < CONFIG_T::pad_left || col >= CONFIG_T::pad_left + CONFIG_T::in_width;
+        data_T in_elem = is_padding ? padds : data.read();
+        compute_output_buffer_1d<data_T, res_T, CONFIG_T>(in_elem, res, kernel_window, weights, biases, pX, sX);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pointwise_conv_1d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res,
+    const typename CONFIG_T::weight_t weights[CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
+) {
+    assert(CONFIG_T::filt_width == 1);
+    conv_1d_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+}
+
+}
+
+#endif
@@ -25,6 +25,9 @@ struct conv2d_config {
     static const unsigned impl_filt_height = 1;
     static const unsigned impl_filt_width = 1;
 
+    // Output tile size of the Winograd algorithm, F(winograd_tile, filt_width); 0 if im2col is used
+    static const unsigned winograd_tile = 0;
+
     // Padding, stride, dilation
     static const unsigned pad_top = 0;
     static const unsigned pad_bottom = 0;
@@ -47,6 +50,8 @@ struct conv2d_config {
     typedef float bias_t;
     typedef float weight_t;
     typedef float accum_t;
+    typedef float winograd_t;
+    typedef float winograd_accum_t;
 };
 
 template<class data_T, class res_T, typename CONFIG_T>
@@ -3,6 +3,7 @@
 
 #include "nnet_common.h"
 #include "nnet_dense.h"
+#include "nnet_winograd.h"
 #include "nnet_helpers.h"
 
 namespace nnet {
@@ -91,50 +92,36 @@ void conv_2d_im2col_cl(
 }
 
 // ****************************************************************
-//       2D Convolution for 3x3 kernels from Winograd's algoirithm
+//       2D Convolution from Winograd's minimal filtering algorithm
 // ****************************************************************
 
-// Explicity transofrmed input (B'dB) needed for Winograd calculation, as explained by Lavin & Gray, 2015
-template<typename data_T, typename res_T>
-inline void winograd_transform_input_tile_3x3_kernel(const data_T I[16], res_T D[16]) {
-    D[0] = I[0]-I[2]-I[8]+I[10];
-    D[1] = I[1]+I[2]-I[9]-I[10];
-    D[2] = -I[1]+I[2]+I[9]-I[10];
-    D[3] = I[1]-I[3]-I[9]+I[11];
-
-    D[4] = I[4]-I[6]+I[8]-I[10];
-    D[5] = I[5]+I[6]+I[9]+I[10];
-    D[6] = -I[5]+I[6]-I[9]+I[10];
-    D[7] = I[5]-I[7]+I[9]-I[11];
-
-    D[8] = -I[4]+I[6]+I[8]-I[10];
-    D[9] = -I[5]-I[6]+I[9]+I[10];
-    D[10] = I[5]-I[6]-I[9]+I[10];
-    D[11] = -I[5]+I[7]+I[9]-I[11];
-
-    D[12] = I[4]-I[6]-I[12]+I[14];
-    D[13] = I[5]+I[6]-I[13]-I[14];
-    D[14] = I[6]-I[5]+I[13]-I[14];
-    D[15] = I[5]-I[7]-I[13]+I[15];
-}
-
+/*
+* F(M x M, R x R) computes an M x M tile of outputs from an (M + R - 1) x (M + R - 1) input tile,
+* with (M + R - 1)^2 multiplications instead of M^2 * R^2
+* The tile size M is CONFIG_T::winograd_tile, chosen by the backend; the weights are transformed (G g G') offline
+* The input tiles are transformed in CONFIG_T::winograd_t and the output tiles in CONFIG_T::winograd_accum_t,
+* both widened by the backend to hold the growth of the transformations
+*/
 template<class data_T, class res_T, typename CONFIG_T>
-void winograd_conv2d_3x3_kernel_cl(
+void winograd_conv2d_cl(
     data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
     res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
     const typename CONFIG_T::weight_t weights[CONFIG_T::n_filt * CONFIG_T::n_chan * CONFIG_T::impl_filt_height * CONFIG_T::impl_filt_width],
     const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
 ) {
+    static constexpr int m = CONFIG_T::winograd_tile;
+    static constexpr int n = CONFIG_T::impl_filt_width;
+
     // Ensure Winograd conditions are met
-    assert(CONFIG_T::filt_height == 3 && CONFIG_T::filt_width == 3);
+    assert(CONFIG_T::filt_height == CONFIG_T::filt_width);
+    assert(CONFIG_T::impl_filt_height == n && CONFIG_T::impl_filt_width == CONFIG_T::winograd_tile + CONFIG_T::filt_width - 1);
     assert(CONFIG_T::stride_height == 1 && CONFIG_T::stride_width == 1);
-    assert(CONFIG_T::pad_left == CONFIG_T::pad_right && CONFIG_T::pad_top == CONFIG_T::pad_bottom);
-    assert(CONFIG_T::out_height > 2 && CONFIG_T::out_width > 2);
+    assert(CONFIG_T::out_height > CONFIG_T::winograd_tile && CONFIG_T::out_width > CONFIG_T::winograd_tile);
     
     // Unroll factor for loop traversing input image, derived from parallelisation_factor
     // Outer loop only gets unrolled after inner loop is fully unrolled
-    static constexpr int pfc = MIN(CONFIG_T::parallelisation_factor, DIV_ROUNDUP(CONFIG_T::out_width, 2));
-    static constexpr int pfr = MIN((CONFIG_T::parallelisation_factor / pfc), DIV_ROUNDUP(CONFIG_T::out_height, 2));
+    static constexpr int pfc = MIN(CONFIG_T::parallelisation_factor, DIV_ROUNDUP(CONFIG_T::out_width, m));
+    static constexpr int pfr = MIN((CONFIG_T::parallelisation_factor / pfc), DIV_ROUNDUP(CONFIG_T::out_height, m));
 
     // Initialise result to bias
     // Unroll fully, as loop performs a simple operation - assigning the outputs to a constant value
@@ -149,52 +136,57 @@ void winograd_conv2d_3x3_kernel_cl(
 
     HeightLoop:
     #pragma unroll pfr
-    for (int row = 0; row < CONFIG_T::out_height; row+=2) {
+    for (int row = 0; row < CONFIG_T::out_height; row += m) {
         WidthLoop:
         #pragma unroll pfc
-        for (int col = 0; col < CONFIG_T::out_width; col+=2) {            
+        for (int col = 0; col < CONFIG_T::out_width; col += m) {
             ChannelLoop:
             #pragma unroll
             for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {                   
-                // Get current 4x4 tile    
-                hls_register data_T T[16];
-                hls_register typename CONFIG_T::accum_t D[16];
-                hls_register uint8_t p = 0;
+                // Get current input tile; the last tiles may extend past the input, which is zero-padded
+                hls_register data_T T[n * n];
                 
                 #pragma unroll
-                for (int r = row - (int) CONFIG_T::pad_top ; r < row + 4 - (int) CONFIG_T::pad_top ; r++) {
+                for (int i = 0; i < n; i++) {
                     #pragma unroll
-                    for (int c = col - (int) CONFIG_T::pad_left ; c < col + 4 - (int) CONFIG_T::pad_left; c++) {
+                    for (int j = 0; j < n; j++) {
+                        hls_register int r = row + i - (int) CONFIG_T::pad_top;
+                        hls_register int c = col + j - (int) CONFIG_T::pad_left;
                         if (r < CONFIG_T::in_height && r >= 0 && c < CONFIG_T::in_width && c >= 0) {
-                            T[p++] = data[r * CONFIG_T::in_width * CONFIG_T::n_chan + c * CONFIG_T::n_chan + channel];
+                            T[i * n + j] = data[r * CONFIG_T::in_width * CONFIG_T::n_chan + c * CONFIG_T::n_chan + channel];
                         } else {
-                            T[p++] = 0;
+                            T[i * n + j] = 0;
                         }
                     }
                 }
 
                 // Transform input tile
-                winograd_transform_input_tile_3x3_kernel<data_T, typename CONFIG_T::accum_t>(T, D);
+                hls_register typename CONFIG_T::winograd_t D[n * n];
+                winograd_transform_input_tile_2d<data_T, typename CONFIG_T::winograd_t, m, CONFIG_T::filt_width>(T, D);
 
                 #pragma unroll
                 for (int filter = 0 ; filter < CONFIG_T::n_filt; filter++) {    
-                    hls_register int filter_offset = 16 * (CONFIG_T::n_chan * filter + channel); 
+                    hls_register int filter_offset = n * n * (CONFIG_T::n_chan * filter + channel); 
 
                     // Hadamard product between transformed input tile and kernel
-                    hls_register typename CONFIG_T::accum_t Y[16];
+                    hls_register typename CONFIG_T::winograd_accum_t Y[n * n];
                     #pragma unroll
-                    for (int i = 0 ; i < 16 ; i++) {
-                        Y[i] = static_cast<typename CONFIG_T::accum_t>(D[i] * weights[filter_offset + i]);
+                    for (int i = 0 ; i < n * n ; i++) {
+                        Y[i] = static_cast<typename CONFIG_T::winograd_accum_t>(D[i] * weights[filter_offset + i]);
                     }
 
-                    // Explicitly transform intermediate result Z = A'YA and save to output
-                    res[CONFIG_T::n_filt * (row * CONFIG_T::out_width + col) + filter] += static_cast<res_T>(Y[0]+Y[1]+Y[2]+Y[4]+Y[5]+Y[6]+Y[8]+Y[9]+Y[10]);
-                    if ((col + 1) < CONFIG_T::out_height)
-                        res[CONFIG_T::n_filt * (row * CONFIG_T::out_width + (col + 1)) + filter] += static_cast<res_T>(Y[1]-Y[2]-Y[3]+Y[5]-Y[6]-Y[7]+Y[9]-Y[10]-Y[11]);
-                    if ((row + 1) < CONFIG_T::out_width)
-                        res[CONFIG_T::n_filt * ((row + 1) * CONFIG_T::out_width + col) + filter] += static_cast<res_T>(Y[4]+Y[5]+Y[6]-Y[8]-Y[9]-Y[10]-Y[12]-Y[13]-Y[14]);
-                    if ((row + 1) < (CONFIG_T::out_width) && (col + 1) < CONFIG_T::out_height)
-                        res[CONFIG_T::n_filt * ((row + 1) * CONFIG_T::out_width + (col + 1)) + filter] += static_cast<res_T>(Y[5]-Y[6]-Y[7]-Y[9]+Y[10]+Y[11]+Y[15]-Y[13]+Y[14]);
+                    // Transform intermediate result Z = A'YA and save to output
+                    hls_register typename CONFIG_T::winograd_accum_t Z[m * m];
+                    winograd_transform_output_tile_2d<typename CONFIG_T::winograd_accum_t, typename CONFIG_T::winograd_accum_t, m, CONFIG_T::filt_width>(Y, Z);
+
+                    #pragma unroll
+                    for (int i = 0; i < m; i++) {
+                        #pragma unroll
+                        for (int j = 0; j < m; j++) {
+                            if ((row + i) < CONFIG_T::out_height && (col + j) < CONFIG_T::out_width)
+                                res[CONFIG_T::n_filt * ((row + i) * CONFIG_T::out_width + (col + j)) + filter] += static_cast<res_T>(Z[i * m + j]);
+                        }
+                    }
                 }
             }
         }
@@ -273,28 +265,25 @@ void pointwise_conv_2d_resource_cl(
 // ****************************************************************
 //      Top-level function - handles different implementations
 // ****************************************************************
+// The backend decides between im2col and Winograd (winograd_tile > 0), since the weights are transformed accordingly
 template<class data_T, class res_T, typename CONFIG_T>
-void conv_2d_resource_cl(
+typename std::enable_if<CONFIG_T::winograd_tile == 0>::type conv_2d_resource_cl(
     data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
     res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
     const typename CONFIG_T::weight_t weights[CONFIG_T::impl_filt_height * CONFIG_T::impl_filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
     const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
 ) {
-    static constexpr bool winograd_conditions = 
-                                                // Winograd's minimal filtering algorithm not applicable to stride != 1
-                                                CONFIG_T::stride_height == 1 && CONFIG_T::stride_width == 1 &&         
-
-                                                // Intel HLS will fail to pipeline the entire component if the Winograd loop only runs once
-                                                CONFIG_T::out_height > 2 && CONFIG_T::out_width > 2 &&
-
-                                                // Verify user opted for Winograd
-                                                CONFIG_T::implementation == nnet::conv2d_implementation::combination || CONFIG_T::implementation == nnet::conv2d_implementation::winograd;
+    conv_2d_im2col_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+}
 
-    if (CONFIG_T::filt_height == 3 && CONFIG_T::filt_width == 3 && winograd_conditions) {
-        winograd_conv2d_3x3_kernel_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
-    } else {
-        conv_2d_im2col_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
-    }
+template<class data_T, class res_T, typename CONFIG_T>
+typename std::enable_if<(CONFIG_T::winograd_tile > 0)>::type conv_2d_resource_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::impl_filt_height * CONFIG_T::impl_filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
+) {
+    winograd_conv2d_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
 }
 
 }
@@ -0,0 +1,194 @@
+#ifndef NNET_CONV2D_STREAM_H_
+#define NNET_CONV2D_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+// ****************************************************************
+//       Streaming 2D Convolution with line buffers
+// ****************************************************************
+
+/*
+* The line buffers hold the last (filt_height - 1) rows of the (padded) input, one shift register per row and channel
+* Every incoming pixel is shifted into the line buffers, popping the pixels above it, which form the new kernel column
+* An output pixel is computed whenever the kernel window is aligned with the strides
+* Memory usage is therefore O(filt_height * in_width * n_chan), instead of the full feature map
+* Padding is inserted by the kernel itself, so no separate padding layer is needed
+*/
+
+template<class data_T, typename CONFIG_T>
+inline void kernel_shift_2d(
+    typename data_T::value_type shift_buffer[CONFIG_T::filt_height][CONFIG_T::n_chan],
+    typename data_T::value_type kernel_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+    // Shift kernel_window by one step to the left
+    KernelShiftWidth:
+    #pragma unroll
+    for (int col = 0; col < CONFIG_T::filt_width - 1; col++) {
+        KernelShiftHeight:
+        #pragma unroll
+        for (int row = 0; row < CONFIG_T::filt_height; row++) {
+            KernelShiftChannel:
+            #pragma unroll
+            for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+                kernel_window[row * CONFIG_T::filt_width * CONFIG_T::n_chan + col * CONFIG_T::n_chan + channel] = kernel_window[row * CONFIG_T::filt_width * CONFIG_T::n_chan + (col + 1) * CONFIG_T::n_chan + channel];
+            }
+        }
+    }
+
+    // Insert shift_buffer column into the right-most column of the kernel
+    KernelPushHeight:
+    #pragma unroll
+    for (int row = 0; row < CONFIG_T::filt_height; row++) {
+        KernelPushChannel:
+        #pragma unroll
+        for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+            kernel_window[row * CONFIG_T::filt_width * CONFIG_T::n_chan + (CONFIG_T::filt_width - 1) * CONFIG_T::n_chan + channel] = shift_buffer[row][channel];
+        }
+    }
+}
+
+template<class data_T, typename CONFIG_T>
+inline void shift_line_buffer_2d(
+    const data_T &in_elem,
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right> line_buffer[MAX(CONFIG_T::filt_height - 1, 1)][CONFIG_T::n_chan],
+    typename data_T::value_type kernel_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+    // Temporary buffer for the popped (shifted) elements, i.e. the new column of the kernel
+    hls_register typename data_T::value_type shift_buffer[CONFIG_T::filt_height][CONFIG_T::n_chan];
+
+    UpdateBuffer:
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        // Insert pixel at the bottom of the shift buffer
+        shift_buffer[CONFIG_T::filt_height - 1][channel] = in_elem[channel];
+    }
+
+    LineBufferDataIn:
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        // Shift the shift buffer into the line buffer
+        LineBufferShift:
+        #pragma unroll
+        for (int row = 1; row < CONFIG_T::filt_height; row++) {
+            // Shift the line buffer; the popped pixel is placed back into shift_buffer, one row up
+            shift_buffer[CONFIG_T::filt_height - row - 1][channel] = line_buffer[row - 1][channel].shift(shift_buffer[CONFIG_T::filt_height - row][channel]);
+        }
+    }
+
+    kernel_shift_2d<data_T, CONFIG_T>(shift_buffer, kernel_window);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline void compute_output_buffer_2d(
+    const data_T &in_elem,
+    stream<res_T> &res_stream,
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right> line_buffer[MAX(CONFIG_T::filt_height - 1, 1)][CONFIG_T::n_chan],
+    typename data_T::value_type kernel_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan],
+    const typename CONFIG_T::weight_t weights[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt],
+    int &pX,
+    int &pY,
+    int &sX,
+    int &sY
+) {
+    // Thresholds
+    static constexpr int lShiftX = CONFIG_T::filt_width - 1;
+    static constexpr int lShiftY = CONFIG_T::filt_height - 1;
+
+    // Add pixel to the line buffers and the kernel window
+    shift_line_buffer_2d<data_T, CONFIG_T>(in_elem, line_buffer, kernel_window);
+
+    // Check to see if we have a full kernel
+    if ((sX - lShiftX) == 0 && (sY - lShiftY) == 0 && pY > lShiftY - 1 && pX > lShiftX - 1) {
+        // Dense multiply
+        hls_register typename res_T::value_type res_out[CONFIG_T::n_filt];
+        dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_window, res_out, weights, biases);
+
+        // Pack output
+        hls_register res_T res_pack;
+        CastLoop:
+        #pragma unroll
+        for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+            res_pack[filter] = res_out[filter];
+        }
+
+        // Write output to stream when output ready
+        res_stream.write(res_pack);
+    }
+
+    // Counter housekeeping; the end of the padded row resets the column counters
+    if (pX + 1 == CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right) {
+        pX = 0;
+        sX = 0;
+        if (pY + 1 == CONFIG_T::pad_top + CONFIG_T::in_height + CONFIG_T::pad_bottom) {
+            pY = 0;
+            sY = 0;
+        } else {
+            pY = pY + 1;
+            // Update stride (threshold) ? subtract stride : increment stride
+            sY = ((sY - lShiftY) == 0) ? sY - CONFIG_T::stride_height + 1 : sY + 1;
+        }
+    } else {
+        pX = pX + 1;
+        // Update stride (threshold) ? subtract stride : increment stride
+        sX = ((sX - lShiftX) == 0) ? sX - CONFIG_T::stride_width + 1 : sX + 1;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res,
+    const typename CONFIG_T::weight_t weights[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
+) {
+    // Streaming convolution performs no filter transformations (e.g. Winograd)
+    assert(CONFIG_T::filt_height == CONFIG_T::impl_filt_height && CONFIG_T::filt_width == CONFIG_T::impl_filt_width);
+
+    // Line buffers and kernel window, in the same layout as the im2col columns
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right> line_buffer[MAX(CONFIG_T::filt_height - 1, 1)][CONFIG_T::n_chan];
+    hls_register typename data_T::value_type kernel_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
+
+    // Counters
+    int pX = 0;
+    int pY = 0;
+    int sX = 0;
+    int sY = 0;
+
+    // Zero pixel, inserted for the padding
+    hls_register data_T padds;
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        padds[channel] = 0;
+    }
+
+    ReadInputHeight:
+    for (int row = 0; row < CONFIG_T::pad_top + CONFIG_T::in_height + CONFIG_T::pad_bottom; row++) {
+        ReadInputWidth:
+        #pragma ii CONFIG_T::reuse_factor
+        for (int col = 0; col < CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right; col++) {
+            bool is_padding = row < CONFIG_T::pad_top || row >= CONFIG_T::pad_top + CONFIG_T::in_height || col < CONFIG_T::pad_left || col >= CONFIG_T::pad_left + CONFIG_T::in_width;
+            data_T in_elem = is_padding ? padds : data.read();
+            compute_output_buffer_2d<data_T, res_T, CONFIG_T>(in_elem, res, line_buffer, kernel_window, weights, biases, pX, pY, sX, sY);
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pointwise_conv_2d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res,
+    const typename CONFIG_T::weight_t weights[CONFIG_T::n_chan * CONFIG_T::n_filt],
+    const typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt]
+) {
+    assert(CONFIG_T::filt_height == 1 && CONFIG_T::filt_width == 1);
+    conv_2d_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+}
+
+}
+
+#endif
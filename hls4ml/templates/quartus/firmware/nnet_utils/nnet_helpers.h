@@ -37,6 +37,53 @@ template<typename T>
 using stream_in = nnet::stream<T>;
 template<typename T>
 using stream_out = nnet::stream<T>;
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+/*
+* Component invocation queue, with the same interface as Intel HLS ihc_hls_enqueue(...), ihc_hls_enqueue_noret(...) and ihc_hls_component_run_all(...)
+* This is used during GCC compilation / hls4ml model.predict(...), so a batch of inputs can be enqueued and processed in one run, as in the testbench
+* As with Intel HLS, arguments passed by value are copied when the invocation is enqueued, while arguments passed by reference (streams) are not
+*/
+namespace nnet {
+
+template<class arg_T, class param_T>
+typename std::conditional<std::is_reference<arg_T>::value,
+                          std::reference_wrapper<typename std::remove_reference<arg_T>::type>,
+                          typename std::decay<arg_T>::type>::type
+invocation_arg(param_T &param) {
+    return param;
+}
+
+template<class func_T>
+std::vector<std::function<void()>> &invocation_queue(func_T *component) {
+    static std::map<func_T *, std::vector<std::function<void()>>> queues;
+    return queues[component];
+}
+
+}
+
+template<class res_T, class... arg_T, class... param_T>
+void ihc_hls_enqueue(res_T *res, res_T (*component)(arg_T...), param_T &&... params) {
+    std::function<res_T()> call = std::bind(component, nnet::invocation_arg<arg_T>(params)...);
+    nnet::invocation_queue(component).push_back([res, call]() { *res = call(); });
+}
+
+template<class... arg_T, class... param_T>
+void ihc_hls_enqueue_noret(void (*component)(arg_T...), param_T &&... params) {
+    nnet::invocation_queue(component).push_back(std::bind(component, nnet::invocation_arg<arg_T>(params)...));
+}
+
+template<class func_T>
+void ihc_hls_component_run_all(func_T *component) {
+    std::vector<std::function<void()>> &queue = nnet::invocation_queue(component);
+    for (size_t i = 0; i < queue.size(); i++) {
+        queue[i]();
+    }
+    queue.clear();
+}
 #else
 #include "HLS/hls.h"
 #include "HLS/ac_int.h"
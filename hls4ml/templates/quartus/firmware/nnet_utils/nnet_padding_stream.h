@@ -0,0 +1,74 @@
+#ifndef NNET_PADDING_STREAM_H_
+#define NNET_PADDING_STREAM_H_
+
+#include "nnet_padding.h"
+
+namespace nnet {
+
+template<class res_T, typename CONFIG_T>
+inline void fill_zero(stream<res_T> &res) {
+    hls_register res_T res_part;
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        res_part[channel] = 0;
+    }
+    res.write(res_part);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline void fill_data(stream<data_T> &data, stream<res_T> &res) {
+    data_T data_part = data.read();
+    hls_register res_T res_part;
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+        res_part[channel] = data_part[channel];
+    }
+    res.write(res_part);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void zeropad1d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res
+) {
+    PadLeft:
+    #pragma ii 1
+    for (int i = 0; i < CONFIG_T::pad_left; i++) {
+        fill_zero<res_T, CONFIG_T>(res);
+    }
+
+    CopyMain:
+    #pragma ii 1
+    for (int i = 0; i < CONFIG_T::in_width; i++) {
+        fill_data<data_T, res_T, CONFIG_T>(data, res);
+    }
+
+    PadRight:
+    #pragma ii 1
+    for (int i = 0; i < CONFIG_T::pad_right; i++) {
+        fill_zero<res_T, CONFIG_T>(res);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void zeropad2d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res
+) {
+    PadHeight:
+    for (int row = 0; row < CONFIG_T::out_height; row++) {
+        PadWidth:
+        #pragma ii 1
+        for (int col = 0; col < CONFIG_T::out_width; col++) {
+            if (row < CONFIG_T::pad_top || row >= CONFIG_T::pad_top + CONFIG_T::in_height || col < CONFIG_T::pad_left || col >= CONFIG_T::pad_left + CONFIG_T::in_width) {
+                fill_zero<res_T, CONFIG_T>(res);
+            } else {
+                fill_data<data_T, res_T, CONFIG_T>(data, res);
+            }
+        }
+    }
+}
+
+}
+
+#endif
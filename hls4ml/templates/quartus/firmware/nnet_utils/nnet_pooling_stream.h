@@ -0,0 +1,410 @@
+#ifndef NNET_POOLING_STREAM_H_
+#define NNET_POOLING_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_pooling.h"
+
+namespace nnet {
+
+/*
+* Streaming pooling follows the streaming convolution: the pooling window slides over the (padded) input,
+* one pixel per cycle, and an output pixel is written whenever the window is aligned with the strides
+* Padded pixels are never read from the input stream; Max pooling fills them with the most negative value,
+* Average pooling excludes them from the mean, as done in Keras
+*/
+
+// *************************************************
+//       Pooling reduction
+// *************************************************
+
+// Returns the maximum value of the window
+template<class T, int N>
+inline T reduce_pool_max(T x[N]) {
+    hls_register T y = x[0];
+
+    MaxLoop:
+    #pragma unroll
+    for (int i = 1; i < N; i++) {
+        if (x[i] > y) y = x[i];
+    }
+
+    return y;
+}
+
+// Returns the sum of the window, in the accumulator precision
+template<class T, int N, class CONFIG_T>
+inline typename CONFIG_T::accum_t reduce_pool_sum(T x[N]) {
+    hls_register typename CONFIG_T::accum_t y = 0;
+
+    SumLoop:
+    #pragma unroll
+    for (int i = 0; i < N; i++) {
+        y += x[i];
+    }
+
+    return y;
+}
+
+// Returns the number of pixels in the window, aligned to the padded position pos, which are not padding
+template<int pool_size, int pad_begin, int in_size>
+inline int pool_overlap(const int pos) {
+    const int first = pos - pool_size + 1 < pad_begin ? pad_begin : pos - pool_size + 1;
+    const int last = pos > pad_begin + in_size - 1 ? pad_begin + in_size - 1 : pos;
+    return last - first + 1;
+}
+
+// *************************************************
+//       Pooling 1D
+// *************************************************
+
+template<class data_T, typename CONFIG_T>
+inline void pool_shift_1d(
+    const data_T &in_elem,
+    typename data_T::value_type pool_window[CONFIG_T::pool_width * CONFIG_T::n_filt]
+) {
+    // Shift pool_window by one step to the left
+    PoolShiftWidth:
+    #pragma unroll
+    for (int col = 0; col < CONFIG_T::pool_width - 1; col++) {
+        PoolShiftChannel:
+        #pragma unroll
+        for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+            pool_window[col * CONFIG_T::n_filt + channel] = pool_window[(col + 1) * CONFIG_T::n_filt + channel];
+        }
+    }
+
+    // Insert the new pixel into the right-most column of the window
+    PoolPushChannel:
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+        pool_window[(CONFIG_T::pool_width - 1) * CONFIG_T::n_filt + channel] = in_elem[channel];
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline void compute_pool_buffer_1d(
+    const data_T &in_elem,
+    stream<res_T> &res_stream,
+    typename data_T::value_type pool_window[CONFIG_T::pool_width * CONFIG_T::n_filt],
+    int &pX,
+    int &sX
+) {
+    // Thresholds
+    static constexpr int lShiftX = CONFIG_T::pool_width - 1;
+
+    // Add pixel to the pooling window
+    pool_shift_1d<data_T, CONFIG_T>(in_elem, pool_window);
+
+    // Check to see if we have a full window
+    if ((sX - lShiftX) == 0 && pX > lShiftX - 1) {
+        hls_register res_T res_pack;
+
+        FiltLoop:
+        #pragma unroll
+        for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+            // Retrieve data for the current channel
+            hls_register typename data_T::value_type pool[CONFIG_T::pool_width];
+            PoolLoop:
+            #pragma unroll
+            for (int i = 0; i < CONFIG_T::pool_width; i++) {
+                pool[i] = pool_window[i * CONFIG_T::n_filt + filter];
+            }
+
+            if (CONFIG_T::pool_op == Max) {
+                res_pack[filter] = reduce_pool_max<typename data_T::value_type, CONFIG_T::pool_width>(pool);
+            } else if (CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0) {
+                res_pack[filter] = reduce_pool_sum<typename data_T::value_type, CONFIG_T::pool_width, CONFIG_T>(pool) / CONFIG_T::pool_width;
+            } else {
+                res_pack[filter] = reduce_pool_sum<typename data_T::value_type, CONFIG_T::pool_width, CONFIG_T>(pool) / pool_overlap<CONFIG_T::pool_width, CONFIG_T::pad_left, CONFIG_T::n_in>(pX);
+            }
+        }
+
+        // Write output to stream when output ready
+        res_stream.write(res_pack);
+    }
+
+    // Counter housekeeping; the end of the padded row resets the counters
+    if (pX + 1 == CONFIG_T::pad_left + CONFIG_T::n_in + CONFIG_T::pad_right) {
+        pX = 0;
+        sX = 0;
+    } else {
+        pX = pX + 1;
+        // Update stride (threshold) ? subtract stride : increment stride
+        sX = ((sX - lShiftX) == 0) ? sX - CONFIG_T::stride_width + 1 : sX + 1;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pooling1d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res
+) {
+    // Pooling window
+    hls_register typename data_T::value_type pool_window[CONFIG_T::pool_width * CONFIG_T::n_filt];
+
+    // Counters
+    int pX = 0;
+    int sX = 0;
+
+    // Padded pixel; ignored by Max pooling and excluded from the mean of Average pooling
+    hls_register data_T padds;
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+        padds[channel] = pad_val<typename data_T::value_type, CONFIG_T::pool_op>();
+    }
+
+    ReadInputWidth:
+    #pragma ii 1
+    for (int col = 0; col < CONFIG_T::pad_left + CONFIG_T::n_in + CONFIG_T::pad_right; col++) {
+        bool is_padding = col < CONFIG_T::pad_left || col >= CONFIG_T::pad_left + CONFIG_T::n_in;
+        data_T in_elem = is_padding ? padds : data.read();
+        compute_pool_buffer_1d<data_T, res_T, CONFIG_T>(in_elem, res, pool_window, pX, sX);
+    }
+}
+
+// *************************************************
+//       Pooling 2D
+// *************************************************
+
+template<class data_T, typename CONFIG_T>
+inline void shift_pool_buffer_2d(
+    const data_T &in_elem,
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right> line_buffer[MAX(CONFIG_T::pool_height - 1, 1)][CONFIG_T::n_filt],
+    typename data_T::value_type pool_window[CONFIG_T::pool_height * CONFIG_T::pool_width * CONFIG_T::n_filt]
+) {
+    // Temporary buffer for the popped (shifted) elements, i.e. the new column of the window
+    hls_register typename data_T::value_type shift_buffer[CONFIG_T::pool_height][CONFIG_T::n_filt];
+
+    UpdateBuffer:
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+        // Insert pixel at the bottom of the shift buffer
+        shift_buffer[CONFIG_T::pool_height - 1][channel] = in_elem[channel];
+    }
+
+    LineBufferDataIn:
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+        LineBufferShift:
+        #pragma unroll
+        for (int row = 1; row < CONFIG_T::pool_height; row++) {
+            // Shift the line buffer; the popped pixel is placed back into shift_buffer, one row up
+            shift_buffer[CONFIG_T::pool_height - row - 1][channel] = line_buffer[row - 1][channel].shift(shift_buffer[CONFIG_T::pool_height - row][channel]);
+        }
+    }
+
+    // Shift pool_window by one step to the left
+    PoolShiftWidth:
+    #pragma unroll
+    for (int col = 0; col < CONFIG_T::pool_width - 1; col++) {
+        PoolShiftHeight:
+        #pragma unroll
+        for (int row = 0; row < CONFIG_T::pool_height; row++) {
+            PoolShiftChannel:
+            #pragma unroll
+            for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+                pool_window[row * CONFIG_T::pool_width * CONFIG_T::n_filt + col * CONFIG_T::n_filt + channel] = pool_window[row * CONFIG_T::pool_width * CONFIG_T::n_filt + (col + 1) * CONFIG_T::n_filt + channel];
+            }
+        }
+    }
+
+    // Insert shift_buffer column into the right-most column of the window
+    PoolPushHeight:
+    #pragma unroll
+    for (int row = 0; row < CONFIG_T::pool_height; row++) {
+        PoolPushChannel:
+        #pragma unroll
+        for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+            pool_window[row * CONFIG_T::pool_width * CONFIG_T::n_filt + (CONFIG_T::pool_width - 1) * CONFIG_T::n_filt + channel] = shift_buffer[row][channel];
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline void compute_pool_buffer_2d(
+    const data_T &in_elem,
+    stream<res_T> &res_stream,
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right> line_buffer[MAX(CONFIG_T::pool_height - 1, 1)][CONFIG_T::n_filt],
+    typename data_T::value_type pool_window[CONFIG_T::pool_height * CONFIG_T::pool_width * CONFIG_T::n_filt],
+    int &pX,
+    int &pY,
+    int &sX,
+    int &sY
+) {
+    // Thresholds
+    static constexpr int lShiftX = CONFIG_T::pool_width - 1;
+    static constexpr int lShiftY = CONFIG_T::pool_height - 1;
+
+    // Add pixel to the line buffers and the pooling window
+    shift_pool_buffer_2d<data_T, CONFIG_T>(in_elem, line_buffer, pool_window);
+
+    // Check to see if we have a full window
+    if ((sX - lShiftX) == 0 && (sY - lShiftY) == 0 && pY > lShiftY - 1 && pX > lShiftX - 1) {
+        hls_register res_T res_pack;
+
+        FiltLoop:
+        #pragma unroll
+        for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+            // Retrieve data for the current channel
+            hls_register typename data_T::value_type pool[CONFIG_T::pool_height * CONFIG_T::pool_width];
+            PoolLoop:
+            #pragma unroll
+            for (int i = 0; i < CONFIG_T::pool_height * CONFIG_T::pool_width; i++) {
+                pool[i] = pool_window[i * CONFIG_T::n_filt + filter];
+            }
+
+            if (CONFIG_T::pool_op == Max) {
+                res_pack[filter] = reduce_pool_max<typename data_T::value_type, CONFIG_T::pool_height * CONFIG_T::pool_width>(pool);
+            } else if (CONFIG_T::pad_top == 0 && CONFIG_T::pad_bottom == 0 && CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0) {
+                res_pack[filter] = reduce_pool_sum<typename data_T::value_type, CONFIG_T::pool_height * CONFIG_T::pool_width, CONFIG_T>(pool) / (CONFIG_T::pool_height * CONFIG_T::pool_width);
+            } else {
+                const int overlap = pool_overlap<CONFIG_T::pool_height, CONFIG_T::pad_top, CONFIG_T::in_height>(pY) * pool_overlap<CONFIG_T::pool_width, CONFIG_T::pad_left, CONFIG_T::in_width>(pX);
+                res_pack[filter] = reduce_pool_sum<typename data_T::value_type, CONFIG_T::pool_height * CONFIG_T::pool_width, CONFIG_T>(pool) / overlap;
+            }
+        }
+
+        // Write output to stream when output ready
+        res_stream.write(res_pack);
+    }
+
+    // Counter housekeeping; the end of the padded row resets the column counters
+    if (pX + 1 == CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right) {
+        pX = 0;
+        sX = 0;
+        if (pY + 1 == CONFIG_T::pad_top + CONFIG_T::in_height + CONFIG_T::pad_bottom) {
+            pY = 0;
+            sY = 0;
+        } else {
+            pY = pY + 1;
+            // Update stride (threshold) ? subtract stride : increment stride
+            sY = ((sY - lShiftY) == 0) ? sY - CONFIG_T::stride_height + 1 : sY + 1;
+        }
+    } else {
+        pX = pX + 1;
+        // Update stride (threshold) ? subtract stride : increment stride
+        sX = ((sX - lShiftX) == 0) ? sX - CONFIG_T::stride_width + 1 : sX + 1;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pooling2d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res
+) {
+    // Line buffers and pooling window
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right> line_buffer[MAX(CONFIG_T::pool_height - 1, 1)][CONFIG_T::n_filt];
+    hls_register typename data_T::value_type pool_window[CONFIG_T::pool_height * CONFIG_T::pool_width * CONFIG_T::n_filt];
+
+    // Counters
+    int pX = 0;
+    int pY = 0;
+    int sX = 0;
+    int sY = 0;
+
+    // Padded pixel; ignored by Max pooling and excluded from the mean of Average pooling
+    hls_register data_T padds;
+    #pragma unroll
+    for (int channel = 0; channel < CONFIG_T::n_filt; channel++) {
+        padds[channel] = pad_val<typename data_T::value_type, CONFIG_T::pool_op>();
+    }
+
+    ReadInputHeight:
+    for (int row = 0; row < CONFIG_T::pad_top + CONFIG_T::in_height + CONFIG_T::pad_bottom; row++) {
+        ReadInputWidth:
+        #pragma ii 1
+        for (int col = 0; col < CONFIG_T::pad_left + CONFIG_T::in_width + CONFIG_T::pad_right; col++) {
+            bool is_padding = row < CONFIG_T::pad_top || row >= CONFIG_T::pad_top + CONFIG_T::in_height || col < CONFIG_T::pad_left || col >= CONFIG_T::pad_left + CONFIG_T::in_width;
+            data_T in_elem = is_padding ? padds : data.read();
+            compute_pool_buffer_2d<data_T, res_T, CONFIG_T>(in_elem, res, line_buffer, pool_window, pX, pY, sX, sY);
+        }
+    }
+}
+
+// *************************************************
+//       Global max/average pooling
+// *************************************************
+
+template<class data_T, typename CONFIG_T>
+inline void compute_global_pool(
+    const data_T &in_elem,
+    typename CONFIG_T::accum_t data_window[CONFIG_T::n_filt]
+) {
+    PoolFilt:
+    #pragma unroll
+    for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+        if (CONFIG_T::pool_op == Max) {
+            if (in_elem[filter] > data_window[filter]) data_window[filter] = in_elem[filter];
+        } else {
+            data_window[filter] += in_elem[filter];
+        }
+    }
+}
+
+template<class res_T, typename CONFIG_T, int N>
+inline void write_global_pool(
+    const typename CONFIG_T::accum_t data_window[CONFIG_T::n_filt],
+    stream<res_T> &res
+) {
+    hls_register res_T res_pack;
+
+    PoolRes:
+    #pragma unroll
+    for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+        if (CONFIG_T::pool_op == Max) {
+            res_pack[filter] = data_window[filter];
+        } else {
+            res_pack[filter] = data_window[filter] / N;
+        }
+    }
+
+    res.write(res_pack);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void global_pooling1d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res
+) {
+    hls_register typename CONFIG_T::accum_t data_window[CONFIG_T::n_filt];
+
+    PoolInitLoop:
+    #pragma unroll
+    for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+        data_window[filter] = pad_val<typename CONFIG_T::accum_t, CONFIG_T::pool_op>();
+    }
+
+    ReadInput:
+    #pragma ii 1
+    for (int i = 0; i < CONFIG_T::n_in; i++) {
+        compute_global_pool<data_T, CONFIG_T>(data.read(), data_window);
+    }
+
+    write_global_pool<res_T, CONFIG_T, CONFIG_T::n_in>(data_window, res);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void global_pooling2d_cl(
+    stream<data_T> &data,
+    stream<res_T>  &res
+) {
+    hls_register typename CONFIG_T::accum_t data_window[CONFIG_T::n_filt];
+
+    PoolInitLoop:
+    #pragma unroll
+    for (int filter = 0; filter < CONFIG_T::n_filt; filter++) {
+        data_window[filter] = pad_val<typename CONFIG_T::accum_t, CONFIG_T::pool_op>();
+    }
+
+    ReadInput:
+    #pragma ii 1
+    for (int i = 0; i < CONFIG_T::in_height * CONFIG_T::in_width; i++) {
+        compute_global_pool<data_T, CONFIG_T>(data.read(), data_window);
+    }
+
+    write_global_pool<res_T, CONFIG_T, CONFIG_T::in_height * CONFIG_T::in_width>(data_window, res);
+}
+
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef NNET_PRECOMPILED_H_
+#define NNET_PRECOMPILED_H_
+
+// Headers that do not depend on the model, precompiled by build_lib.sh and included before every translation unit
+// Only used for GCC compilation / hls4ml.predict(...)
+// Activations are not included, since their lookup tables (activation_tables/*.tb) are generated for each model
+#include "nnet_types.h"
+#include "nnet_common.h"
+#include "nnet_mult.h"
+
+#endif
@@ -4,6 +4,7 @@
 #include "nnet_common.h"
 #include "nnet_dense.h"
 #include "nnet_recurrent_activation.h"
+#include "nnet_recurrent.h"
 
 namespace nnet {
 template<class data_T, class res_T, typename CONFIG_T>
@@ -62,6 +63,165 @@ void gru(
     }
 }
 
+//----------------------
+// SimpleRNN
+//----------------------
+
+/*
+* Streaming RNNs consume one time step per stream beat, so each time step is processed as soon as it arrives
+* With return_sequences, the hidden state is written after every time step; otherwise, only the final hidden state is written
+*/
+template<class data_T, class res_T, typename CONFIG_T>
+void simple_rnn(
+    stream<data_T> &data_stream,
+    stream<res_T>  &res_stream,
+    const typename CONFIG_T::weight_t kernel[CONFIG_T::n_in * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t rec_kernel[CONFIG_T::n_out * CONFIG_T::n_out],
+    const typename CONFIG_T::bias_t   bias[CONFIG_T::n_out]
+) {
+    hls_register typename res_T::value_type hidden_state[CONFIG_T::n_out];
+    hls_register typename res_T::value_type hidden_state_temp[CONFIG_T::n_out];
+
+    // Set initially hidden state (output) to zero
+    INIT_LOOP:
+    #pragma unroll
+    for (int x = 0; x < CONFIG_T::n_out; x++) {
+        hidden_state[x] = 0;
+    }
+
+    hls_register typename data_T::value_type in[CONFIG_T::n_in];
+
+    DataPropagation:
+    #pragma disable_loop_pipelining
+    for (int i = 0; i < CONFIG_T::n_timesteps; i++) {
+        // Data at current time step
+        data_T data_pack = data_stream.read();
+
+        DataPack:
+        #pragma unroll
+        for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
+            in[i_pack] = data_pack[i_pack];
+        }
+
+        // Hidden state at current time step
+        #pragma unroll
+        for (int x = 0; x < CONFIG_T::n_out; x++) {
+            hidden_state_temp[x] = hidden_state[x];
+        }
+
+        // Do SimpleRNN
+        simple_rnn_cell<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(in, hidden_state_temp, hidden_state, kernel, rec_kernel, bias);
+
+        if (CONFIG_T::return_sequences) {
+            res_T res_pack;
+
+            ResPackRetSeq:
+            #pragma unroll
+            for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+                res_pack[i_pack] = hidden_state[i_pack];
+            }
+
+            res_stream.write(res_pack);
+        }
+    }
+
+    if (!CONFIG_T::return_sequences) {
+        res_T res_pack;
+
+        ResPackNoRetSeq:
+        #pragma unroll
+        for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+            res_pack[i_pack] = hidden_state[i_pack];
+        }
+
+        res_stream.write(res_pack);
+    }
+}
+
+//----------------------
+// LSTM
+//----------------------
+
+template<class data_T, class res_T, class CONFIG_T>
+void lstm(
+    stream<data_T> &data_stream,
+    stream<res_T>  &res_stream,
+    const typename CONFIG_T::weight_t WI[CONFIG_T::n_in * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t WF[CONFIG_T::n_in * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t WC[CONFIG_T::n_in * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t WO[CONFIG_T::n_in * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t RWI[CONFIG_T::n_out * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t RWF[CONFIG_T::n_out * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t RWC[CONFIG_T::n_out * CONFIG_T::n_out],
+    const typename CONFIG_T::weight_t RWO[CONFIG_T::n_out * CONFIG_T::n_out],
+    const typename CONFIG_T::bias_t   BI[CONFIG_T::n_out],
+    const typename CONFIG_T::bias_t   BF[CONFIG_T::n_out],
+    const typename CONFIG_T::bias_t   BC[CONFIG_T::n_out],
+    const typename CONFIG_T::bias_t   BO[CONFIG_T::n_out]
+) {
+    hls_register typename res_T::value_type hidden_state[CONFIG_T::n_out];
+    hls_register typename res_T::value_type hidden_state_temp[CONFIG_T::n_out];
+    hls_register typename res_T::value_type cell_state[CONFIG_T::n_out];
+    hls_register typename res_T::value_type cell_state_temp[CONFIG_T::n_out];
+
+    // Set initially hidden state (output) and cell state to zero
+    INIT_LOOP:
+    #pragma unroll
+    for (int x = 0; x < CONFIG_T::n_out; x++) {
+        hidden_state[x] = 0;
+        cell_state[x] = 0;
+    }
+
+    hls_register typename data_T::value_type in[CONFIG_T::n_in];
+
+    DataPropagation:
+    #pragma disable_loop_pipelining
+    for (int i = 0; i < CONFIG_T::n_timesteps; i++) {
+        // Data at current time step
+        data_T data_pack = data_stream.read();
+
+        DataPack:
+        #pragma unroll
+        for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
+            in[i_pack] = data_pack[i_pack];
+        }
+
+        // Hidden and cell state at current time step
+        #pragma unroll
+        for (int x = 0; x < CONFIG_T::n_out; x++) {
+            hidden_state_temp[x] = hidden_state[x];
+            cell_state_temp[x] = cell_state[x];
+        }
+
+        // Do LSTM
+        lstm_cell<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(in, hidden_state_temp, hidden_state, cell_state_temp, cell_state, WI, WF, WC, WO, RWI, RWF, RWC, RWO, BI, BF, BC, BO);
+
+        if (CONFIG_T::return_sequences) {
+            res_T res_pack;
+
+            ResPackRetSeq:
+            #pragma unroll
+            for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+                res_pack[i_pack] = hidden_state[i_pack];
+            }
+
+            res_stream.write(res_pack);
+        }
+    }
+
+    if (!CONFIG_T::return_sequences) {
+        res_T res_pack;
+
+        ResPackNoRetSeq:
+        #pragma unroll
+        for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+            res_pack[i_pack] = hidden_state[i_pack];
+        }
+
+        res_stream.write(res_pack);
+    }
+}
+
 }
 
 #endif
@@ -0,0 +1,59 @@
+#ifndef NNET_RESIZE_STREAM_H_
+#define NNET_RESIZE_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_resize.h"
+
+namespace nnet {
+
+/*
+* Nearest-neighbour upsampling by integer factors
+* Each input pixel is read once, on the first repetition of its row, and written ratio_width times
+* The pixels of the current row are kept in a shift register of one row and replayed for the remaining ratio_height - 1 repetitions
+* One output pixel is written per cycle
+*/
+template<class data_T, typename CONFIG_T>
+void resize_nearest(
+    stream<data_T> &image,
+    stream<data_T> &resized
+) {
+    assert(CONFIG_T::new_height % CONFIG_T::height == 0);
+    assert(CONFIG_T::new_width % CONFIG_T::width == 0);
+    static constexpr unsigned ratio_height = CONFIG_T::new_height / CONFIG_T::height;
+    static constexpr unsigned ratio_width = CONFIG_T::new_width / CONFIG_T::width;
+
+    // Input pixels of the current row, one shift register per channel
+    nnet::shift_reg<typename data_T::value_type, CONFIG_T::width> row_buffer[CONFIG_T::n_chan];
+    hls_register data_T pixel;
+
+    ResizeHeight:
+    for (unsigned h = 0; h < CONFIG_T::new_height; h++) {
+        ResizeWidth:
+        #pragma ii 1
+        for (unsigned w = 0; w < CONFIG_T::new_width; w++) {
+            // Fetch the next pixel of the row, from the input on its first repetition and from the row buffer after
+            if (w % ratio_width == 0) {
+                if (h % ratio_height == 0) {
+                    pixel = image.read();
+                } else {
+                    #pragma unroll
+                    for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+                        pixel[channel] = row_buffer[channel].read(CONFIG_T::width - 1);
+                    }
+                }
+
+                #pragma unroll
+                for (int channel = 0; channel < CONFIG_T::n_chan; channel++) {
+                    row_buffer[channel].shift(pixel[channel]);
+                }
+            }
+
+            resized.write(pixel);
+        }
+    }
+}
+
+}
+
+#endif
@@ -37,6 +37,42 @@ struct array {
     }  
 };
 
+// Fixed-size shift register, used as the line buffer of streaming layers
+template<typename T, unsigned N>
+class shift_reg {
+    private:
+        T data[N];
+
+    public:
+        shift_reg() {
+            reset();
+        }
+
+        void reset(const T &init = T(0)) {
+            #pragma unroll
+            for (unsigned i = 0; i < N; i++) {
+                data[i] = init;
+            }
+        }
+
+        // Shift in a new element, returning the oldest one
+        T shift(const T &inp) {
+            T out = data[N - 1];
+
+            #pragma unroll
+            for (unsigned i = N - 1; i > 0; i--) {
+                data[i] = data[i - 1];
+            }
+            data[0] = inp;
+
+            return out;
+        }
+
+        T read(unsigned pos) const {
+            return data[pos];
+        }
+};
+
 }
 
 #endif
@@ -0,0 +1,244 @@
+#ifndef NNET_WINOGRAD_H_
+#define NNET_WINOGRAD_H_
+
+#include "nnet_common.h"
+
+namespace nnet {
+
+// ****************************************************************
+//       Transformation matrices for Winograd's minimal filtering
+// ****************************************************************
+
+/*
+* Input (B') and output (A') transformation matrices of the minimal filtering algorithm F(M, R),
+* computing M outputs of a convolution with an R-wide kernel from an (M + R - 1)-wide input tile, as Y = A' [(G g) * (B' d)]
+* The matrices follow the Toom-Cook construction with the points 0, 1, -1, 2, -2, 1/2, -1/2 and infinity (Lavin & Gray, 2015)
+* Rows of B' and columns of A' are scaled to integers, so the transformations only use shifts and additions;
+* the compensating factors are folded into the kernel transformation G, applied offline (see convolution_winograd.py)
+*/
+template<unsigned M, unsigned R>
+struct winograd_matrices;
+
+template<> struct winograd_matrices<2, 3> {
+    static int bt(const unsigned i, const unsigned j) {
+        static const int BT[4][4] = {
+            { -1,   0,   1,   0},
+            {  0,   1,   1,   0},
+            {  0,  -1,   1,   0},
+            {  0,  -1,   0,   1}
+        };
+        return BT[i][j];
+    }
+    static int at(const unsigned i, const unsigned j) {
+        static const int AT[2][4] = {
+            {  1,   1,   1,   0},
+            {  0,   1,  -1,   1}
+        };
+        return AT[i][j];
+    }
+};
+
+template<> struct winograd_matrices<4, 3> {
+    static int bt(const unsigned i, const unsigned j) {
+        static const int BT[6][6] = {
+            {  4,   0,  -5,   0,   1,   0},
+            {  0,  -4,  -4,   1,   1,   0},
+            {  0,   4,  -4,  -1,   1,   0},
+            {  0,  -2,  -1,   2,   1,   0},
+            {  0,   2,  -1,  -2,   1,   0},
+            {  0,   4,   0,  -5,   0,   1}
+        };
+        return BT[i][j];
+    }
+    static int at(const unsigned i, const unsigned j) {
+        static const int AT[4][6] = {
+            {  1,   1,   1,   1,   1,   0},
+            {  0,   1,  -1,   2,  -2,   0},
+            {  0,   1,   1,   4,   4,   0},
+            {  0,   1,  -1,   8,  -8,   1}
+        };
+        return AT[i][j];
+    }
+};
+
+template<> struct winograd_matrices<6, 3> {
+    static int bt(const unsigned i, const unsigned j) {
+        static const int BT[8][8] = {
+            { -4,   0,  21,   0, -21,   0,   4,   0},
+            {  0,   4,   4, -17, -17,   4,   4,   0},
+            {  0,  -4,   4,  17, -17,  -4,   4,   0},
+            {  0,   2,   1, -10,  -5,   8,   4,   0},
+            {  0,  -2,   1,  10,  -5,  -8,   4,   0},
+            {  0,   4,   8,  -5, -10,   1,   2,   0},
+            {  0,  -4,   8,   5, -10,  -1,   2,   0},
+            {  0,  -4,   0,  21,   0, -21,   0,   4}
+        };
+        return BT[i][j];
+    }
+    static int at(const unsigned i, const unsigned j) {
+        static const int AT[6][8] = {
+            {  1,   1,   1,   1,   1,  32,  32,   0},
+            {  0,   1,  -1,   2,  -2,  16, -16,   0},
+            {  0,   1,   1,   4,   4,   8,   8,   0},
+            {  0,   1,  -1,   8,  -8,   4,  -4,   0},
+            {  0,   1,   1,  16,  16,   2,   2,   0},
+            {  0,   1,  -1,  32, -32,   1,  -1,   1}
+        };
+        return AT[i][j];
+    }
+};
+
+template<> struct winograd_matrices<2, 5> {
+    static int bt(const unsigned i, const unsigned j) {
+        static const int BT[6][6] = {
+            {  4,   0,  -5,   0,   1,   0},
+            {  0,  -4,  -4,   1,   1,   0},
+            {  0,   4,  -4,  -1,   1,   0},
+            {  0,  -2,  -1,   2,   1,   0},
+            {  0,   2,  -1,  -2,   1,   0},
+            {  0,   4,   0,  -5,   0,   1}
+        };
+        return BT[i][j];
+    }
+    static int at(const unsigned i, const unsigned j) {
+        static const int AT[2][6] = {
+            {  1,   1,   1,   1,   1,   0},
+            {  0,   1,  -1,   2,  -2,   1}
+        };
+        return AT[i][j];
+    }
+};
+
+template<> struct winograd_matrices<4, 5> {
+    static int bt(const unsigned i, const unsigned j) {
+        static const int BT[8][8] = {
+            { -4,   0,  21,   0, -21,   0,   4,   0},
+            {  0,   4,   4, -17, -17,   4,   4,   0},
+            {  0,  -4,   4,  17, -17,  -4,   4,   0},
+            {  0,   2,   1, -10,  -5,   8,   4,   0},
+            {  0,  -2,   1,  10,  -5,  -8,   4,   0},
+            {  0,   4,   8,  -5, -10,   1,   2,   0},
+            {  0,  -4,   8,   5, -10,  -1,   2,   0},
+            {  0,  -4,   0,  21,   0, -21,   0,   4}
+        };
+        return BT[i][j];
+    }
+    static int at(const unsigned i, const unsigned j) {
+        static const int AT[4][8] = {
+            {  1,   1,   1,   1,   1,   8,   8,   0},
+            {  0,   1,  -1,   2,  -2,   4,  -4,   0},
+            {  0,   1,   1,   4,   4,   2,   2,   0},
+            {  0,   1,  -1,   8,  -8,   1,  -1,   1}
+        };
+        return AT[i][j];
+    }
+};
+
+// ****************************************************************
+//       Input and output tile transformations
+// ****************************************************************
+
+// The loops are fully unrolled; with constant indices, the coefficient look-ups are resolved at compile-time
+// and multiplications with zero coefficients are removed
+
+// Input tile transformation, D = B'd
+template<class data_T, class res_T, unsigned M, unsigned R>
+inline void winograd_transform_input_tile_1d(const data_T I[M + R - 1], res_T D[M + R - 1]) {
+    #pragma unroll
+    for (int i = 0; i < M + R - 1; i++) {
+        hls_register res_T acc = 0;
+        #pragma unroll
+        for (int j = 0; j < M + R - 1; j++) {
+            if (winograd_matrices<M, R>::bt(i, j) != 0) acc += winograd_matrices<M, R>::bt(i, j) * I[j];
+        }
+        D[i] = acc;
+    }
+}
+
+// Input tile transformation, D = B'dB, with the tiles stored in row-major order
+template<class data_T, class res_T, unsigned M, unsigned R>
+inline void winograd_transform_input_tile_2d(const data_T I[(M + R - 1) * (M + R - 1)], res_T D[(M + R - 1) * (M + R - 1)]) {
+    static constexpr int n = M + R - 1;
+
+    // Columns, B'd
+    hls_register res_T tmp[n * n];
+    #pragma unroll
+    for (int i = 0; i < n; i++) {
+        #pragma unroll
+        for (int c = 0; c < n; c++) {
+            hls_register res_T acc = 0;
+            #pragma unroll
+            for (int j = 0; j < n; j++) {
+                if (winograd_matrices<M, R>::bt(i, j) != 0) acc += winograd_matrices<M, R>::bt(i, j) * I[j * n + c];
+            }
+            tmp[i * n + c] = acc;
+        }
+    }
+
+    // Rows, (B'd)B
+    #pragma unroll
+    for (int i = 0; i < n; i++) {
+        #pragma unroll
+        for (int k = 0; k < n; k++) {
+            hls_register res_T acc = 0;
+            #pragma unroll
+            for (int c = 0; c < n; c++) {
+                if (winograd_matrices<M, R>::bt(k, c) != 0) acc += winograd_matrices<M, R>::bt(k, c) * tmp[i * n + c];
+            }
+            D[i * n + k] = acc;
+        }
+    }
+}
+
+// Output tile transformation, Z = A'Y
+template<class data_T, class res_T, unsigned M, unsigned R>
+inline void winograd_transform_output_tile_1d(const data_T Y[M + R - 1], res_T Z[M]) {
+    #pragma unroll
+    for (int i = 0; i < M; i++) {
+        hls_register res_T acc = 0;
+        #pragma unroll
+        for (int j = 0; j < M + R - 1; j++) {
+            if (winograd_matrices<M, R>::at(i, j) != 0) acc += winograd_matrices<M, R>::at(i, j) * Y[j];
+        }
+        Z[i] = acc;
+    }
+}
+
+// Output tile transformation, Z = A'YA, with the tiles stored in row-major order
+template<class data_T, class res_T, unsigned M, unsigned R>
+inline void winograd_transform_output_tile_2d(const data_T Y[(M + R - 1) * (M + R - 1)], res_T Z[M * M]) {
+    static constexpr int n = M + R - 1;
+
+    // Columns, A'Y
+    hls_register res_T tmp[M * n];
+    #pragma unroll
+    for (int i = 0; i < M; i++) {
+        #pragma unroll
+        for (int c = 0; c < n; c++) {
+            hls_register res_T acc = 0;
+            #pragma unroll
+            for (int j = 0; j < n; j++) {
+                if (winograd_matrices<M, R>::at(i, j) != 0) acc += winograd_matrices<M, R>::at(i, j) * Y[j * n + c];
+            }
+            tmp[i * n + c] = acc;
+        }
+    }
+
+    // Rows, (A'Y)A
+    #pragma unroll
+    for (int i = 0; i < M; i++) {
+        #pragma unroll
+        for (int k = 0; k < M; k++) {
+            hls_register res_T acc = 0;
+            #pragma unroll
+            for (int c = 0; c < n; c++) {
+                if (winograd_matrices<M, R>::at(k, c) != 0) acc += winograd_matrices<M, R>::at(k, c) * tmp[i * n + c];
+            }
+            Z[i * M + k] = acc;
+        }
+    }
+}
+
+}
+
+#endif
@@ -60,6 +60,20 @@ void myproject_double(
     //hls-fpga-machine-learning insert wrapper #double
 }
 
+// Batched wrapper of top level function for Python bridge
+// Inputs and outputs of all samples are stored contiguously; all samples are enqueued and processed in a single run, as in the testbench
+void myproject_batch_float(
+    //hls-fpga-machine-learning insert batch header #float
+) {
+    //hls-fpga-machine-learning insert batch wrapper #float
+}
+
+void myproject_batch_double(
+    //hls-fpga-machine-learning insert batch header #double
+) {
+    //hls-fpga-machine-learning insert batch wrapper #double
+}
+
 }
 
 #endif
@@ -81,6 +81,9 @@
 #include <typeinfo>
 #include <string>
 #include <sstream>
+#include <map>
+#include <vector>
+#include <algorithm>
 
 #ifdef HLS_STREAM_THREAD_SAFE
 #include <mutex>
@@ -94,56 +97,373 @@
 
 namespace hls {
 
+//////////////////////////////////////////////
+// Cycle-approximate timing model of a dataflow design
+//////////////////////////////////////////////
+// When enabled, every token written to a stream carries the cycle at which it becomes available. A process (a layer of the
+// design, see begin_process) starts an iteration every `ii` cycles, once `tokens_per_iteration` tokens of its first input are
+// available, and its outputs become available `depth` cycles after the iteration started. A process waits when its inputs are
+// empty and when its outputs are full. C simulation runs the processes one after another, so a FIFO is only known to be full
+// once its consumer has run: the design is simulated in several passes, using the read cycles of the previous pass, until
+// the read cycles don't change anymore.
+// Kernels with data-dependent trip counts report the cycles they spend in an iteration with busy().
+#define HLS_STREAM_TIMING_MODEL
+namespace timing {
+
+typedef unsigned long long cycle_t;
+
+struct process {
+    unsigned ii;
+    unsigned depth;
+    unsigned tokens_per_iteration;
+    const void *primary; // The first stream read by the process, reads of which start new iterations
+    unsigned long n_primary_reads;
+    bool started, written;
+    cycle_t start;       // Start of the first iteration
+    cycle_t next_start;  // Earliest start of the next iteration
+    cycle_t now;         // Start of the current iteration, delayed by the stalls in it
+    cycle_t last_write;
+};
+
+struct fifo {
+    size_t depth; // 0 if the FIFO is not bounded
+    std::vector<cycle_t> writes;
+    std::vector<cycle_t> reads;
+    std::vector<cycle_t> prev_reads;
+    cycle_t full_stalls;
+    cycle_t empty_stalls;
+};
+
+struct model {
+    bool enabled;
+    process *current;
+    cycle_t latency;
+    std::map<std::string, process> processes;
+    std::map<std::string, fifo> fifos;
+
+    model() : enabled(false), current(0), latency(0) {}
+};
+
+inline model &get_model() {
+    static model m;
+    return m;
+}
+
+inline void set_fifo_depth(const std::string &name, size_t depth) {
+    fifo &f = get_model().fifos[name];
+    f = fifo();
+    f.depth = depth;
+}
+
+inline fifo *find_fifo(const std::string &name) {
+    model &m = get_model();
+    std::map<std::string, fifo>::iterator it = m.fifos.find(name);
+    return it == m.fifos.end() ? 0 : &it->second;
+}
+
+// Streams accessed between begin_process and end_process are accessed by the given process, all others by the testbench
+inline void begin_process(const char *name, unsigned ii, unsigned depth, unsigned tokens_per_iteration) {
+    model &m = get_model();
+    if (!m.enabled) return;
+    process &p = m.processes[name];
+    p = process();
+    p.ii = std::max(ii, 1u);
+    p.depth = std::max(depth, 1u);
+    p.tokens_per_iteration = std::max(tokens_per_iteration, 1u);
+    m.current = &p;
+}
+
+inline void end_process() {
+    get_model().current = 0;
+}
+
+// The current process spends the given number of cycles in the current iteration (e.g., in a loop with a data-dependent
+// trip count), delaying its outputs and the start of its next iteration
+inline void busy(cycle_t cycles) {
+    model &m = get_model();
+    process *p = m.current;
+    if (!m.enabled || p == 0) return;
+    p->now += cycles;
+    p->next_start = std::max(p->next_start, p->now);
+}
+
+inline void begin_pass() {
+    model &m = get_model();
+    m.current = 0;
+    m.latency = 0;
+    m.processes.clear();
+    for (std::map<std::string, fifo>::iterator it = m.fifos.begin(); it != m.fifos.end(); it++) {
+        it->second.writes.clear();
+        it->second.reads.clear();
+        it->second.full_stalls = 0;
+        it->second.empty_stalls = 0;
+    }
+}
+
+// Returns true if the pass didn't change the read cycles, i.e., the timing of the design is resolved
+inline bool end_pass() {
+    model &m = get_model();
+    bool converged = true;
+    for (std::map<std::string, fifo>::iterator it = m.fifos.begin(); it != m.fifos.end(); it++) {
+        if (it->second.reads != it->second.prev_reads) converged = false;
+        it->second.prev_reads.swap(it->second.reads);
+    }
+    return converged;
+}
+
+// Largest number of tokens stored in the FIFO in the last pass
+inline size_t max_occupancy(const fifo &f) {
+    size_t n_read = 0, occupancy = 0;
+    for (size_t i = 0; i < f.writes.size(); i++) {
+        while (n_read < f.prev_reads.size() && n_read < i && f.prev_reads[n_read] <= f.writes[i]) n_read++;
+        occupancy = std::max(occupancy, i + 1 - n_read);
+    }
+    return occupancy;
+}
+
+// Returns the cycle at which the index-th token written to the stream becomes available
+inline cycle_t on_write(fifo *f, size_t index) {
+    model &m = get_model();
+    process *p = m.current;
+    cycle_t t;
+    if (p == 0) {
+        // The testbench writes one token per cycle
+        t = index;
+    } else {
+        t = p->now + p->depth;
+        if (p->written) t = std::max(t, p->last_write + 1);
+    }
+    if (f != 0) {
+        // The token can only be written once the consumer read the token written depth tokens earlier
+        if (f->depth > 0 && index >= f->depth && index - f->depth < f->prev_reads.size()) {
+            cycle_t free = f->prev_reads[index - f->depth] + 1;
+            if (free > t) {
+                f->full_stalls += free - t;
+                if (p != 0) {
+                    p->now += free - t;
+                    p->next_start += free - t;
+                }
+                t = free;
+            }
+        }
+        f->writes.push_back(t);
+    }
+    if (p != 0) {
+        p->last_write = t;
+        p->written = true;
+    }
+    return t;
+}
+
+// Called when a token that becomes available at the given cycle is read from the stream
+inline void on_read(const void *stream, fifo *f, cycle_t available) {
+    model &m = get_model();
+    process *p = m.current;
+    cycle_t t;
+    if (p == 0) {
+        // The testbench reads the outputs as soon as they are available
+        t = available;
+        m.latency = std::max(m.latency, available + 1);
+    } else {
+        if (p->primary == 0) p->primary = stream;
+        bool primary = (p->primary == stream);
+        bool new_iteration = primary && (p->n_primary_reads % p->tokens_per_iteration == 0);
+        cycle_t ready = new_iteration ? p->next_start : p->now + (primary ? 1 : 0);
+        if (primary) p->n_primary_reads++;
+        t = std::max(ready, available);
+        // Waiting for the first input is not a stall
+        if (f != 0 && p->started && available > ready) f->empty_stalls += available - ready;
+        if (new_iteration) {
+            if (!p->started) p->start = t;
+            p->started = true;
+            p->next_start = t + p->ii;
+        }
+        p->now = std::max(p->now, t);
+    }
+    if (f != 0) f->reads.push_back(t);
+}
+
+} // namespace timing
+
+// Storage of the streams that were destroyed, reused by the streams constructed later (e.g., in the next call of a function
+// declaring local streams), so that streams don't allocate memory once their capacity is known
+template<typename __STREAM_T__>
+class stream_buffer_pool
+{
+  public:
+    // The pool is never destroyed, so that streams with static storage can be destroyed at any time
+    static stream_buffer_pool &get() {
+        static stream_buffer_pool *pool = new stream_buffer_pool();
+        return *pool;
+    }
+
+    bool acquire(__STREAM_T__ *&data, size_t &capacity) {
+#ifdef HLS_STREAM_THREAD_SAFE
+        std::lock_guard<std::mutex> lg(_mutex);
+#endif
+        if (_buffers.empty()) return false;
+        data = _buffers.back().first;
+        capacity = _buffers.back().second;
+        _buffers.pop_back();
+        return true;
+    }
+
+    void release(__STREAM_T__ *data, size_t capacity) {
+#ifdef HLS_STREAM_THREAD_SAFE
+        std::lock_guard<std::mutex> lg(_mutex);
+#endif
+        _buffers.push_back(std::make_pair(data, capacity));
+    }
+
+  private:
+    std::vector<std::pair<__STREAM_T__ *, size_t> > _buffers;
+#ifdef HLS_STREAM_THREAD_SAFE
+    std::mutex _mutex;
+#endif
+};
+
 template<typename __STREAM_T__>
 class stream
 {
   protected:
-    std::string _name;
-    std::deque<__STREAM_T__> _data; // container for the elements
+    // The name is only built when it is needed (warnings and the timing model)
+    mutable std::string _name;
+    const char *_name_literal;
+    unsigned _id;
+    // Elements are stored in a ring buffer, the capacity of which is a power of two. The buffer is taken from the pool of
+    // buffers of destroyed streams on the first write, grows when the stream is full and is returned to the pool when the
+    // stream is destroyed.
+    __STREAM_T__ *_data;
+    size_t _capacity;
+    size_t _head;
+    size_t _count;
+    // Timing model: cycle at which each token becomes available, see hls::timing
+    std::vector<timing::cycle_t> _available;
+    size_t _n_written;
+    size_t _n_timed_reads;
+    timing::fifo *_fifo;
+    bool _fifo_found;
 #ifdef HLS_STREAM_THREAD_SAFE
     std::mutex _mutex;
     std::condition_variable _condition_var;
 #endif    
 
+    static const size_t _min_capacity = 16;
+
+    void init() {
+        _name_literal = 0;
+        _id = 0;
+        _data = 0;
+        _capacity = 0;
+        _head = 0;
+        _count = 0;
+        _n_written = 0;
+        _n_timed_reads = 0;
+        _fifo = 0;
+        _fifo_found = false;
+    }
+
   public:
     /// Constructors
     // Keep consistent with the synthesis model's constructors
     stream() {
         static unsigned _counter = 1;
-        std::stringstream ss;
-#ifndef _MSC_VER
-        char* _demangle_name = abi::__cxa_demangle(typeid(*this).name(), 0, 0, 0);
-        if (_demangle_name) {
-            _name = _demangle_name;
-            free(_demangle_name);
-        }
-        else {
-            _name = "hls_stream";
-        }
-#else
-        _name = typeid(*this).name();
-#endif
+        init();
+        _id = _counter++;
+    }
 
-        ss << _counter++;
-        _name += "." + ss.str();
+    // The name must outlive the stream, as string literals do
+    stream(const char *name) {
+        init();
+        _name_literal = name;
     }
 
     stream(const std::string name) {
     // default constructor,
     // capacity set to predefined maximum
+        init();
         _name = name;
     }
 
   /// Make copy constructor and assignment operator private
   private:
-    stream(const stream< __STREAM_T__ >& chn):
-        _name(chn._name), _data(chn._data) {
+    stream(const stream< __STREAM_T__ >& chn);
+
+    stream& operator = (const stream< __STREAM_T__ >& chn);
+
+    void grow() {
+        size_t capacity = _capacity > 0 ? 2 * _capacity : _min_capacity;
+        if (_capacity == 0 && stream_buffer_pool<__STREAM_T__>::get().acquire(_data, _capacity)) {
+            return;
+        }
+        __STREAM_T__ *data = new __STREAM_T__[capacity];
+        for (size_t i = 0; i < _count; i++) {
+            data[i] = _data[(_head + i) & (_capacity - 1)];
+        }
+        delete[] _data;
+        _data = data;
+        _capacity = capacity;
+        _head = 0;
+    }
+
+    void push(const __STREAM_T__& tail) {
+        if (_count == _capacity) grow();
+        _data[(_head + _count) & (_capacity - 1)] = tail;
+        _count++;
+    }
+
+    void pop(__STREAM_T__& head) {
+        head = _data[_head];
+        _head = (_head + 1) & (_capacity - 1);
+        _count--;
+    }
+
+  public:
+    const std::string &name() const {
+        if (_name.empty()) {
+            if (_name_literal != 0) {
+                _name = _name_literal;
+            } else {
+#ifndef _MSC_VER
+                char* _demangle_name = abi::__cxa_demangle(typeid(*this).name(), 0, 0, 0);
+                if (_demangle_name) {
+                    _name = _demangle_name;
+                    free(_demangle_name);
+                }
+                else {
+                    _name = "hls_stream";
+                }
+#else
+                _name = typeid(*this).name();
+#endif
+                std::stringstream ss;
+                ss << _id;
+                _name += "." + ss.str();
+            }
+        }
+        return _name;
+    }
+
+  private:
+    timing::fifo *timing_fifo() {
+        if (!_fifo_found) {
+            _fifo = timing::find_fifo(name());
+            _fifo_found = true;
+        }
+        return _fifo;
     }
 
-    stream& operator = (const stream< __STREAM_T__ >& chn) {
-        _name = chn._name;
-        _data = chn._data;
-        return *this;
+    void timing_write() {
+        if (timing::get_model().enabled) {
+            _available.push_back(timing::on_write(timing_fifo(), _n_written));
+        }
+        _n_written++;
+    }
+
+    void timing_read() {
+        if (_n_timed_reads < _available.size()) {
+            timing::on_read(this, timing_fifo(), _available[_n_timed_reads++]);
+        }
     }
 
   public:
@@ -161,14 +481,17 @@ class stream
     /// Destructor
     /// Check status of the queue
     virtual ~stream() {
-        if (!_data.empty())
+        if (_count > 0)
         {
             std::cout << "WARNING: Hls::stream '" 
-                      << _name 
+                      << name() 
                       << "' contains leftover data,"
                       << " which may result in RTL simulation hanging."
                       << std::endl;
         }
+        if (_data != 0) {
+            stream_buffer_pool<__STREAM_T__>::get().release(_data, _capacity);
+        }
     }
 
     /// Status of the queue
@@ -176,7 +499,7 @@ class stream
 #ifdef HLS_STREAM_THREAD_SAFE
         std::lock_guard<std::mutex> lg(_mutex);
 #endif
-        return _data.empty();
+        return _count == 0;
     }    
 
     bool full() const { return false; }
@@ -189,28 +512,28 @@ class stream
 #ifdef HLS_STREAM_THREAD_SAFE
     __STREAM_T__ read() {
         std::unique_lock<std::mutex> ul(_mutex);
-        while (_data.empty()) {
+        while (_count == 0) {
             _condition_var.wait(ul);
         }
 
         __STREAM_T__ elem;
-        elem = _data.front();
-        _data.pop_front();
+        pop(elem);
+        timing_read();
         return elem;
     }
 #else
     __STREAM_T__ read() {
         __STREAM_T__ elem;
-        if (_data.empty()) {
+        if (_count == 0) {
             std::cout << "WARNING: Hls::stream '"
-                      << _name 
+                      << name() 
                       << "' is read while empty,"
                       << " which may result in RTL simulation hanging."
                       << std::endl;
             elem = __STREAM_T__();
         } else {
-            elem = _data.front();
-            _data.pop_front();
+            pop(elem);
+            timing_read();
         }
         return elem;
     }
@@ -221,7 +544,8 @@ class stream
 #ifdef HLS_STREAM_THREAD_SAFE
         std::unique_lock<std::mutex> ul(_mutex);
 #endif
-        _data.push_back(tail);
+        push(tail);
+        timing_write();
 #ifdef HLS_STREAM_THREAD_SAFE
         _condition_var.notify_one();
 #endif
@@ -232,13 +556,12 @@ class stream
 #ifdef HLS_STREAM_THREAD_SAFE
         std::lock_guard<std::mutex> lg(_mutex);
 #endif    
-        bool is_empty = _data.empty();
+        bool is_empty = (_count == 0);
         if (is_empty) {
             head = __STREAM_T__();
         } else {
-            __STREAM_T__ elem(_data.front());
-            _data.pop_front();
-            head = elem;
+            pop(head);
+            timing_read();
         }
         return !is_empty;
     }
@@ -252,7 +575,7 @@ class stream
 
     /// Fifo size
     size_t size() {
-        return _data.size();
+        return _count;
     }
 };
 
@@ -163,6 +163,11 @@ if {$opt(reset)} {
 }
 catch {config_array_partition -maximum_size 4096}
 config_compile -name_max_length 60
+# Layers that keep state between calls (incremental inference, multi-context recurrent layers) hold it in static
+# variables, which the reset only clears with config_rtl -reset state
+if {[info exists reset_state] && $reset_state} {
+    config_rtl -reset state
+}
 set_part $part
 create_clock -period $clock_period -name default
 
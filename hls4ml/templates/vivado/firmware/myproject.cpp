@@ -21,6 +21,13 @@
 #include "myproject.h"
 #include "parameters.h"
 
+#ifndef __SYNTHESIS__
+// Weights are loaded on the first call, unless they were already loaded when replaced at runtime (see set_weights in myproject_bridge.cpp)
+bool myproject_loaded_weights = false;
+#endif
+
+//hls-fpga-machine-learning insert arena
+
 void myproject(
 	//hls-fpga-machine-learning insert header
 ) {
@@ -28,10 +35,9 @@ void myproject(
     //hls-fpga-machine-learning insert IO
 
 #ifndef __SYNTHESIS__
-    static bool loaded_weights = false;
-    if (!loaded_weights) {
+    if (!myproject_loaded_weights) {
         //hls-fpga-machine-learning insert load weights
-        loaded_weights = true;
+        myproject_loaded_weights = true;
     }
 #endif
 
@@ -2,6 +2,7 @@
 #define MYPROJECT_BRIDGE_H_
 
 #include "firmware/myproject.h"
+#include "firmware/nnet_utils/nnet_common.h"
 #include "firmware/nnet_utils/nnet_helpers.h"
 #include <algorithm>
 #include <map>
@@ -9,6 +10,10 @@
 //hls-fpga-machine-learning insert bram
 
 
+// Weights of the layers, defined in firmware/myproject.cpp
+extern bool myproject_loaded_weights;
+//hls-fpga-machine-learning insert weights declarations
+
 namespace nnet {
     bool trace_enabled = false;
     std::map<std::string, void *> *trace_outputs = NULL;
@@ -49,6 +54,104 @@ void collect_trace_output(struct trace_data *c_trace_outputs) {
     }
 }
 
+// Timing model of the dataflow design (io_stream), see hls::timing in ap_types/hls_stream.h
+struct timing_process_data {
+    const char *name;
+    unsigned long long start;
+    unsigned long long interval;
+    unsigned long long end;
+};
+
+struct timing_fifo_data {
+    const char *name;
+    unsigned long long depth;
+    unsigned long long max_occupancy;
+    unsigned long long full_stalls;
+    unsigned long long empty_stalls;
+};
+
+void enable_timing_model() {
+    hls::timing::model &model = hls::timing::get_model();
+    model.enabled = true;
+    model.fifos.clear();
+    //hls-fpga-machine-learning insert fifo depths
+}
+
+void disable_timing_model() {
+    hls::timing::model &model = hls::timing::get_model();
+    model.enabled = false;
+    model.fifos.clear();
+    model.processes.clear();
+}
+
+void begin_timing_pass() {
+    hls::timing::begin_pass();
+}
+
+// Returns 1 if the timing of the design is resolved, i.e., another pass would give the same result
+int end_timing_pass() {
+    return hls::timing::end_pass() ? 1 : 0;
+}
+
+unsigned long long get_timing_latency(size_t *n_processes, size_t *n_fifos) {
+    hls::timing::model &model = hls::timing::get_model();
+    *n_processes = model.processes.size();
+    *n_fifos = model.fifos.size();
+    return model.latency;
+}
+
+void collect_timing(struct timing_process_data *c_processes, struct timing_fifo_data *c_fifos) {
+    hls::timing::model &model = hls::timing::get_model();
+    int ii = 0;
+    for (std::map<std::string, hls::timing::process>::iterator i = model.processes.begin(); i != model.processes.end(); i++) {
+        c_processes[ii].name = i->first.c_str();
+        c_processes[ii].start = i->second.start;
+        c_processes[ii].interval = i->second.next_start - i->second.start;
+        c_processes[ii].end = i->second.written ? i->second.last_write + 1 : i->second.next_start;
+        ii++;
+    }
+    ii = 0;
+    for (std::map<std::string, hls::timing::fifo>::iterator i = model.fifos.begin(); i != model.fifos.end(); i++) {
+        c_fifos[ii].name = i->first.c_str();
+        c_fifos[ii].depth = i->second.depth;
+        c_fifos[ii].max_occupancy = hls::timing::max_occupancy(i->second);
+        c_fifos[ii].full_stalls = i->second.full_stalls;
+        c_fifos[ii].empty_stalls = i->second.empty_stalls;
+        ii++;
+    }
+}
+
+// Replaces the weights of a layer (identified by its index), without recompiling the library
+// All weights of the layer are read from a single buffer of floats (element_size = 4) or doubles (element_size = 8),
+// in the order in which they are defined; returns -1 if the layer has no weights that can be replaced
+int set_weights(unsigned layer_id, const void *data, size_t element_size) {
+    // Weights that are not replaced are loaded first, as they would be on the first call of the top level function
+    if (!myproject_loaded_weights) {
+        //hls-fpga-machine-learning insert load weights
+        myproject_loaded_weights = true;
+    }
+
+    size_t offset = 0;
+    switch (layer_id) {
+        //hls-fpga-machine-learning insert set weights
+        default:
+            return -1;
+    }
+    return 0;
+}
+
+// Clears the state kept between calls by the incremental (sliding window) and multi-context layers, see nnet::incremental_reset
+void reset_incremental_state() {
+    nnet::incremental_epoch()++;
+}
+
+// Context of the recurrent layers with several contexts, passed to the top level function by the wrappers
+unsigned recurrent_context = 0;
+
+void set_recurrent_context(unsigned context) {
+    recurrent_context = context;
+}
+
 // Wrapper of top level function for Python bridge
 void myproject_float(
     //hls-fpga-machine-learning insert header #float
@@ -32,6 +32,8 @@ struct activ_config
 {
     // IO size
     static const unsigned n_in = 10;
+    // Length of the softmax axis; in io_stream it may span several stream words
+    static const unsigned n_slice = 1;
 
     // Internal info
     static const unsigned table_size = 1024;
@@ -328,10 +330,12 @@ void init_invert_table_legacy(typename CONFIG_T::inv_table_t table_out[N_TABLE])
 }
 
 
-template<class data_T, class res_T, typename CONFIG_T>
-void  softmax_legacy(data_T data[CONFIG_T::n_in], res_T res[CONFIG_T::n_in])
+// With masked, only the first n_valid inputs take part in the softmax, the others get a zero output (e.g., masked
+// attention scores). Without it, n_valid is ignored and the mask is removed at compile time.
+template<class data_T, class res_T, typename CONFIG_T, bool masked>
+void  softmax_legacy_body(data_T data[CONFIG_T::n_in], const unsigned n_valid, res_T res[CONFIG_T::n_in])
 {
-	#pragma HLS pipeline
+    #pragma HLS inline
     int exp_range = CONFIG_T::exp_range;
     int inv_range = CONFIG_T::inv_range;
     // Initialize the lookup table
@@ -368,17 +372,17 @@ void  softmax_legacy(data_T data[CONFIG_T::n_in], res_T res[CONFIG_T::n_in])
     typename CONFIG_T::inv_table_t deno_inver;
 
     denominator = 0;
-    for (int ii=0; ii<CONFIG_T::n_in; ii++) {
+    for (unsigned ii=0; ii<CONFIG_T::n_in; ii++) {
 		data_round = data[ii]*(CONFIG_T::table_size/(exp_range*2));
         // std::cout << " data, round: " << data[ii] << " " << data_round << std::endl;  /////
 		index = data_round + exp_range*(CONFIG_T::table_size/(exp_range*2));
         // std::cout << " index: " << index;   /////
 		if (index < 0)   index = 0;
 		if (index > CONFIG_T::table_size-1) index = CONFIG_T::table_size-1;
-		denominator += exp_table[index];
+		data_cache[ii] = (!masked || ii < n_valid) ? exp_table[index] : (typename CONFIG_T::exp_table_t) 0;
+		denominator += data_cache[ii];
         // std::cout << "   denominator " << index << std::endl;   /////
         // std::cout << "   denominator " << denominator << std::endl;   /////
-		data_cache[ii] = exp_table[index];
     }
     // std::cout << "end  " << std::endl;    /////
 
@@ -395,13 +399,27 @@ void  softmax_legacy(data_T data[CONFIG_T::n_in], res_T res[CONFIG_T::n_in])
 	deno_inver = invert_table[exp_res_index];
     // std::cout << " deno_inver: " << deno_inver << std::endl;  /////
 
-	for (int ii=0; ii<CONFIG_T::n_in; ii++) {
+	for (unsigned ii=0; ii<CONFIG_T::n_in; ii++) {
 		res[ii] = (res_T) (data_cache[ii]*deno_inver);
 	}
 
 
 }
 
+template<class data_T, class res_T, typename CONFIG_T>
+void  softmax_legacy(data_T data[CONFIG_T::n_in], res_T res[CONFIG_T::n_in])
+{
+	#pragma HLS pipeline
+    softmax_legacy_body<data_T, res_T, CONFIG_T, false>(data, CONFIG_T::n_in, res);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void  softmax_legacy(data_T data[CONFIG_T::n_in], const unsigned n_valid, res_T res[CONFIG_T::n_in])
+{
+	#pragma HLS pipeline
+    softmax_legacy_body<data_T, res_T, CONFIG_T, true>(data, n_valid, res);
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void softmax(data_T data[CONFIG_T::n_in], res_T res[CONFIG_T::n_in]){
     #pragma HLS inline
@@ -248,17 +248,178 @@ void softmax_stable(hls::stream<data_T> &data, hls::stream<res_T> &res){
     }
 }
 
+// The multi-beat variants handle a softmax axis (CONFIG_T::n_slice) spread over several stream words.
+// All beats of a slice are buffered while the max/sum are accumulated, then the buffer is normalized
+// and emitted, so only one beat's worth of multipliers is needed.
+template <class data_T, class res_T, typename CONFIG_T>
+void softmax_latency_multibeat(hls::stream<data_T> &data, hls::stream<res_T> &res){
+    // Initialize the lookup tables
+#ifdef __HLS_SYN__
+    bool initialized = false;
+    typename CONFIG_T::exp_table_t exp_table[CONFIG_T::table_size];
+    typename CONFIG_T::inv_table_t invert_table[CONFIG_T::table_size];
+#else
+    static bool initialized = false;
+    static typename CONFIG_T::exp_table_t exp_table[CONFIG_T::table_size];
+    static typename CONFIG_T::inv_table_t invert_table[CONFIG_T::table_size];
+
+#endif
+    if (!initialized) {
+        // Note we are exponentiating the inputs, which have type data_T
+        init_exp_table<typename data_T::value_type, CONFIG_T>(exp_table);
+        // Note we are inverting the exponentials, which have type exp_table_t
+        init_invert_table<typename CONFIG_T::exp_table_t, CONFIG_T>(invert_table);
+        initialized = true;
+    }
+
+    constexpr unsigned multiplier_limit = DIV_ROUNDUP(data_T::size, CONFIG_T::reuse_factor);
+    constexpr unsigned ii = data_T::size / multiplier_limit;
+    constexpr unsigned n_beats = DIV_ROUNDUP(CONFIG_T::n_slice, data_T::size);
+
+    typename CONFIG_T::exp_table_t exp_buffer[n_beats][data_T::size];
+    #pragma HLS ARRAY_PARTITION variable=exp_buffer complete dim=2
+
+    SoftmaxSliceLoop: for(unsigned s = 0; s < CONFIG_T::n_in / CONFIG_T::n_slice; s++){
+        // First pass: calculate and buffer the e^x's, accumulating their sum across beats
+        typename CONFIG_T::exp_table_t exp_sum(0);
+        SoftmaxExpLoop: for(unsigned i = 0; i < n_beats; i++){
+            #pragma HLS PIPELINE II=ii
+
+            data_T in_pack = data.read();
+            typename CONFIG_T::exp_table_t exp_res[data_T::size];
+            #pragma HLS ARRAY_PARTITION variable=exp_res complete
+            SoftmaxExpPackLoop: for(unsigned j = 0; j < data_T::size; j++){
+                #pragma HLS UNROLL
+                unsigned x = softmax_idx_from_real_val<typename data_T::value_type, CONFIG_T>(in_pack[j]);
+                exp_res[j] = exp_table[x];
+                exp_buffer[i][j] = exp_res[j];
+            }
+
+            Op_add<typename CONFIG_T::exp_table_t> op_add;
+            exp_sum += reduce<typename CONFIG_T::exp_table_t, data_T::size, Op_add<typename CONFIG_T::exp_table_t>>(exp_res, op_add);
+        }
+
+        typename CONFIG_T::inv_table_t inv_exp_sum = invert_table[softmax_idx_from_real_val<typename CONFIG_T::exp_table_t,CONFIG_T>(exp_sum)];
+
+        // Second pass: normalize the buffered beats
+        SoftmaxInvLoop: for(unsigned i = 0; i < n_beats; i++){
+            #pragma HLS PIPELINE II=ii
+
+            res_T out_pack;
+            #pragma HLS DATA_PACK variable=out_pack
+            SoftmaxInvPackLoop: for(unsigned j = 0; j < res_T::size; j++){
+                #pragma HLS UNROLL
+                #pragma HLS ALLOCATION instances=mul limit=multiplier_limit operation
+                out_pack[j] = exp_buffer[i][j] * inv_exp_sum;
+            }
+            res.write(out_pack);
+        }
+    }
+}
+
+template <class data_T, class res_T, typename CONFIG_T>
+void softmax_stable_multibeat(hls::stream<data_T> &data, hls::stream<res_T> &res){
+    // Initialize the lookup tables
+#ifdef __HLS_SYN__
+    bool initialized = false;
+    typename CONFIG_T::exp_table_t exp_table[CONFIG_T::table_size];
+    typename CONFIG_T::inv_table_t invert_table[CONFIG_T::table_size];
+#else
+    static bool initialized = false;
+    static typename CONFIG_T::exp_table_t exp_table[CONFIG_T::table_size];
+    static typename CONFIG_T::inv_table_t invert_table[CONFIG_T::table_size];
+
+#endif
+    if (!initialized) {
+        // Note we are exponentiating the inputs, which have type data_T
+        init_exp_table<typename data_T::value_type, CONFIG_T>(exp_table);
+        // Note we are inverting the exponentials, which have type exp_table_t
+        init_invert_table<typename CONFIG_T::exp_table_t, CONFIG_T>(invert_table);
+        initialized = true;
+    }
+
+    constexpr unsigned multiplier_limit = DIV_ROUNDUP(data_T::size, CONFIG_T::reuse_factor);
+    constexpr unsigned ii = data_T::size / multiplier_limit;
+    constexpr unsigned n_beats = DIV_ROUNDUP(CONFIG_T::n_slice, data_T::size);
+
+    // For the diffs, use the same type as the input but force rounding and saturation
+    typedef ap_fixed<data_T::value_type::width, data_T::value_type::iwidth,AP_RND,AP_SAT> diff_t;
+
+    typename data_T::value_type data_buffer[n_beats][data_T::size];
+    #pragma HLS ARRAY_PARTITION variable=data_buffer complete dim=2
+
+    SoftmaxSliceLoop: for(unsigned s = 0; s < CONFIG_T::n_in / CONFIG_T::n_slice; s++){
+        // First pass: buffer the inputs while tracking the running max and the sum of e^(x - max).
+        // Whenever the max grows, the partial sum is rescaled by e^(old_max - new_max).
+        typename data_T::value_type x_max;
+        typename CONFIG_T::exp_table_t exp_sum(0);
+        SoftmaxMaxLoop: for(unsigned i = 0; i < n_beats; i++){
+            #pragma HLS PIPELINE II=ii
+
+            data_T in_pack = data.read();
+            typename data_T::value_type data_array[data_T::size];
+            #pragma HLS ARRAY_PARTITION variable=data_array complete
+            SoftmaxArrayPackLoop: for(unsigned j = 0; j < data_T::size; j++){
+                #pragma HLS UNROLL
+                data_array[j] = in_pack[j];
+                data_buffer[i][j] = in_pack[j];
+            }
+
+            Op_max<typename data_T::value_type> op_max;
+            typename data_T::value_type beat_max = reduce<typename data_T::value_type, data_T::size, Op_max<typename data_T::value_type>>(data_array, op_max);
+            if (i == 0) {
+                x_max = beat_max;
+            }
+            typename data_T::value_type new_max = (beat_max > x_max) ? beat_max : x_max;
+
+            typename CONFIG_T::exp_table_t exp_res[data_T::size];
+            #pragma HLS ARRAY_PARTITION variable=exp_res complete
+            SoftmaxExpPackLoop: for(unsigned j = 0; j < data_T::size; j++){
+                #pragma HLS UNROLL
+                diff_t d_xi_xmax = data_array[j] - new_max;
+                exp_res[j] = exp_table[softmax_idx_from_real_val<diff_t, CONFIG_T>(d_xi_xmax)];
+            }
+
+            Op_add<typename CONFIG_T::exp_table_t> op_add;
+            typename CONFIG_T::exp_table_t beat_sum = reduce<typename CONFIG_T::exp_table_t, data_T::size, Op_add<typename CONFIG_T::exp_table_t>>(exp_res, op_add);
+
+            // On the first beat x_max == new_max and exp_sum is zero, so the rescale has no effect
+            diff_t d_max = x_max - new_max;
+            typename CONFIG_T::exp_table_t rescale = exp_table[softmax_idx_from_real_val<diff_t, CONFIG_T>(d_max)];
+            exp_sum = exp_sum * rescale + beat_sum;
+            x_max = new_max;
+        }
+
+        typename CONFIG_T::inv_table_t inv_exp_sum = invert_table[softmax_idx_from_real_val<typename CONFIG_T::exp_table_t,CONFIG_T>(exp_sum)];
+
+        // Second pass: recompute e^(x - max) from the buffered inputs and normalize
+        SoftmaxInvLoop: for(unsigned i = 0; i < n_beats; i++){
+            #pragma HLS PIPELINE II=ii
+
+            res_T out_pack;
+            #pragma HLS DATA_PACK variable=out_pack
+            SoftmaxInvPackLoop: for(unsigned j = 0; j < res_T::size; j++){
+                #pragma HLS UNROLL
+                #pragma HLS ALLOCATION instances=mul limit=multiplier_limit operation
+                diff_t d_xi_xmax = data_buffer[i][j] - x_max;
+                out_pack[j] = exp_table[softmax_idx_from_real_val<diff_t, CONFIG_T>(d_xi_xmax)] * inv_exp_sum;
+            }
+            res.write(out_pack);
+        }
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void softmax_legacy(hls::stream<data_T> &data, hls::stream<res_T> &res) {
     // Initialize the lookup table
 #ifdef __HLS_SYN__
     bool initialized = false;
-    typename CONFIG_T::table_t exp_table[CONFIG_T::table_size];
-    typename CONFIG_T::table_t invert_table[CONFIG_T::table_size];
+    typename CONFIG_T::exp_table_t exp_table[CONFIG_T::table_size];
+    typename CONFIG_T::inv_table_t invert_table[CONFIG_T::table_size];
 #else
     static bool initialized = false;
-    static typename CONFIG_T::table_t exp_table[CONFIG_T::table_size];
-    static typename CONFIG_T::table_t invert_table[CONFIG_T::table_size];
+    static typename CONFIG_T::exp_table_t exp_table[CONFIG_T::table_size];
+    static typename CONFIG_T::inv_table_t invert_table[CONFIG_T::table_size];
 #endif
     if (!initialized) {
         init_exp_table_legacy<CONFIG_T, CONFIG_T::table_size>(exp_table);
@@ -267,8 +428,8 @@ void softmax_legacy(hls::stream<data_T> &data, hls::stream<res_T> &res) {
     }
 
     // Index into the lookup table based on data for exponentials
-    typename CONFIG_T::table_t exp_res[data_T::size];
-    typename CONFIG_T::table_t exp_diff_res;
+    typename CONFIG_T::accum_t exp_res[data_T::size];
+    typename CONFIG_T::exp_table_t exp_diff_res;
     typename data_T::value_type data_cache[data_T::size];
 
     SoftmaxInitLoop: for(unsigned s = 0; s < CONFIG_T::n_in / data_T::size; s++) {
@@ -288,8 +449,8 @@ void softmax_legacy(hls::stream<data_T> &data, hls::stream<res_T> &res) {
                 if (i == j) {
                     exp_diff_res = 1;
                 } else {
-                    int data_round = (data_cache[j] - data_cache[i]) * CONFIG_T::table_size / 16;
-                    int index = data_round + 8 * CONFIG_T::table_size / 16;
+                    int data_round = (data_cache[j] - data_cache[i]) * CONFIG_T::table_size / (CONFIG_T::exp_range * 2);
+                    int index = data_round + CONFIG_T::exp_range * CONFIG_T::table_size / (CONFIG_T::exp_range * 2);
                     if (index < 0) index = 0;
                     if (index > CONFIG_T::table_size - 1) index = CONFIG_T::table_size - 1;
                     exp_diff_res = exp_table[index];
@@ -304,7 +465,7 @@ void softmax_legacy(hls::stream<data_T> &data, hls::stream<res_T> &res) {
         SoftmaxInvPackLoop: for(unsigned j = 0; j < res_T::size; j++) {
             #pragma HLS UNROLL
 
-            int exp_res_index = exp_res[j] * CONFIG_T::table_size / 64;
+            int exp_res_index = exp_res[j] * CONFIG_T::table_size / CONFIG_T::inv_range;
             if (exp_res_index < 0) exp_res_index = 0;
             if (exp_res_index > CONFIG_T::table_size - 1) exp_res_index = CONFIG_T::table_size - 1;
 
@@ -320,12 +481,21 @@ void softmax(hls::stream<data_T> &data, hls::stream<res_T> &res){
 
     switch(CONFIG_T::implementation){
     case softmax_implementation::latency:
-        softmax_latency<data_T, res_T, CONFIG_T>(data, res);
+        if (CONFIG_T::n_slice > data_T::size) {
+            softmax_latency_multibeat<data_T, res_T, CONFIG_T>(data, res);
+        } else {
+            softmax_latency<data_T, res_T, CONFIG_T>(data, res);
+        }
         break;
     case softmax_implementation::stable:
-        softmax_stable<data_T, res_T, CONFIG_T>(data, res);
+        if (CONFIG_T::n_slice > data_T::size) {
+            softmax_stable_multibeat<data_T, res_T, CONFIG_T>(data, res);
+        } else {
+            softmax_stable<data_T, res_T, CONFIG_T>(data, res);
+        }
         break;
     case softmax_implementation::legacy:
+        assert(CONFIG_T::n_slice <= data_T::size);
         softmax_legacy<data_T, res_T, CONFIG_T>(data, res);
         break;
     }    
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include "nnet_helpers.h"
+#include "nnet_mult.h"
 
 namespace nnet {
 
@@ -30,6 +31,18 @@ class FillConv2DBuffer{
     }
 };
 
+template<class data_T, class res_T, typename CONFIG_T>
+class DenseShiftAdd{
+    public:
+    static void dense(
+        data_T data[CONFIG_T::n_in],
+        res_T res[CONFIG_T::n_out],
+        typename CONFIG_T::bias_t biases[CONFIG_T::n_out]
+    ) {
+        // To be implemented in subclasses
+    }
+};
+
 //hls4ml insert code
 
 }
@@ -95,6 +95,30 @@ enum strategy { latency, resource };
      }
  };
 
+// Incremental (sliding window) inference: the layers with CONFIG_T::incremental keep the end of their input window
+// (or their recurrent state) in static variables between calls, as do the recurrent layers with several contexts.
+// In hardware, a new series is started by asserting the reset (ap_rst) of the top-level function. The reset only clears
+// static variables with 'config_rtl -reset state', which build_prj.tcl sets for the models that have such layers
+// (reset_state in project.tcl); with the default '-reset control' the state of the previous series is kept.
+// In C simulation, the state is cleared on the first call after the epoch is incremented (reset_incremental_state() of
+// the bridge).
+inline unsigned long &incremental_epoch() {
+    static unsigned long epoch = 0;
+    return epoch;
+}
+
+template<class CONFIG_T>
+bool incremental_reset() {
+#ifndef __SYNTHESIS__
+    static unsigned long epoch = 0;
+    if (epoch != incremental_epoch()) {
+        epoch = incremental_epoch();
+        return true;
+    }
+#endif
+    return false;
+}
+
 }
 
 #endif
@@ -49,6 +49,10 @@ struct conv1d_config
     static const unsigned reuse_factor = 1;
     static const bool store_weights_in_bram = false;
     static const unsigned n_zeros = 0; // not used yet
+
+    // Sliding window inference (io_stream), in_width new pixels per call, see conv_1d_incremental_cl
+    static const bool incremental = false;
+    static const unsigned incremental_offset = stride_width - 1;
 };
 
 template<class data_T, class res_T, typename CONFIG_T>
@@ -47,9 +47,7 @@ void conv_1d_latency_cl(
             // Do the matrix-multiply
             Product1: for(int i_in = 0; i_in < mult_n_in; i_in++) {
                 cache = data_buf[i_pxl][i_in];
-                Product2: for(int i_out = 0; i_out < mult_n_out; i_out++) {
-                    mult[i_in * mult_n_out + i_out] = CONFIG_T::mult_config::template product<data_T, typename CONFIG_T::mult_config::weight_t>::product(cache, weights[i_in * mult_n_out + i_out]);
-                }
+                product_row<typename CONFIG_T::mult_config::template product<data_T, typename CONFIG_T::mult_config::weight_t>, mult_n_out>(cache, &weights[i_in * mult_n_out], &mult[i_in * mult_n_out]);
             }
 
             // Initialize accumulator with input biases
@@ -66,7 +64,7 @@ void conv_1d_latency_cl(
 
             // Cast to "res_t" type
             Result: for(int i_res = 0; i_res < mult_n_out; i_res++){
-                *(res++) = cast<data_T, res_T, CONFIG_T>(acc[i_res]);
+                *(res++) = cast<data_T, res_T, typename CONFIG_T::mult_config>(acc[i_res], i_res);
             }
 
         }
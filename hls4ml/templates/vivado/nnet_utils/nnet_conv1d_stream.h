@@ -17,7 +17,8 @@ void compute_scaled_indices_1d(
     ComputeIndex: for (unsigned p = 0; p < data_T::size / CONFIG_T::n_chan; p++) {
         #pragma HLS UNROLL
 
-        unsigned sw_idx = scale_index<CONFIG_T::filt_width, CONFIG_T::stride_width, CONFIG_T::in_width>(wp_idx + p);
+        // A dilated kernel is scaled with its span, the pixels between the taps are not in the instructions
+        unsigned sw_idx = scale_index<CONFIG_T::dilation * (CONFIG_T::filt_width - 1) + 1, CONFIG_T::stride_width, CONFIG_T::in_width>(wp_idx + p);
         pixel_idx[p] = CONFIG_T::pixels[sw_idx];
     }
 }
@@ -70,7 +71,32 @@ void conv_1d_buffer_cl(
         if (CONFIG_T::strategy == nnet::latency) {
             #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
         }
-        compute_output_buffer_1d<data_T, res_T, CONFIG_T>(data.read(), res, weights, biases);
+        if (CONFIG_T::dilation > 1) {
+            compute_output_buffer_dilated_1d<data_T, res_T, CONFIG_T>(data.read(), res, weights, biases);
+        } else {
+            compute_output_buffer_1d<data_T, res_T, CONFIG_T>(data.read(), res, weights, biases);
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_incremental_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    assert(CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
+
+    // in_width is the number of new pixels of each call
+    const bool reset = incremental_reset<CONFIG_T>();
+
+    ReadInputWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::in_width; i_iw++) {
+        #pragma HLS LOOP_FLATTEN
+        if (CONFIG_T::strategy == nnet::latency) {
+            #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+        }
+        compute_output_incremental_1d<data_T, res_T, CONFIG_T>(data.read(), reset && i_iw == 0, res, weights, biases);
     }
 }
 
@@ -82,6 +108,10 @@ void conv_1d_cl(
     typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
 {
     #pragma HLS inline region
+    if (CONFIG_T::incremental) {
+        conv_1d_incremental_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+        return;
+    }
     switch(CONFIG_T::implementation){
         case conv_implementation::linebuffer:
             conv_1d_buffer_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
@@ -14,13 +14,14 @@ void compute_scaled_indices_2d(
     const unsigned w_idx,
     ap_uint<CONFIG_T::filt_height * CONFIG_T::filt_width> *pixel_idx
 ) {
-    const unsigned sh_idx = scale_index<CONFIG_T::filt_height, CONFIG_T::stride_height, CONFIG_T::in_height>(h_idx);
+    // A dilated kernel is scaled with its span, the pixels between the taps are not in the instructions
+    const unsigned sh_idx = scale_index<CONFIG_T::dilation_height * (CONFIG_T::filt_height - 1) + 1, CONFIG_T::stride_height, CONFIG_T::in_height>(h_idx);
     unsigned wp_idx = w_idx * (data_T::size / CONFIG_T::n_chan);
 
     ComputeIndex: for (unsigned p = 0; p < data_T::size / CONFIG_T::n_chan; p++) {
         #pragma HLS UNROLL
 
-        unsigned sw_idx = scale_index<CONFIG_T::filt_width, CONFIG_T::stride_width, CONFIG_T::in_width>(wp_idx + p);
+        unsigned sw_idx = scale_index<CONFIG_T::dilation_width * (CONFIG_T::filt_width - 1) + 1, CONFIG_T::stride_width, CONFIG_T::in_width>(wp_idx + p);
         pixel_idx[p] = CONFIG_T::pixels[sh_idx * CONFIG_T::min_width + sw_idx];
     }
 }
@@ -36,7 +37,7 @@ void conv_2d_encoded_cl(
     assert(CONFIG_T::filt_height == CONFIG_T::filt_width);
 
     hls::stream<typename data_T::value_type> data_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
-    const int win_depth = CONFIG_T::filt_height * CONFIG_T::out_width;
+    const int win_depth = (CONFIG_T::dilation_height * (CONFIG_T::filt_height - 1) + 1) * CONFIG_T::out_width;
     for (unsigned i_out = 0; i_out < CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan; i_out++) {
         #pragma HLS STREAM variable=data_window[i_out] depth=win_depth
     }
@@ -90,6 +91,30 @@ void conv_2d_buffer_cl(
     }
 }
 
+// Line Buffer of a dilated kernel, each line buffer holds dilation_height lines
+template <class data_T, class res_T, typename CONFIG_T>
+void conv_2d_buffer_dilated_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_filt])
+{
+    assert(CONFIG_T::pad_top == 0 && CONFIG_T::pad_bottom == 0 && CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
+
+    static ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable = line_buffer complete dim = 2
+
+    ReadInputHeight: for (unsigned i_ih = 0; i_ih < CONFIG_T::in_height; i_ih++) {
+        ReadInputWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::in_width; i_iw++) {
+            #pragma HLS LOOP_FLATTEN
+            if(CONFIG_T::strategy == nnet::latency) {
+                #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+            }
+            compute_output_buffer_dilated_2d<data_T, res_T, CONFIG_T>(data.read(), line_buffer, res, weights, biases);
+        }
+    }
+}
+
 template <class data_T, class res_T, typename CONFIG_T>
 void conv_2d_cl(
     hls::stream<data_T> &data,
@@ -100,7 +125,11 @@ void conv_2d_cl(
     #pragma HLS inline region
     switch(CONFIG_T::implementation){
         case conv_implementation::linebuffer:
-            conv_2d_buffer_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+            if (CONFIG_T::dilation_height > 1 || CONFIG_T::dilation_width > 1) {
+                conv_2d_buffer_dilated_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+            } else {
+                conv_2d_buffer_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+            }
             break;
         case conv_implementation::encoded:
             conv_2d_encoded_cl<data_T, res_T, CONFIG_T>(data, res, weights, biases);
@@ -371,5 +371,269 @@ void compute_output_buffer_1d(
     }
 }
 
+// Incremental (sliding window) version: the kernel window and the stride counter are kept between calls, so each call
+// only reads the new pixels. An output is computed for every input pixel at index incremental_offset modulo the stride,
+// the outputs of the first calls include the zeros the window is initialized with.
+template<class data_T, class res_T, typename CONFIG_T>
+void compute_output_incremental_1d(
+    const data_T& in_elem,
+    const bool reset,
+    hls::stream<res_T> &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::kernel_size * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_filt]
+) {
+    #pragma HLS INLINE
+
+    const static unsigned first_phase = (CONFIG_T::stride_width - CONFIG_T::incremental_offset % CONFIG_T::stride_width) % CONFIG_T::stride_width;
+
+    static unsigned phase = first_phase;
+
+    static typename data_T::value_type kernel_data[CONFIG_T::filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+
+    typename res_T::value_type res_out[CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
+
+    res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+
+    if (reset) {
+        phase = first_phase;
+        ResetKernel: for (unsigned i = 0; i < CONFIG_T::filt_width * CONFIG_T::n_chan; i++) {
+            #pragma HLS UNROLL
+            kernel_data[i] = 0;
+        }
+    }
+
+    nnet::kernel_shift_1d<data_T, CONFIG_T>(in_elem, kernel_data);
+
+    if (phase == 0) {
+        #pragma HLS INLINE region
+        if (CONFIG_T::strategy == nnet::latency) {
+            dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+        } else {
+            dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+        }
+
+        CastLoop: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_filt; i_ic++) {
+            #pragma HLS UNROLL
+            res_pack[i_ic] = res_out[i_ic];
+        }
+
+        res_stream.write(res_pack);
+    }
+
+    phase = (phase + 1 == CONFIG_T::stride_width) ? 0 : phase + 1;
+}
+
+// *************************************************
+//       Dilated Line Buffer Implementation
+// *************************************************
+// The taps of a dilated kernel are dilation pixels apart. Only the taps are kept in the kernel window, the
+// pixels in between are held in delay lines (ap_shift_reg), so the kernel window and the dense multiplication
+// have the size of the undilated kernel.
+template <class data_T, typename CONFIG_T>
+void kernel_shift_dilated_1d(
+    const data_T& in_elem,
+    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation> tap_buffer[MAX(CONFIG_T::filt_width - 1, 1)][CONFIG_T::n_chan],
+    typename data_T::value_type kernel_window[CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+    #pragma HLS inline
+
+    KernelShiftChannel: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+        #pragma HLS UNROLL
+        // The new pixel is the right-most tap, each delay line returns the tap one dilation to the left of its input
+        typename data_T::value_type tap = in_elem[i_ic];
+        kernel_window[(CONFIG_T::filt_width - 1) * CONFIG_T::n_chan + i_ic] = tap;
+        KernelShiftWidth: for (int i_iw = CONFIG_T::filt_width - 1; i_iw > 0; i_iw--) {
+            #pragma HLS UNROLL
+            tap = tap_buffer[i_iw - 1][i_ic].shift(tap);
+            kernel_window[(i_iw - 1) * CONFIG_T::n_chan + i_ic] = tap;
+        }
+    }
+}
+
+template <class data_T, typename CONFIG_T>
+void shift_line_buffer_dilated(const data_T& in_elem,
+                    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan],
+                    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_width> tap_buffer[MAX(CONFIG_T::filt_width - 1,1)][CONFIG_T::filt_height][CONFIG_T::n_chan],
+                    typename data_T::value_type kernel_window[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan]
+) {
+    #pragma HLS PIPELINE
+
+    // Temporary buffer for popped (shifted) elements
+    typename data_T::value_type shift_buffer[CONFIG_T::filt_height][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable = shift_buffer complete dim = 0
+
+    UpdateBuffer: for (int i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+        #pragma HLS UNROLL
+        shift_buffer[CONFIG_T::filt_height - 1][i_ic] = in_elem[i_ic];
+    }
+
+    // The rows of the kernel are dilation_height lines apart, so each line buffer holds dilation_height lines
+    LineBufferDataIn: for (int i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+        LineBufferShift: for (unsigned i_ih = 1; i_ih < CONFIG_T::filt_height; i_ih++) {
+            #pragma HLS UNROLL
+            shift_buffer[CONFIG_T::filt_height - i_ih - 1][i_ic] = line_buffer[i_ih - 1][i_ic].shift(shift_buffer[CONFIG_T::filt_height - i_ih][i_ic]);
+        }
+    }
+
+    // The columns of the kernel are dilation_width pixels apart
+    KernelShiftHeight: for (unsigned i_ih = 0; i_ih < CONFIG_T::filt_height; i_ih++) {
+        #pragma HLS UNROLL
+        KernelShiftChannel: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_chan; i_ic++) {
+            #pragma HLS UNROLL
+            typename data_T::value_type tap = shift_buffer[i_ih][i_ic];
+            kernel_window[(i_ih * CONFIG_T::filt_width + CONFIG_T::filt_width - 1) * CONFIG_T::n_chan + i_ic] = tap;
+            KernelShiftWidth: for (int i_iw = CONFIG_T::filt_width - 1; i_iw > 0; i_iw--) {
+                #pragma HLS UNROLL
+                tap = tap_buffer[i_iw - 1][i_ih][i_ic].shift(tap);
+                kernel_window[(i_ih * CONFIG_T::filt_width + i_iw - 1) * CONFIG_T::n_chan + i_ic] = tap;
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void compute_output_buffer_dilated_2d(
+    const data_T& in_elem,
+    ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_height * CONFIG_T::in_width> line_buffer[MAX(CONFIG_T::filt_height - 1,1)][CONFIG_T::n_chan],
+    hls::stream<res_T> &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::kernel_size * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_filt]
+) {
+    #pragma HLS INLINE
+
+    // Thresholds (span of the dilated kernel)
+    const static int lShiftX = CONFIG_T::dilation_width * (CONFIG_T::filt_width - 1);
+    const static int lShiftY = CONFIG_T::dilation_height * (CONFIG_T::filt_height - 1);
+
+    // Counters
+    static int pX = 0; // Pixel X
+    static int pY = 0; // Pixel Y
+
+    static int sX = 0; // Stride X
+    static int sY = 0; // Stride Y
+
+    static ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation_width> tap_buffer[MAX(CONFIG_T::filt_width - 1,1)][CONFIG_T::filt_height][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=tap_buffer complete dim = 0
+
+    static typename data_T::value_type kernel_data[CONFIG_T::filt_height * CONFIG_T::filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+
+    typename res_T::value_type res_out[CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
+
+    res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+
+    // Add pixel to buffer
+    nnet::shift_line_buffer_dilated<data_T, CONFIG_T>(in_elem, line_buffer, tap_buffer, kernel_data);
+
+    // Check to see if we have a full kernel
+    if ( (sX - lShiftX) == 0 && (sY - lShiftY) == 0 && pY > lShiftY - 1 && pX > lShiftX - 1) {
+
+        // Dense multiply
+        #pragma HLS INLINE region
+        if (CONFIG_T::strategy == nnet::latency) {
+            dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+        } else {
+            dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+        }
+
+        // Pack output
+        CastLoop: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_filt; i_ic++) {
+            #pragma HLS UNROLL
+            res_pack[i_ic] = res_out[i_ic];
+        }
+
+        // Write output to stream when output ready
+        res_stream.write(res_pack);
+    }
+
+    // Counter Housekeeping
+    if (pX + 1 == CONFIG_T::in_width)  // Includes padding, end of line (padded)
+    {
+        pX = 0;
+        sX = 0;
+        if (pY + 1 == CONFIG_T::in_height) {  // Reached bottom of image
+            pY = 0;
+            sY = 0;
+        } else {
+            pY = pY + 1;
+            // Update stride (threshold) ? subtract stride : increment stride
+            sY = ((sY - lShiftY) == 0) ? sY - CONFIG_T::stride_height + 1 : sY + 1;
+        }
+    } else {
+        pX = pX + 1;
+        // Update stride (threshold) ? subtract stride : increment stride
+        sX = ((sX - lShiftX) == 0) ? sX - CONFIG_T::stride_width + 1 : sX + 1;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void compute_output_buffer_dilated_1d(
+    const data_T& in_elem,
+    hls::stream<res_T> &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::kernel_size * CONFIG_T::n_chan * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_filt]
+) {
+    #pragma HLS INLINE
+
+    // Thresholds (span of the dilated kernel)
+    const static int lShiftX = CONFIG_T::dilation * (CONFIG_T::filt_width - 1);
+
+    // Counters
+    static int pX = 0; // pixel counter
+    static int sX = 0; // stride counter
+
+    static ap_shift_reg<typename data_T::value_type, CONFIG_T::dilation> tap_buffer[MAX(CONFIG_T::filt_width - 1, 1)][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=tap_buffer complete dim = 0
+
+    static typename data_T::value_type kernel_data[CONFIG_T::filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+
+    typename res_T::value_type res_out[CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=res_out complete dim = 0
+
+    res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+
+    // Add pixel to buffer
+    nnet::kernel_shift_dilated_1d<data_T, CONFIG_T>(in_elem, tap_buffer, kernel_data);
+
+    // Check to see if we have a full kernel
+    if ( (sX - lShiftX) == 0 && pX > lShiftX - 1 ) {
+
+        // Dense multiply
+        #pragma HLS INLINE region
+        if (CONFIG_T::strategy == nnet::latency) {
+            dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+        } else {
+            dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(kernel_data, res_out, weights, biases);
+        }
+
+        // Pack output
+        CastLoop: for (unsigned i_ic = 0; i_ic < CONFIG_T::n_filt; i_ic++) {
+            #pragma HLS UNROLL
+            res_pack[i_ic] = res_out[i_ic];
+        }
+
+        // Write output to stream when output ready
+        res_stream.write(res_pack);
+    }
+
+    // Counter Housekeeping
+    if (pX + 1 == CONFIG_T::in_width)  // Includes padding, end of line (padded)
+    {
+        pX = 0;
+        sX = 0;
+    } else {
+        pX = pX + 1;
+        // Update stride (threshold) ? subtract stride : increment stride
+        sX = ((sX - lShiftX) == 0) ? sX - CONFIG_T::stride_width + 1 : sX + 1;
+    }
+}
+
 }
 #endif
@@ -0,0 +1,179 @@
+#ifndef NNET_CONV_TRANSPOSE_H_
+#define NNET_CONV_TRANSPOSE_H_
+
+#include "nnet_common.h"
+#include "nnet_dense.h"
+
+namespace nnet {
+
+// Transposed convolution decomposed into stride_height * stride_width phases ("sub-pixel" convolution).
+// Output pixel p of the uncropped output only receives the kernel taps t with t % stride == p % stride, so
+// each phase is a dense sub-kernel of sub_filt = ceil(filt / stride) taps, applied with stride 1 to the input.
+// A window of sub_filt_height * sub_filt_width input pixels (block q) computes the stride_height * stride_width
+// output pixels q * stride + phase at once, without multiplying the zeros that would be inserted between the inputs.
+// The weights are stored per window position as [sub_filt_height][sub_filt_width][n_chan][phase][n_filt],
+// the outputs are cropped by crop_top/crop_left (padding='same').
+
+struct conv1d_transpose_config
+{
+    // Internal data type definitions
+    typedef float bias_t;
+    typedef float weight_t;
+    typedef float accum_t;
+
+    // Convolutional parameters
+    static const unsigned in_width = 10;
+    static const unsigned n_chan = 1;
+    static const unsigned filt_width = 3;
+    static const unsigned n_filt = 1;
+    static const unsigned stride_width = 2;
+    static const unsigned out_width = 20;
+    static const unsigned sub_filt_width = DIV_ROUNDUP(filt_width, stride_width);
+    static const unsigned crop_left = 0;
+
+    static const unsigned reuse_factor = 1;
+    static const unsigned strategy = latency;
+    static const bool store_weights_in_bram = false;
+    static const unsigned n_zeros = 0;
+};
+
+struct conv2d_transpose_config
+{
+    // Internal data type definitions
+    typedef float bias_t;
+    typedef float weight_t;
+    typedef float accum_t;
+
+    // Convolutional parameters
+    static const unsigned in_height = 10;
+    static const unsigned in_width = 10;
+    static const unsigned n_chan = 1;
+    static const unsigned filt_height = 3;
+    static const unsigned filt_width = 3;
+    static const unsigned n_filt = 1;
+    static const unsigned stride_height = 2;
+    static const unsigned stride_width = 2;
+    static const unsigned out_height = 20;
+    static const unsigned out_width = 20;
+    static const unsigned sub_filt_height = DIV_ROUNDUP(filt_height, stride_height);
+    static const unsigned sub_filt_width = DIV_ROUNDUP(filt_width, stride_width);
+    static const unsigned crop_top = 0;
+    static const unsigned crop_left = 0;
+
+    static const unsigned reuse_factor = 1;
+    static const unsigned strategy = latency;
+    static const bool store_weights_in_bram = false;
+    static const unsigned n_zeros = 0;
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_transpose_mult(
+    data_T window[CONFIG_T::mult_config::n_in],
+    res_T  phases[CONFIG_T::mult_config::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::mult_config::n_in * CONFIG_T::mult_config::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::mult_config::n_out])
+{
+    #pragma HLS INLINE region
+    if (CONFIG_T::strategy == nnet::latency) {
+        dense_latency<data_T, res_T, typename CONFIG_T::mult_config>(window, phases, weights, biases);
+    } else {
+        dense_resource<data_T, res_T, typename CONFIG_T::mult_config>(window, phases, weights, biases);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_transpose_cl(
+    data_T data[CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_width * CONFIG_T::n_filt],
+    typename CONFIG_T::weight_t weights[CONFIG_T::sub_filt_width * CONFIG_T::n_chan * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::stride_width * CONFIG_T::n_filt])
+{
+    // Only the blocks that produce at least one of the (cropped) outputs are computed
+    const unsigned first_block = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    const unsigned last_block = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    data_T window[CONFIG_T::sub_filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=window complete
+    res_T phases[CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phases complete
+
+    BlockWidth: for (unsigned bw = first_block; bw <= last_block; bw++) {
+        if (CONFIG_T::strategy == nnet::latency) {
+            #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+        }
+
+        WindowWidth: for (unsigned mw = 0; mw < CONFIG_T::sub_filt_width; mw++) {
+            // Input pixel that is multiplied with tap (sub_filt_width - 1 - mw) of each phase
+            const int iw = int(bw + mw) - int(CONFIG_T::sub_filt_width - 1);
+            WindowChan: for (unsigned cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                window[mw * CONFIG_T::n_chan + cc] = (iw >= 0 && iw < int(CONFIG_T::in_width)) ? data[iw * CONFIG_T::n_chan + cc] : data_T(0);
+            }
+        }
+
+        conv_transpose_mult<data_T, res_T, CONFIG_T>(window, phases, weights, biases);
+
+        PhaseWidth: for (unsigned pw = 0; pw < CONFIG_T::stride_width; pw++) {
+            const int ow = int(bw * CONFIG_T::stride_width + pw) - int(CONFIG_T::crop_left);
+            if (ow < 0 || ow >= int(CONFIG_T::out_width)) continue;
+            PhaseFilt: for (unsigned ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                res[ow * CONFIG_T::n_filt + ff] = phases[pw * CONFIG_T::n_filt + ff];
+            }
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_transpose_cl(
+    data_T data[CONFIG_T::in_height * CONFIG_T::in_width * CONFIG_T::n_chan],
+    res_T  res[CONFIG_T::out_height * CONFIG_T::out_width * CONFIG_T::n_filt],
+    typename CONFIG_T::weight_t weights[CONFIG_T::sub_filt_height * CONFIG_T::sub_filt_width * CONFIG_T::n_chan * CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt])
+{
+    // Only the blocks that produce at least one of the (cropped) outputs are computed
+    const unsigned first_block_h = CONFIG_T::crop_top / CONFIG_T::stride_height;
+    const unsigned last_block_h = (CONFIG_T::crop_top + CONFIG_T::out_height - 1) / CONFIG_T::stride_height;
+    const unsigned first_block_w = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    const unsigned last_block_w = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    data_T window[CONFIG_T::sub_filt_height * CONFIG_T::sub_filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=window complete
+    res_T phases[CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phases complete
+
+    BlockHeight: for (unsigned bh = first_block_h; bh <= last_block_h; bh++) {
+        BlockWidth: for (unsigned bw = first_block_w; bw <= last_block_w; bw++) {
+            #pragma HLS LOOP_FLATTEN
+            if (CONFIG_T::strategy == nnet::latency) {
+                #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+            }
+
+            WindowHeight: for (unsigned mh = 0; mh < CONFIG_T::sub_filt_height; mh++) {
+                const int ih = int(bh + mh) - int(CONFIG_T::sub_filt_height - 1);
+                WindowWidth: for (unsigned mw = 0; mw < CONFIG_T::sub_filt_width; mw++) {
+                    const int iw = int(bw + mw) - int(CONFIG_T::sub_filt_width - 1);
+                    const bool inside = ih >= 0 && ih < int(CONFIG_T::in_height) && iw >= 0 && iw < int(CONFIG_T::in_width);
+                    WindowChan: for (unsigned cc = 0; cc < CONFIG_T::n_chan; cc++) {
+                        window[(mh * CONFIG_T::sub_filt_width + mw) * CONFIG_T::n_chan + cc] = inside ? data[(ih * CONFIG_T::in_width + iw) * CONFIG_T::n_chan + cc] : data_T(0);
+                    }
+                }
+            }
+
+            conv_transpose_mult<data_T, res_T, CONFIG_T>(window, phases, weights, biases);
+
+            PhaseHeight: for (unsigned ph = 0; ph < CONFIG_T::stride_height; ph++) {
+                const int oh = int(bh * CONFIG_T::stride_height + ph) - int(CONFIG_T::crop_top);
+                PhaseWidth: for (unsigned pw = 0; pw < CONFIG_T::stride_width; pw++) {
+                    const int ow = int(bw * CONFIG_T::stride_width + pw) - int(CONFIG_T::crop_left);
+                    if (oh < 0 || oh >= int(CONFIG_T::out_height) || ow < 0 || ow >= int(CONFIG_T::out_width)) continue;
+                    PhaseFilt: for (unsigned ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                        res[(oh * CONFIG_T::out_width + ow) * CONFIG_T::n_filt + ff] = phases[(ph * CONFIG_T::stride_width + pw) * CONFIG_T::n_filt + ff];
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
+
+#endif
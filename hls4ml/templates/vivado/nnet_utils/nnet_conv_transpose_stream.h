@@ -0,0 +1,175 @@
+#ifndef NNET_CONV_TRANSPOSE_STREAM_H_
+#define NNET_CONV_TRANSPOSE_STREAM_H_
+
+#include "ap_shift_reg.h"
+#include "nnet_common.h"
+#include "nnet_conv_stream.h"
+#include "nnet_conv_transpose.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// Window of the line buffer: the sub-kernel of each phase slides with stride 1 over the input,
+// padded with sub_filt - 1 zeros on each side (the padding is not read from the stream)
+template<typename CONFIG_T>
+struct conv_transpose_window_config {
+    static const unsigned filt_height = CONFIG_T::sub_filt_height;
+    static const unsigned filt_width = CONFIG_T::sub_filt_width;
+    static const unsigned n_chan = CONFIG_T::n_chan;
+    static const unsigned pad_height = CONFIG_T::sub_filt_height - 1;
+    static const unsigned pad_width = CONFIG_T::sub_filt_width - 1;
+    static const unsigned in_height = CONFIG_T::in_height + 2 * pad_height;
+    static const unsigned in_width = CONFIG_T::in_width + 2 * pad_width;
+};
+
+template<typename CONFIG_T>
+struct conv1d_transpose_window_config {
+    static const unsigned filt_width = CONFIG_T::sub_filt_width;
+    static const unsigned n_chan = CONFIG_T::n_chan;
+    static const unsigned pad_width = CONFIG_T::sub_filt_width - 1;
+    static const unsigned in_width = CONFIG_T::in_width + 2 * pad_width;
+};
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_1d_transpose_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::sub_filt_width * CONFIG_T::n_chan * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::stride_width * CONFIG_T::n_filt])
+{
+    typedef conv1d_transpose_window_config<CONFIG_T> window_T;
+
+    const unsigned first_block = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    const unsigned last_block = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    typename data_T::value_type kernel_data[CONFIG_T::sub_filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+
+    typename res_T::value_type phases[CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phases complete
+
+    data_T zero_pixel;
+    ZeroPixel: for (unsigned cc = 0; cc < CONFIG_T::n_chan; cc++) {
+        #pragma HLS UNROLL
+        zero_pixel[cc] = 0;
+    }
+
+    ReadInputWidth: for (unsigned i_pw = 0; i_pw < window_T::in_width; i_pw++) {
+        if (CONFIG_T::strategy == nnet::latency) {
+            #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+        }
+
+        const bool inside = i_pw >= window_T::pad_width && i_pw < window_T::pad_width + CONFIG_T::in_width;
+        kernel_shift_1d<data_T, window_T>(inside ? data.read() : zero_pixel, kernel_data);
+
+        if (i_pw < window_T::pad_width) continue;
+        const unsigned bw = i_pw - window_T::pad_width;
+        if (bw < first_block || bw > last_block) continue;
+
+        conv_transpose_mult<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(kernel_data, phases, weights, biases);
+
+        // The phases of a block are consecutive output pixels
+        PhaseWidth: for (unsigned pw = 0; pw < CONFIG_T::stride_width; pw++) {
+            const int ow = int(bw * CONFIG_T::stride_width + pw) - int(CONFIG_T::crop_left);
+            if (ow < 0 || ow >= int(CONFIG_T::out_width)) continue;
+
+            res_T res_pack;
+            #pragma HLS DATA_PACK variable=res_pack
+            PhaseFilt: for (unsigned ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                #pragma HLS UNROLL
+                res_pack[ff] = phases[pw * CONFIG_T::n_filt + ff];
+            }
+            res.write(res_pack);
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void conv_2d_transpose_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T>  &res,
+    typename CONFIG_T::weight_t weights[CONFIG_T::sub_filt_height * CONFIG_T::sub_filt_width * CONFIG_T::n_chan * CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt])
+{
+    typedef conv_transpose_window_config<CONFIG_T> window_T;
+
+    const unsigned first_block_h = CONFIG_T::crop_top / CONFIG_T::stride_height;
+    const unsigned last_block_h = (CONFIG_T::crop_top + CONFIG_T::out_height - 1) / CONFIG_T::stride_height;
+    const unsigned first_block_w = CONFIG_T::crop_left / CONFIG_T::stride_width;
+    const unsigned last_block_w = (CONFIG_T::crop_left + CONFIG_T::out_width - 1) / CONFIG_T::stride_width;
+
+    ap_shift_reg<typename data_T::value_type, window_T::in_width> line_buffer[MAX(CONFIG_T::sub_filt_height - 1, 1)][CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=line_buffer complete dim=2
+
+    typename data_T::value_type kernel_data[CONFIG_T::sub_filt_height * CONFIG_T::sub_filt_width * CONFIG_T::n_chan];
+    #pragma HLS ARRAY_PARTITION variable=kernel_data complete
+
+    typename res_T::value_type phases[CONFIG_T::stride_height * CONFIG_T::stride_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=phases complete
+
+    // A row of blocks produces stride_height rows of the output, written once the row of blocks is complete
+    typename res_T::value_type out_rows[CONFIG_T::stride_height][CONFIG_T::out_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable=out_rows complete dim=1
+
+    data_T zero_pixel;
+    ZeroPixel: for (unsigned cc = 0; cc < CONFIG_T::n_chan; cc++) {
+        #pragma HLS UNROLL
+        zero_pixel[cc] = 0;
+    }
+
+    ReadInputHeight: for (unsigned i_ph = 0; i_ph < window_T::in_height; i_ph++) {
+        const bool inside_h = i_ph >= window_T::pad_height && i_ph < window_T::pad_height + CONFIG_T::in_height;
+        const bool full_h = i_ph >= window_T::pad_height;
+        const unsigned bh = i_ph - window_T::pad_height;
+        const bool block_row = full_h && bh >= first_block_h && bh <= last_block_h;
+
+        ReadInputWidth: for (unsigned i_pw = 0; i_pw < window_T::in_width; i_pw++) {
+            if (CONFIG_T::strategy == nnet::latency) {
+                #pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+            }
+
+            const bool inside = inside_h && i_pw >= window_T::pad_width && i_pw < window_T::pad_width + CONFIG_T::in_width;
+            shift_line_buffer<data_T, window_T>(inside ? data.read() : zero_pixel, line_buffer, kernel_data);
+
+            if (!block_row || i_pw < window_T::pad_width) continue;
+            const unsigned bw = i_pw - window_T::pad_width;
+            if (bw < first_block_w || bw > last_block_w) continue;
+
+            conv_transpose_mult<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(kernel_data, phases, weights, biases);
+
+            PhaseHeight: for (unsigned ph = 0; ph < CONFIG_T::stride_height; ph++) {
+                #pragma HLS UNROLL
+                PhaseWidth: for (unsigned pw = 0; pw < CONFIG_T::stride_width; pw++) {
+                    #pragma HLS UNROLL
+                    const int ow = int(bw * CONFIG_T::stride_width + pw) - int(CONFIG_T::crop_left);
+                    if (ow < 0 || ow >= int(CONFIG_T::out_width)) continue;
+                    PhaseFilt: for (unsigned ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                        #pragma HLS UNROLL
+                        out_rows[ph][ow * CONFIG_T::n_filt + ff] = phases[(ph * CONFIG_T::stride_width + pw) * CONFIG_T::n_filt + ff];
+                    }
+                }
+            }
+        }
+
+        if (!block_row) continue;
+
+        WriteOutputPhase: for (unsigned ph = 0; ph < CONFIG_T::stride_height; ph++) {
+            const int oh = int(bh * CONFIG_T::stride_height + ph) - int(CONFIG_T::crop_top);
+            if (oh < 0 || oh >= int(CONFIG_T::out_height)) continue;
+            WriteOutputWidth: for (unsigned ow = 0; ow < CONFIG_T::out_width; ow++) {
+                #pragma HLS PIPELINE
+                res_T res_pack;
+                #pragma HLS DATA_PACK variable=res_pack
+                WriteOutputFilt: for (unsigned ff = 0; ff < CONFIG_T::n_filt; ff++) {
+                    #pragma HLS UNROLL
+                    res_pack[ff] = out_rows[ph][ow * CONFIG_T::n_filt + ff];
+                }
+                res.write(res_pack);
+            }
+        }
+    }
+}
+
+}
+
+#endif
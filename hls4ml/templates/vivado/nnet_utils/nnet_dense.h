@@ -3,6 +3,7 @@
 
 #include "nnet_common.h"
 #include "nnet_mult.h"
+#include "nnet_code_gen.h"
 #include "nnet_dense_latency.h"
 #include "nnet_dense_resource.h"
 #include "nnet_dense_seq.h"
@@ -22,6 +23,7 @@ struct dense_config
     // Layer Sizes
     static const unsigned n_in = 10;
     static const unsigned n_out = 10;
+    static const unsigned seq_len = 1;
 
     // Resource reuse info
     static const unsigned io_type = io_parallel;
@@ -29,10 +31,19 @@ struct dense_config
     static const unsigned reuse_factor = 1;
     static const bool store_weights_in_bram = false;
     static const unsigned n_zeros = 0;
+    // Per-channel requantization of the output (integer-only mode)
+    static const bool requant = false;
+    // Only multiply the nonzero inputs (resource strategy, io_stream), see nnet_dense_skip_zeros.h
+    static const bool skip_zeros = false;
+    static const unsigned skip_zeros_lanes = 1;
     // partitioning arrays cyclically to go with roll factors?
     // Product function to use
     template<class x_T, class y_T>
     using product = nnet::product::mult<x_T, y_T>;
+    // Generated shift-add products with the constant weights (latency strategy)
+    static const bool shift_add = false;
+    template<class data_T, class res_T, class CONFIG_T>
+    using dense_shift_add = nnet::DenseShiftAdd<data_T, res_T, CONFIG_T>;
 };
 
 template<class data_T, class res_T, typename CONFIG_T>
@@ -100,7 +100,7 @@ void dense_compressed(
     for(unsigned i = 0; i < CONFIG_T::n_out; i++){
         #pragma HLS UNROLL
         //res[i] = (res_T) (acc[i]);
-        res[i] = cast<data_T, res_T, CONFIG_T>(acc[i]);
+        res[i] = cast<data_T, res_T, CONFIG_T>(acc[i], i);
     }
 }
 
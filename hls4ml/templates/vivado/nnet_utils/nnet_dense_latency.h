@@ -35,6 +35,12 @@ void dense_latency(
     typename CONFIG_T::weight_t  weights[CONFIG_T::n_in*CONFIG_T::n_out],
     typename CONFIG_T::bias_t    biases[CONFIG_T::n_out])
 {
+    if (CONFIG_T::shift_add) {
+        // Products with the constant weights are generated as shift-adds in nnet_code_gen.h
+        CONFIG_T::template dense_shift_add<data_T, res_T, CONFIG_T>::dense(data, res, biases);
+        return;
+    }
+
     data_T cache;
     typename CONFIG_T::accum_t mult[CONFIG_T::n_in*CONFIG_T::n_out];
     typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
@@ -58,10 +64,7 @@ void dense_latency(
     // Do the matrix-multiply
     Product1: for(int ii = 0; ii < CONFIG_T::n_in; ii++) {
         cache = data[ii];
-        Product2: for(int jj = 0; jj < CONFIG_T::n_out; jj++) {
-            int index = ii*CONFIG_T::n_out+jj;
-            mult[index] = CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(cache, weights[index]);
-        }
+        product_row<typename CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>, CONFIG_T::n_out>(cache, &weights[ii*CONFIG_T::n_out], &mult[ii*CONFIG_T::n_out]);
     }
 
     // Initialize accumulator with input biases
@@ -80,7 +83,7 @@ void dense_latency(
     // Cast to "res_t" type
     Result: for(int ires = 0; ires < CONFIG_T::n_out; ires++) {
         //res[ires] = (res_T) (acc[ires]);
-        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires]);
+        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires], ires);
     }
 }
 
@@ -97,7 +97,7 @@ void dense_resource_rf_leq_nin(
     Result:
     for (int ires = 0; ires < CONFIG_T::n_out; ires++) {
         #pragma HLS UNROLL
-        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires]);
+        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires], ires);
     }
 }
 
@@ -177,7 +177,7 @@ void dense_resource_rf_gt_nin_rem0(
     Result:
     for (int ires = 0; ires < CONFIG_T::n_out; ires++) {
         #pragma HLS UNROLL
-        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires]);
+        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires], ires);
     }
 }
 
@@ -259,12 +259,75 @@ void dense_resource_rf_gt_nin(
     Result:
     for (int ires = 0; ires < CONFIG_T::n_out; ires++) {
         #pragma HLS UNROLL
-        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires]);
+        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires], ires);
     }
 }
 
+// Codebook weights: the inputs of a reuse step are ir, ir + RF, ... (N_IN % RF == 0) or the single input ir % N_IN
+// (RF % N_IN == 0). The products of each of these inputs with the codebook values are computed once per step and the
+// weights of the step select from them, instead of one product per weight.
 template<class data_T, class res_T, typename CONFIG_T>
-void dense_resource(
+void dense_resource_codebook(
+    data_T data[CONFIG_T::n_in],
+    res_T  res[CONFIG_T::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_out]) {
+
+    typedef typename CONFIG_T::template product<data_T, typename CONFIG_T::weight_t> product_t;
+
+    const int rufactor = CONFIG_T::reuse_factor;
+    const int block_factor = DIV_ROUNDUP(CONFIG_T::n_in*CONFIG_T::n_out, CONFIG_T::reuse_factor);
+    const int nin = CONFIG_T::n_in;
+    const int nout = CONFIG_T::n_out;
+    const int nin_step = MAX(nin / rufactor, 1);
+
+    assert((nin % rufactor == 0 || rufactor % nin == 0) && "This function is correct only for N_IN % RF == 0 or RF % N_IN == 0");
+
+    #pragma HLS function_instantiate variable=weights,biases
+    #pragma HLS ARRAY_RESHAPE   variable=weights block factor=block_factor
+    #pragma HLS ARRAY_PARTITION variable=biases complete
+
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
+    #pragma HLS ARRAY_PARTITION variable=acc complete
+
+    InitAccum:
+    for (int iacc = 0; iacc < nout; iacc++) {
+        #pragma HLS UNROLL
+        acc[iacc] = (typename CONFIG_T::accum_t) biases[iacc];
+    }
+
+    ReuseLoop:
+    for (int ir = 0; ir < rufactor; ir++) {
+        #pragma HLS PIPELINE II=1 rewind
+        typename product_t::r_T bank[nin_step][product_t::n_entries];
+        #pragma HLS ARRAY_PARTITION variable=bank complete dim=0
+
+        BankLoop:
+        for (int is = 0; is < nin_step; is++) {
+            #pragma HLS UNROLL
+            product_t::bank(data[rufactor <= nin ? ir + rufactor * is : ir % nin], bank[is]);
+        }
+
+        MultLoop:
+        for (int im = 0; im < block_factor; im++) {
+            #pragma HLS UNROLL
+            int w_index = ir + rufactor * im;
+            if (w_index >= CONFIG_T::n_in*CONFIG_T::n_out) continue; // check out of bounds
+            int out_index = rufactor <= nin ? im / nin_step : ir / nin + im * (rufactor / nin);
+            acc[out_index] += static_cast<typename CONFIG_T::accum_t>(product_t::select(bank[im % nin_step], weights[w_index]));
+        }
+    }
+
+    // Cast to "res_t" type
+    Result:
+    for (int ires = 0; ires < CONFIG_T::n_out; ires++) {
+        #pragma HLS UNROLL
+        res[ires] = cast<data_T, res_T, CONFIG_T>(acc[ires], ires);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_resource_per_weight(
     data_T data[CONFIG_T::n_in],
     res_T  res[CONFIG_T::n_out],
     typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
@@ -281,6 +344,37 @@ void dense_resource(
     }
 }
 
+template<class data_T, class res_T, typename CONFIG_T>
+inline typename std::enable_if<! is_codebook_product<typename CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>>::value>::type
+dense_resource(
+    data_T data[CONFIG_T::n_in],
+    res_T  res[CONFIG_T::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_out]) {
+
+    #pragma HLS INLINE region
+
+    dense_resource_per_weight<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline typename std::enable_if<is_codebook_product<typename CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>>::value>::type
+dense_resource(
+    data_T data[CONFIG_T::n_in],
+    res_T  res[CONFIG_T::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_out]) {
+
+    #pragma HLS INLINE region
+
+    // Other reuse factors mix the inputs within a reuse step, these multiply per weight
+    if (CONFIG_T::n_in % CONFIG_T::reuse_factor == 0 || CONFIG_T::reuse_factor % CONFIG_T::n_in == 0) {
+        dense_resource_codebook<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+    } else {
+        dense_resource_per_weight<data_T, res_T, CONFIG_T>(data, res, weights, biases);
+    }
+}
+
 }
 
 #endif
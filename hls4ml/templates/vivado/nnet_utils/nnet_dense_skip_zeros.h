@@ -0,0 +1,143 @@
+#ifndef NNET_DENSE_SKIP_ZEROS_H_
+#define NNET_DENSE_SKIP_ZEROS_H_
+
+#include "nnet_common.h"
+#include "nnet_mult.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+// Dense product that skips the zero inputs (e.g., the outputs of a ReLU). The inputs are split into n_lanes =
+// CONFIG_T::skip_zeros_lanes lanes, lane k holding the inputs i_in = j * n_lanes + k. The nonzero inputs of each lane
+// are compacted into a list of values and indices j as they arrive, and each iteration of the multiplication loop
+// multiplies the next nonzero input of every lane with all of its weights, i.e., it uses as many multipliers as
+// dense_resource, but the loop runs max(n_nonzero of a lane) times instead of n_in / n_lanes times.
+// The weights are reordered (see ApplyResourceStrategy) to weights[(i_out * n_lanes + k) * (n_in / n_lanes) + j], so
+// that each lane and output reads its own bank, and the lists of a lane are written at most once per input beat
+// (if data_T::size <= n_lanes), so both loops can be pipelined with II=1.
+
+template<class data_T, typename CONFIG_T>
+void skip_zeros_compact(
+    const data_T value,
+    const unsigned index,
+    data_T nz_data[CONFIG_T::skip_zeros_lanes][CONFIG_T::n_in / CONFIG_T::skip_zeros_lanes],
+    unsigned nz_index[CONFIG_T::skip_zeros_lanes][CONFIG_T::n_in / CONFIG_T::skip_zeros_lanes],
+    unsigned n_nonzero[CONFIG_T::skip_zeros_lanes]
+) {
+    #pragma HLS INLINE
+    const unsigned lane = index % CONFIG_T::skip_zeros_lanes;
+    if (value != 0) {
+        nz_data[lane][n_nonzero[lane]] = value;
+        nz_index[lane][n_nonzero[lane]] = index / CONFIG_T::skip_zeros_lanes;
+        n_nonzero[lane]++;
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_skip_zeros_mult(
+    data_T nz_data[CONFIG_T::skip_zeros_lanes][CONFIG_T::n_in / CONFIG_T::skip_zeros_lanes],
+    unsigned nz_index[CONFIG_T::skip_zeros_lanes][CONFIG_T::n_in / CONFIG_T::skip_zeros_lanes],
+    unsigned n_nonzero[CONFIG_T::skip_zeros_lanes],
+    res_T res[CONFIG_T::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in * CONFIG_T::n_out],
+    typename CONFIG_T::bias_t biases[CONFIG_T::n_out]
+) {
+    const unsigned n_lanes = CONFIG_T::skip_zeros_lanes;
+    const unsigned max_iter = CONFIG_T::n_in / n_lanes;
+
+    #pragma HLS function_instantiate variable=weights,biases
+    #pragma HLS ARRAY_PARTITION variable=weights block factor=CONFIG_T::n_out*CONFIG_T::skip_zeros_lanes
+    #pragma HLS ARRAY_PARTITION variable=biases complete
+    #pragma HLS ARRAY_PARTITION variable=n_nonzero complete
+
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
+    #pragma HLS ARRAY_PARTITION variable=acc complete
+
+    InitAccum: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+        #pragma HLS UNROLL
+        acc[i_out] = (typename CONFIG_T::accum_t) biases[i_out];
+    }
+
+    unsigned n_iter = 0;
+    MaxNonzero: for (unsigned i_lane = 0; i_lane < n_lanes; i_lane++) {
+        #pragma HLS UNROLL
+        if (n_nonzero[i_lane] > n_iter) n_iter = n_nonzero[i_lane];
+    }
+
+    SparseLoop: for (unsigned i_iter = 0; i_iter < n_iter; i_iter++) {
+        #pragma HLS LOOP_TRIPCOUNT min=0 max=max_iter
+        #pragma HLS PIPELINE II=1
+        SparseLane: for (unsigned i_lane = 0; i_lane < n_lanes; i_lane++) {
+            #pragma HLS UNROLL
+            if (i_iter >= n_nonzero[i_lane]) continue;
+            const unsigned j = nz_index[i_lane][i_iter];
+            SparseOut: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+                #pragma HLS UNROLL
+                acc[i_out] += static_cast<typename CONFIG_T::accum_t>(
+                    CONFIG_T::template product<data_T, typename CONFIG_T::weight_t>::product(nz_data[i_lane][i_iter], weights[(i_out * n_lanes + i_lane) * max_iter + j]));
+            }
+        }
+    }
+
+#if !defined(__SYNTHESIS__) && defined(HLS_STREAM_TIMING_MODEL)
+    // The latency of the layer depends on the number of nonzero inputs
+    hls::timing::busy(n_iter);
+#endif
+
+    Result: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+        #pragma HLS UNROLL
+        res[i_out] = cast<data_T, res_T, CONFIG_T>(acc[i_out], i_out);
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_skip_zeros(
+    hls::stream<data_T> &data_stream,
+    hls::stream<res_T>  &res_stream,
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in * CONFIG_T::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_out])
+{
+    typename data_T::value_type nz_data[CONFIG_T::skip_zeros_lanes][CONFIG_T::n_in / CONFIG_T::skip_zeros_lanes];
+    unsigned nz_index[CONFIG_T::skip_zeros_lanes][CONFIG_T::n_in / CONFIG_T::skip_zeros_lanes];
+    unsigned n_nonzero[CONFIG_T::skip_zeros_lanes];
+    #pragma HLS ARRAY_PARTITION variable=nz_data complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=nz_index complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=n_nonzero complete
+
+    InitLanes: for (unsigned i_lane = 0; i_lane < CONFIG_T::skip_zeros_lanes; i_lane++) {
+        #pragma HLS UNROLL
+        n_nonzero[i_lane] = 0;
+    }
+
+    typename res_T::value_type res[CONFIG_T::n_out];
+    #pragma HLS ARRAY_PARTITION variable=res complete
+
+    // The nonzero inputs are compacted as they are read
+    DataPrepare: for (unsigned i_in = 0; i_in < CONFIG_T::n_in / data_T::size; i_in++) {
+        #pragma HLS PIPELINE
+        data_T data_pack = data_stream.read();
+        DataPack: for (unsigned i_pack = 0; i_pack < data_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            skip_zeros_compact<typename data_T::value_type, CONFIG_T>(data_pack[i_pack], i_in * data_T::size + i_pack, nz_data, nz_index, n_nonzero);
+        }
+    }
+
+    dense_skip_zeros_mult<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(nz_data, nz_index, n_nonzero, res, weights, biases);
+
+    ResWrite: for (unsigned i_out = 0; i_out < CONFIG_T::n_out / res_T::size; i_out++) {
+        if (CONFIG_T::n_out / res_T::size > 1) {
+            #pragma HLS PIPELINE
+        }
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack: for (unsigned i_pack = 0; i_pack < res_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            res_pack[i_pack] = res[i_out * res_T::size + i_pack];
+        }
+        res_stream.write(res_pack);
+    }
+}
+
+}
+
+#endif
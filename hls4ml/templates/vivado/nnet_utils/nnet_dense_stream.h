@@ -3,6 +3,7 @@
 
 #include "nnet_common.h"
 #include "nnet_types.h"
+#include "nnet_dense_skip_zeros.h"
 #include "hls_stream.h"
 #include <math.h>
 #include <assert.h>
@@ -25,6 +26,67 @@ void dense_wrapper(
     }
 }
 
+// Multiplies each beat of the input with its slice of the weights as it arrives, so that the product of the layer
+// overlaps the transfer of its input (e.g., the pixels of a flattened image). The multiplications of a beat are spread
+// over beat_ii = ceil(reuse_factor / n_beats) cycles, which uses at most as many multipliers as the non-incremental product.
+// The weights are stored as [n_in][n_out] (latency strategy) or [n_out][n_in] (resource strategy).
+template<class data_T, class res_T, typename CONFIG_T>
+void dense_incremental(
+    hls::stream<data_T> &data_stream,
+    typename res_T::value_type res[CONFIG_T::n_out],
+    typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
+    typename CONFIG_T::bias_t   biases[CONFIG_T::n_out])
+{
+    const unsigned n_beats = CONFIG_T::n_in / data_T::size;
+    const unsigned beat_ii = DIV_ROUNDUP(CONFIG_T::reuse_factor, n_beats);
+    // The weights of a beat are one word of the reshaped array (latency), or one word of each of the n_out blocks (resource)
+    const unsigned w_cyclic = (CONFIG_T::strategy == nnet::latency) ? data_T::size * CONFIG_T::n_out : data_T::size;
+    const unsigned w_block = (CONFIG_T::strategy == nnet::latency) ? 1 : CONFIG_T::n_out;
+
+    #pragma HLS function_instantiate variable=weights,biases
+    #pragma HLS ARRAY_RESHAPE variable=weights cyclic factor=w_cyclic
+    #pragma HLS ARRAY_PARTITION variable=weights block factor=w_block
+    #pragma HLS ARRAY_PARTITION variable=biases complete
+
+    typename CONFIG_T::accum_t acc[CONFIG_T::n_out];
+    #pragma HLS ARRAY_PARTITION variable=acc complete
+
+    InitAccum: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+        #pragma HLS UNROLL
+        acc[i_out] = (typename CONFIG_T::accum_t) biases[i_out];
+    }
+
+    typedef typename CONFIG_T::template product<typename data_T::value_type, typename CONFIG_T::weight_t> product_t;
+
+    BeatLoop: for (unsigned i_beat = 0; i_beat < n_beats; i_beat++) {
+        #pragma HLS PIPELINE II=beat_ii
+        data_T data_pack = data_stream.read();
+        BeatPack: for (unsigned i_pack = 0; i_pack < data_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            const unsigned i_in = i_beat * data_T::size + i_pack;
+            // The products of an input with its row of weights, which share the codebook products (see product_row)
+            typename CONFIG_T::weight_t w_row[CONFIG_T::n_out];
+            typename CONFIG_T::accum_t p_row[CONFIG_T::n_out];
+            #pragma HLS ARRAY_PARTITION variable=w_row complete
+            #pragma HLS ARRAY_PARTITION variable=p_row complete
+            BeatRow: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+                #pragma HLS UNROLL
+                w_row[i_out] = weights[(CONFIG_T::strategy == nnet::latency) ? i_in * CONFIG_T::n_out + i_out : i_out * CONFIG_T::n_in + i_in];
+            }
+            product_row<product_t, CONFIG_T::n_out>(data_pack[i_pack], w_row, p_row);
+            BeatOut: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+                #pragma HLS UNROLL
+                acc[i_out] += p_row[i_out];
+            }
+        }
+    }
+
+    Result: for (unsigned i_out = 0; i_out < CONFIG_T::n_out; i_out++) {
+        #pragma HLS UNROLL
+        res[i_out] = cast<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(acc[i_out], i_out);
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void dense(
     hls::stream<data_T> &data_stream,
@@ -32,24 +94,34 @@ void dense(
     typename CONFIG_T::weight_t weights[CONFIG_T::n_in*CONFIG_T::n_out],
     typename CONFIG_T::bias_t   biases[CONFIG_T::n_out])
 {
+    if (CONFIG_T::skip_zeros) {
+        dense_skip_zeros<data_T, res_T, CONFIG_T>(data_stream, res_stream, weights, biases);
+        return;
+    }
+
     typename data_T::value_type data[CONFIG_T::n_in];
     #pragma HLS ARRAY_PARTITION variable=data complete
 
     typename res_T::value_type res[CONFIG_T::n_out];
     #pragma HLS ARRAY_PARTITION variable=res complete
 
-    DataPrepare: for(int i_in = 0; i_in < CONFIG_T::n_in / data_T::size; i_in++) {
-        if (CONFIG_T::n_in / data_T::size > 1) {
-            #pragma HLS PIPELINE
-        }
-        data_T data_pack = data_stream.read();
-        DataPack: for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
-            #pragma HLS UNROLL
-            data[i_in * data_T::size + i_pack] = data_pack[i_pack];
+    if (CONFIG_T::n_in / data_T::size > 1 && !CONFIG_T::shift_add) {
+        // The input arrives in several beats, accumulate the product as they are read
+        dense_incremental<data_T, res_T, CONFIG_T>(data_stream, res, weights, biases);
+    } else {
+        DataPrepare: for(int i_in = 0; i_in < CONFIG_T::n_in / data_T::size; i_in++) {
+            if (CONFIG_T::n_in / data_T::size > 1) {
+                #pragma HLS PIPELINE
+            }
+            data_T data_pack = data_stream.read();
+            DataPack: for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
+                #pragma HLS UNROLL
+                data[i_in * data_T::size + i_pack] = data_pack[i_pack];
+            }
         }
-    }
 
-    dense_wrapper<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, weights, biases);
+        dense_wrapper<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, res, weights, biases);
+    }
 
     ResWrite: for(unsigned i_out = 0; i_out < CONFIG_T::n_out / res_T::size; i_out++) {
         if (CONFIG_T::n_out / res_T::size > 1) {
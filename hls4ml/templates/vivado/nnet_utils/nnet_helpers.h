@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <iostream>
+#include <new>
 #include "hls_stream.h"
 
 namespace nnet {
@@ -67,8 +68,10 @@ void load_weights_from_txt(T *w, const char* fname) {
     }
 }
 
-template<class T, size_t SIZE>
-void load_compressed_weights_from_txt(T *w, const char* fname) {
+// Reads weights stored as structs, {a, b, ...}, {a, b, ...}, ... The fields of the i-th struct are passed to
+// parse_struct(fields, i), which returns false if they can't be parsed
+template<size_t SIZE, class Parser>
+void load_struct_weights_from_txt(const char* fname, Parser parse_struct) {
 
     std::string full_path = std::string(WEIGHTS_DIR) + "/" + std::string(fname);
     std::ifstream infile(full_path.c_str(), std::ios::binary);
@@ -99,7 +102,7 @@ void load_compressed_weights_from_txt(T *w, const char* fname) {
             std::replace(token.begin(), token.end(), ',', ' ');
             std::istringstream structss(token);
 
-            if(!(structss >> w[i].row_index >> w[i].col_index >> w[i].weight)) {
+            if(!parse_struct(structss, i)) {
                 std::cerr << "ERROR: Unable to parse file " << std::string(fname);
                 exit(1);
             }
@@ -113,51 +116,61 @@ void load_compressed_weights_from_txt(T *w, const char* fname) {
     }
 }
 
+template<class T, size_t SIZE>
+void load_compressed_weights_from_txt(T *w, const char* fname) {
+    load_struct_weights_from_txt<SIZE>(fname, [w](std::istringstream &fields, size_t i) {
+        return !(fields >> w[i].row_index >> w[i].col_index >> w[i].weight).fail();
+    });
+}
+
 template<class T, size_t SIZE>
 void load_exponent_weights_from_txt(T *w, const char* fname) {
+    load_struct_weights_from_txt<SIZE>(fname, [w](std::istringstream &fields, size_t i) {
+        return !(fields >> w[i].sign >> w[i].weight).fail();
+    });
+}
 
-    std::string full_path = std::string(WEIGHTS_DIR) + "/" + std::string(fname);
-    std::ifstream infile(full_path.c_str(), std::ios::binary);
+template<class T, size_t SIZE>
+void load_codebook_weights_from_txt(T *w, const char* fname) {
+    load_struct_weights_from_txt<SIZE>(fname, [w](std::istringstream &fields, size_t i) {
+        unsigned index;
+        if (!(fields >> index)) {
+            return false;
+        }
+        w[i].index = index;
+        return true;
+    });
+}
 
-    if (infile.fail()) {
-        std::cerr << "ERROR: file " << std::string(fname) << " does not exist" << std::endl;
-        exit(1);
+// Copies weights from a buffer of floats (element_size = 4) or doubles (element_size = 8), used to replace weights at runtime
+// Returns the number of copied values, so weights of a layer can be read from consecutive parts of the same buffer
+template<class T, size_t SIZE>
+size_t copy_weights_from_buffer(T *w, const void *data, size_t element_size) {
+    for (size_t i = 0; i < SIZE; i++) {
+        if (element_size == 4) {
+            w[i] = ((const float *) data)[i];
+        } else {
+            w[i] = ((const double *) data)[i];
+        }
     }
+    return SIZE;
+}
 
-    std::string line;
-    if (std::getline(infile, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::string extra_chars = "} ";
-
-        size_t i = 0;
-        while(std::getline(iss, token, '{')) {
-            if (token.length() == 0) {
-                continue;
-            }
-            for (char c: extra_chars) {
-                token.erase(std::remove(token.begin(), token.end(), c), token.end());
-            }
-            if (token.back() == ',') {
-                token.erase(token.end() - 1);
-            }
-
-            std::replace(token.begin(), token.end(), ',', ' ');
-            std::istringstream structss(token);
-
-            if(!(structss >> w[i].sign >> w[i].weight)) {
-                std::cerr << "ERROR: Unable to parse file " << std::string(fname);
-                exit(1);
-            }
-            i++;
-        }
+// In C simulation of io_parallel designs, the outputs of the layers are stored in static arena buffers instead of the stack,
+// and outputs that are not used at the same time share a buffer (see myproject.cpp)
+constexpr size_t arena_bytes(size_t a, size_t b) {
+    return a > b ? a : b;
+}
 
-        if (SIZE != i) {
-            std::cerr << "ERROR: Expected " << SIZE << " values";
-            std::cerr << " but read only " << i << " values" << std::endl;
-        }
+template<class T, size_t SIZE>
+T (&arena_array(unsigned char *buffer))[SIZE] {
+    T *data = reinterpret_cast<T *>(buffer);
+    for (size_t i = 0; i < SIZE; i++) {
+        new (&data[i]) T();
     }
+    return *reinterpret_cast<T (*)[SIZE]>(data);
 }
+
 template<class srcType, class dstType, size_t SIZE>
 void convert_data(srcType *src, dstType *dst) {
     for (size_t i = 0; i < SIZE; i++) {
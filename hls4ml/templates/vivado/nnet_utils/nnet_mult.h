@@ -100,8 +100,107 @@ class weight_exponential : public Product{
     }
 };
 
+// Compile-time list of the indices of a table (std::index_sequence is C++14)
+template<unsigned... I> struct index_list {};
+template<unsigned N, unsigned... I> struct make_index_list : make_index_list<N - 1, N - 1, I...> {};
+template<unsigned... I> struct make_index_list<0, I...> { typedef index_list<I...> type; };
+
+template<class T> struct ap_is_signed { static const bool value = true; };
+template<int W, int I, ap_q_mode Q, ap_o_mode O, int N> struct ap_is_signed<ap_ufixed<W, I, Q, O, N> > { static const bool value = false; };
+template<int W> struct ap_is_signed<ap_uint<W> > { static const bool value = false; };
+
+template<class x_T, class w_T>
+class lut_mult : public Product{
+    public:
+    // Product of two narrow operands as a truth table indexed by the concatenated bits of the operands.
+    // The product of the raw bits is the raw value of r_T, so the table is built at compile time.
+    using r_T = decltype(x_T(0) * w_T(0));
+    static const unsigned table_size = 1 << (x_T::width + w_T::width);
+    static constexpr int raw(unsigned bits, unsigned width, bool is_signed){
+        return (is_signed && ((bits >> (width - 1)) & 1)) ? int(bits) - (1 << width) : int(bits);
+    }
+    static constexpr int entry(unsigned i){
+        return raw(i >> w_T::width, x_T::width, ap_is_signed<x_T>::value) * raw(i & ((1u << w_T::width) - 1), w_T::width, ap_is_signed<w_T>::value);
+    }
+    template<unsigned... I>
+    static r_T lookup(index_list<I...>, ap_uint<x_T::width + w_T::width> index){
+        #pragma HLS INLINE
+        // Constant table, completely partitioned so each product is a multiplexer of constants (LUT logic)
+        static const ap_int<r_T::width> table[table_size] = {entry(I)...};
+        #pragma HLS ARRAY_PARTITION variable=table complete
+        r_T r;
+        r.range(r_T::width-1, 0) = table[index].range(r_T::width-1, 0);
+        return r;
+    }
+    static r_T product(x_T a, w_T w){
+        #pragma HLS INLINE
+        ap_uint<x_T::width> a_bits = a.range(x_T::width-1, 0);
+        ap_uint<w_T::width> w_bits = w.range(w_T::width-1, 0);
+        ap_uint<x_T::width + w_T::width> index = (a_bits, w_bits);
+        return lookup(typename make_index_list<table_size>::type(), index);
+    }
+};
+
+template<class x_T, class w_T>
+class weight_codebook : public Product{
+    public:
+    // Weights are indices into a codebook of n_entries shared values, which is part of the weight type
+    using r_T = decltype(x_T(0) * typename w_T::value_t(0));
+    static const unsigned n_entries = w_T::n_entries;
+    static r_T product(x_T a, w_T w){
+        // Product with the codebook value of the weight
+        #pragma HLS INLINE
+        return a * w_T::value(w.index);
+    }
+    static void bank(x_T a, r_T p[n_entries]){
+        // Products of an input with every codebook value, shared by all the weights of that input
+        #pragma HLS INLINE
+        for(unsigned k = 0; k < n_entries; k++){
+            #pragma HLS UNROLL
+            p[k] = a * w_T::value(k);
+        }
+    }
+    static r_T select(r_T p[n_entries], w_T w){
+        #pragma HLS INLINE
+        return p[w.index];
+    }
+    static void limit(unsigned multiplier_limit){
+        #pragma HLS INLINE
+        #pragma HLS ALLOCATION instances=mul limit=multiplier_limit operation
+    }
+};
+
 } // namespace product_type
 
+/* ---
+ * Products of one input with a row of N weights. The codebook product computes the products of the
+ * input with the n_entries codebook values once and selects one per weight, the others multiply per weight.
+ * --- */
+
+template<class P> struct is_codebook_product : std::false_type {};
+template<class x_T, class w_T> struct is_codebook_product<product::weight_codebook<x_T, w_T>> : std::true_type {};
+
+template<class P, unsigned N, class x_T, class w_T, class r_T>
+inline typename std::enable_if<! is_codebook_product<P>::value>::type
+product_row(x_T a, w_T w[N], r_T res[N]){
+    #pragma HLS INLINE
+    Product2: for(unsigned j = 0; j < N; j++) {
+        res[j] = P::product(a, w[j]);
+    }
+}
+
+template<class P, unsigned N, class x_T, class w_T, class r_T>
+inline typename std::enable_if<is_codebook_product<P>::value>::type
+product_row(x_T a, w_T w[N], r_T res[N]){
+    #pragma HLS INLINE
+    typename P::r_T bank[P::n_entries];
+    #pragma HLS ARRAY_PARTITION variable=bank complete
+    P::bank(a, bank);
+    Product2: for(unsigned j = 0; j < N; j++) {
+        res[j] = P::select(bank, w[j]);
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 inline typename std::enable_if<std::is_same<data_T, ap_uint<1>>::value
         && std::is_same<typename CONFIG_T::weight_t, ap_uint<1>>::value, ap_int<nnet::ceillog2(CONFIG_T::n_in) + 2>>::type
@@ -122,6 +221,26 @@ cast(typename CONFIG_T::accum_t x){
   return (res_T) x;
 }
 
+/* ---
+ * Output epilogue with the output channel of the accumulator. In the integer-only mode (CONFIG_T::requant)
+ * the accumulator is requantized with a per-channel fixed-point multiplier, whose binary point encodes
+ * the shift, and a per-channel bias. Otherwise it's a plain cast.
+ * --- */
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline typename std::enable_if<CONFIG_T::requant, res_T>::type
+cast(typename CONFIG_T::accum_t x, unsigned ch){
+  #pragma HLS INLINE
+  return (res_T) (x * CONFIG_T::requant_scale[ch] + CONFIG_T::requant_bias[ch]);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+inline typename std::enable_if<! CONFIG_T::requant, res_T>::type
+cast(typename CONFIG_T::accum_t x, unsigned ch){
+  #pragma HLS INLINE
+  return (res_T) cast<data_T, res_T, CONFIG_T>(x);
+}
+
 }
 
 #endif
@@ -24,6 +24,7 @@ struct multiheadattention_config
     static const unsigned head_dim_value = 10;
     static const unsigned feature_dim = 20;
     static const unsigned seq_len = 500;
+    static const unsigned n_tokens = 500; // New tokens per call of multiheadattention_kv_cache
 
     // Resource reuse info
     static const unsigned io_type = io_parallel;
@@ -341,6 +342,133 @@ void multiheadattention(
     // std::cout << " " << std::endl;
 
 }
+
+// *************************************************
+//       Key/value cache for incremental inference
+// *************************************************
+
+// Attention of n_tokens new tokens per call over the last seq_len tokens of the sequence. The projected keys and
+// values of the previous tokens are kept in a circular cache between calls, so each call only projects the new
+// tokens and computes their scores, i.e., the cost per token is O(seq_len) instead of O(seq_len^2) when the whole
+// window is recomputed. The outputs are the last n_tokens rows of multiheadattention over the window ending at the
+// newest token, once seq_len tokens have been seen. The cache is cleared with the other incremental state.
+template<class data_T, class res_T, typename CONFIG_T>
+void multiheadattention_kv_cache(
+    data_T    data_q[CONFIG_T::n_tokens * CONFIG_T::feature_dim],
+    data_T    data_vk[CONFIG_T::n_tokens * CONFIG_T::feature_dim],
+    res_T     res[CONFIG_T::n_tokens * CONFIG_T::feature_dim],
+    typename CONFIG_T::weight_t  attention_output_weight[CONFIG_T::num_heads * CONFIG_T::head_dim_value * CONFIG_T::feature_dim],
+    typename CONFIG_T::bias_t    attention_output_bias[CONFIG_T::feature_dim],
+    typename CONFIG_T::weight_t  key_weight[CONFIG_T::feature_dim * CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::bias_t    key_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::weight_t  query_weight[CONFIG_T::feature_dim * CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::bias_t    query_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_key],
+    typename CONFIG_T::weight_t  value_weight[CONFIG_T::feature_dim * CONFIG_T::num_heads * CONFIG_T::head_dim_value],
+    typename CONFIG_T::bias_t    value_bias[CONFIG_T::num_heads * CONFIG_T::head_dim_value])
+{
+    // The positions are read one at a time, the cache is partitioned on the heads and the head dimensions
+    static data_T k_cache[CONFIG_T::num_heads][CONFIG_T::seq_len][CONFIG_T::head_dim_key];
+    static data_T v_cache[CONFIG_T::num_heads][CONFIG_T::seq_len][CONFIG_T::head_dim_value];
+	#pragma HLS ARRAY_PARTITION variable=k_cache complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=k_cache complete dim=3
+	#pragma HLS ARRAY_PARTITION variable=v_cache complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=v_cache complete dim=3
+    static unsigned next_pos = 0; // Position of the cache written by the next token
+    static unsigned n_valid = 0;  // Number of filled positions
+
+    // The positions above n_valid are masked, so the cache itself doesn't need to be cleared
+    if (nnet::incremental_reset<CONFIG_T>()) {
+        next_pos = 0;
+        n_valid = 0;
+    }
+
+    const data_T dk = 1.0/sqrt(CONFIG_T::head_dim_key);
+    data_T in_q[CONFIG_T::feature_dim];
+    data_T in_v[CONFIG_T::feature_dim];
+    data_T proj_k[CONFIG_T::head_dim_key];
+    data_T proj_q[CONFIG_T::head_dim_key];
+    data_T proj_v[CONFIG_T::head_dim_value];
+    data_T scores[CONFIG_T::seq_len];
+    data_T weights[CONFIG_T::seq_len];
+    data_T mat_res_con[CONFIG_T::num_heads*CONFIG_T::head_dim_value];
+    res_T dense_out[CONFIG_T::feature_dim];
+	#pragma HLS ARRAY_PARTITION variable=in_q complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=in_v complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=proj_k complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=proj_q complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=proj_v complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=scores complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=weights complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=mat_res_con complete dim=1
+	#pragma HLS ARRAY_PARTITION variable=dense_out complete dim=1
+
+    // All new tokens are added to the cache first, so each of them attends to the whole window
+    cache_kv: for (int t=0; t < CONFIG_T::n_tokens; ++t){
+    	for (int k=0; k < CONFIG_T::feature_dim; ++k){
+		#pragma HLS UNROLL
+    		in_v[k] = data_vk[t*CONFIG_T::feature_dim + k];
+    	}
+    	for (int i=0; i < CONFIG_T::num_heads; ++i){
+		#pragma HLS UNROLL
+    		dense<data_T, data_T, typename CONFIG_T::config_mult1>(in_v, proj_k, key_weight+(CONFIG_T::head_dim_key*CONFIG_T::feature_dim*i), key_bias+(CONFIG_T::head_dim_key*i));
+    		dense<data_T, data_T, typename CONFIG_T::config_mult1>(in_v, proj_v, value_weight+(CONFIG_T::head_dim_value*CONFIG_T::feature_dim*i), value_bias+(CONFIG_T::head_dim_value*i));
+    		for (int j=0; j < CONFIG_T::head_dim_key; ++j){
+			#pragma HLS UNROLL
+    			k_cache[i][next_pos][j] = proj_k[j];
+    		}
+    		for (int j=0; j < CONFIG_T::head_dim_value; ++j){
+			#pragma HLS UNROLL
+    			v_cache[i][next_pos][j] = proj_v[j];
+    		}
+    	}
+    	next_pos = (next_pos == CONFIG_T::seq_len - 1) ? 0 : next_pos + 1;
+    	if (n_valid < CONFIG_T::seq_len) n_valid++;
+    }
+
+    // The order of the positions in the cache doesn't matter, the attention is invariant to their permutation
+    query: for (int t=0; t < CONFIG_T::n_tokens; ++t){
+    	for (int k=0; k < CONFIG_T::feature_dim; ++k){
+		#pragma HLS UNROLL
+    		in_q[k] = data_q[t*CONFIG_T::feature_dim + k];
+    	}
+    	for (int i=0; i < CONFIG_T::num_heads; ++i){
+    		dense<data_T, data_T, typename CONFIG_T::config_mult1>(in_q, proj_q, query_weight+(CONFIG_T::head_dim_key*CONFIG_T::feature_dim*i), query_bias+(CONFIG_T::head_dim_key*i));
+
+    		score: for (int j=0; j < CONFIG_T::seq_len; ++j){
+			#pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+    			typename CONFIG_T::accum_t QKij = 0;
+    			for (int k=0; k < CONFIG_T::head_dim_key; ++k){
+    				QKij += CONFIG_T::template product<data_T, data_T>::product(proj_q[k], k_cache[i][j][k]);
+    			}
+    			scores[j] = QKij * dk;
+    		}
+    		// Only the filled positions of the cache take part in the softmax
+    		softmax_legacy<data_T, data_T, typename CONFIG_T::softmax_config1>(scores, n_valid, weights);
+
+    		typename CONFIG_T::accum_t Sij[CONFIG_T::head_dim_value];
+			#pragma HLS ARRAY_PARTITION variable=Sij complete dim=1
+    		for (int k=0; k < CONFIG_T::head_dim_value; ++k){
+			#pragma HLS UNROLL
+    			Sij[k] = 0;
+    		}
+    		weighted_sum: for (int j=0; j < CONFIG_T::seq_len; ++j){
+			#pragma HLS PIPELINE II=CONFIG_T::reuse_factor
+    			for (int k=0; k < CONFIG_T::head_dim_value; ++k){
+    				Sij[k] += CONFIG_T::template product<data_T, data_T>::product(weights[j], v_cache[i][j][k]);
+    			}
+    		}
+    		for (int k=0; k < CONFIG_T::head_dim_value; ++k){
+			#pragma HLS UNROLL
+    			mat_res_con[CONFIG_T::head_dim_value*i+k] = Sij[k];
+    		}
+    	}
+    	dense<data_T, res_T, typename CONFIG_T::config_mult2>(mat_res_con, dense_out, attention_output_weight, attention_output_bias);
+    	for (int k=0; k < CONFIG_T::feature_dim; ++k){
+		#pragma HLS UNROLL
+    		res[CONFIG_T::feature_dim*t+k] = dense_out[k];
+    	}
+    }
+}
 }
 
 #endif
@@ -93,6 +93,9 @@ struct pooling1d_config{
     static const unsigned pad_right = 0;
     // Pooling function
     static const Pool_Op pool_op = Max;
+    // Sliding window inference (io_stream), n_in new pixels per call, see pooling1d_incremental_cl
+    static const bool incremental = false;
+    static const unsigned incremental_offset = stride_width - 1;
 };
 
 template<typename CONFIG_T>
@@ -436,12 +436,78 @@ void pooling1d_buffer_cl(
 }
 
 
+// Incremental (sliding window) version, n_in new pixels per call, see compute_output_incremental_1d
+template<class data_T, class res_T, typename CONFIG_T>
+void compute_pool_incremental_1d(
+    const data_T& in_elem,
+    const bool reset,
+    hls::stream<res_T> &res
+) {
+    #pragma HLS INLINE
+    const static unsigned first_phase = (CONFIG_T::stride_width - CONFIG_T::incremental_offset % CONFIG_T::stride_width) % CONFIG_T::stride_width;
+
+    static unsigned phase = first_phase;
+
+    typename data_T::value_type pool_window[CONFIG_T::pool_width];
+    #pragma HLS ARRAY_PARTITION variable=pool_window complete
+
+    static typename data_T::value_type kernel_data[CONFIG_T::pool_width * CONFIG_T::n_filt];
+    #pragma HLS ARRAY_PARTITION variable = kernel_data complete dim = 0
+
+    res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+
+    if (reset) {
+        phase = first_phase;
+        ResetKernel: for (unsigned i = 0; i < CONFIG_T::pool_width * CONFIG_T::n_filt; i++) {
+            #pragma HLS UNROLL
+            kernel_data[i] = 0;
+        }
+    }
+
+    nnet::kernel_shift_1d<data_T, CONFIG_T>(in_elem, kernel_data);
+
+    if (phase == 0) {
+        FiltLoop: for(unsigned i_ic = 0; i_ic < CONFIG_T::n_filt; i_ic++) {
+            #pragma HLS PIPELINE
+            PoolLoop: for(unsigned i_iw = 0; i_iw < CONFIG_T::pool_width; i_iw++) {
+                pool_window[i_iw] = kernel_data[i_iw * CONFIG_T::n_filt + i_ic];
+            }
+            res_pack[i_ic] = reduce_pool<typename data_T::value_type, CONFIG_T::pool_width, CONFIG_T>(pool_window);
+        }
+
+        res.write(res_pack);
+    }
+
+    phase = (phase + 1 == CONFIG_T::stride_width) ? 0 : phase + 1;
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void pooling1d_incremental_cl(
+    hls::stream<data_T> &data,
+    hls::stream<res_T> &res
+) {
+    assert(CONFIG_T::pad_left == 0 && CONFIG_T::pad_right == 0);
+
+    const bool reset = incremental_reset<CONFIG_T>();
+
+    ReadInputWidth: for (unsigned i_iw = 0; i_iw < CONFIG_T::n_in; i_iw++) {
+        #pragma HLS LOOP_FLATTEN
+        #pragma HLS PIPELINE
+        compute_pool_incremental_1d<data_T, res_T, CONFIG_T>(data.read(), reset && i_iw == 0, res);
+    }
+}
+
 template<class data_T, class res_T, typename CONFIG_T>
 void pooling1d_cl(
     hls::stream<data_T> &data,
     hls::stream<res_T> &res
 ) {
     #pragma HLS inline region
+    if (CONFIG_T::incremental) {
+        pooling1d_incremental_cl<data_T, res_T, CONFIG_T>(data, res);
+        return;
+    }
     switch(CONFIG_T::implementation){
         case conv_implementation::linebuffer:
             pooling1d_buffer_cl<data_T, res_T, CONFIG_T>(data, res);
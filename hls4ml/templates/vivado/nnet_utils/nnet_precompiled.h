@@ -0,0 +1,18 @@
+#ifndef NNET_PRECOMPILED_H_
+#define NNET_PRECOMPILED_H_
+
+// Headers that do not depend on the model, precompiled by build_lib.sh and included before every translation unit
+// Only used for GCC compilation / hls4ml.predict(...); the order is the same as in myproject.h and parameters.h
+#include "ap_int.h"
+#include "ap_fixed.h"
+#include "hls_stream.h"
+
+#include "nnet_helpers.h"
+#include "nnet_common.h"
+#include "nnet_types.h"
+#include "nnet_stream.h"
+#include "nnet_mult.h"
+#include "nnet_activation.h"
+#include "nnet_activation_stream.h"
+
+#endif
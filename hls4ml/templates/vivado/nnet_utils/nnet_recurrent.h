@@ -50,6 +50,10 @@ struct lstm_config
     static const unsigned n_zeros = 0;
     static const bool store_weights_in_bram = false;
     static const bool use_static = true;
+    // Keep the state between calls (incremental inference), until the reset
+    static const bool incremental = false;
+    // Number of independent streams with their own state, see the multi-context lstm_stack/gru_stack
+    static const unsigned n_contexts = 1;
 
     template<class x_T, class y_T, class config_T>
     using activation_recr = nnet::activation::relu<x_T, y_T, config_T>;
@@ -221,7 +225,7 @@ template<class data_T, class res_T, typename CONFIG_T>
     res_T     h_newstate[CONFIG_T::n_state];
     res_T     s_newstate[CONFIG_T::n_state];
     data_T    data_in[CONFIG_T::n_in];
-    bool      reset_state = true;
+    bool      reset_state = !CONFIG_T::incremental || nnet::incremental_reset<CONFIG_T>();
 
     #pragma HLS ARRAY_PARTITION variable=h_newstate complete
     #pragma HLS ARRAY_PARTITION variable=s_newstate complete
@@ -276,7 +280,7 @@ template<class data_T, class res_T, typename CONFIG_T>
     }
  
     typename data_T::value_type data_in[CONFIG_T::n_in];
-    bool reset_state = true;
+    bool reset_state = !CONFIG_T::incremental || nnet::incremental_reset<CONFIG_T>();
 
     DataPropagation: for(int i_in = 0; i_in < CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size; i_in++) {
       if (CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size > 1) {
@@ -338,6 +342,10 @@ struct gru_config
     static const bool store_weights_in_bram = false;
     static const bool use_static = true;
     static const unsigned n_zeros = 0;
+    // Keep the state between calls (incremental inference), until the reset
+    static const bool incremental = false;
+    // Number of independent streams with their own state, see the multi-context lstm_stack/gru_stack
+    static const unsigned n_contexts = 1;
 
     template<class x_T, class y_T, class config_T>
     using activation_recr = nnet::activation::relu<x_T, y_T, config_T>;
@@ -498,7 +506,7 @@ template<class data_T, class res_T, typename CONFIG_T>
 
       res_T   h_state[CONFIG_T::n_state];
       data_T  data_in[CONFIG_T::n_in];
-      bool    reset_state = true;
+      bool    reset_state = !CONFIG_T::incremental || nnet::incremental_reset<CONFIG_T>();
 
       #pragma HLS ARRAY_PARTITION variable=h_state complete
       #pragma HLS ARRAY_PARTITION variable=data_in complete
@@ -548,7 +556,7 @@ template<class data_T, class res_T, typename CONFIG_T>
     }
 
     typename data_T::value_type data_in[CONFIG_T::n_in];
-    bool reset_state = true;
+    bool reset_state = !CONFIG_T::incremental || nnet::incremental_reset<CONFIG_T>();
 
     DataPropagation: for(int i_in = 0; i_in < CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size; i_in++) {
       if (CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size > 1) {
@@ -588,6 +596,265 @@ template<class data_T, class res_T, typename CONFIG_T>
 }
 
 
+// *************************************************
+//       Multi-context recurrent layers
+// *************************************************
+// With n_contexts > 1, the layer serves several independent streams (contexts). The state of each context is kept in a
+// table of n_contexts x n_state values (BRAM, one row per context): the row of the context is read at the start of the
+// call, updated over the time steps of the call and written back at the end.
+// A context outside [0, n_contexts) starts from a zero state and its state is not written back, so it cannot
+// address past the table or overwrite the row of another context.
+
+template<class T, typename CONFIG_T>
+void clear_context_state(T table[CONFIG_T::n_contexts][CONFIG_T::n_state]) {
+    ClearContexts: for (unsigned i_ctx = 0; i_ctx < CONFIG_T::n_contexts; i_ctx++) {
+        #pragma HLS PIPELINE
+        for (unsigned i_state = 0; i_state < CONFIG_T::n_state; i_state++) {
+            table[i_ctx][i_state] = 0;
+        }
+    }
+}
+
+template<class T, typename CONFIG_T>
+void load_context_state(const unsigned context, T table[CONFIG_T::n_contexts][CONFIG_T::n_state], T state[CONFIG_T::n_state]) {
+    #pragma HLS INLINE
+    const bool valid = context < CONFIG_T::n_contexts;
+    const unsigned row = valid ? context : 0;
+    LoadState: for (unsigned i_state = 0; i_state < CONFIG_T::n_state; i_state++) {
+        #pragma HLS UNROLL
+        state[i_state] = valid ? table[row][i_state] : (T) 0;
+    }
+}
+
+template<class T, typename CONFIG_T>
+void store_context_state(const unsigned context, T table[CONFIG_T::n_contexts][CONFIG_T::n_state], T state[CONFIG_T::n_state]) {
+    #pragma HLS INLINE
+    if (context >= CONFIG_T::n_contexts) return;
+    StoreState: for (unsigned i_state = 0; i_state < CONFIG_T::n_state; i_state++) {
+        #pragma HLS UNROLL
+        table[context][i_state] = state[i_state];
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack(
+      data_T data[CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T  res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      const unsigned context,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_b[CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+
+    static res_T h_table[CONFIG_T::n_contexts][CONFIG_T::n_state];
+    static res_T s_table[CONFIG_T::n_contexts][CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_table complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=s_table complete dim=2
+    #pragma HLS RESOURCE variable=h_table core=RAM_2P_BRAM
+    #pragma HLS RESOURCE variable=s_table core=RAM_2P_BRAM
+
+    res_T     h_newstate[CONFIG_T::n_state];
+    res_T     s_newstate[CONFIG_T::n_state];
+    data_T    data_in[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=h_newstate complete
+    #pragma HLS ARRAY_PARTITION variable=s_newstate complete
+
+    if (nnet::incremental_reset<CONFIG_T>()) {
+      clear_context_state<res_T, CONFIG_T>(h_table);
+      clear_context_state<res_T, CONFIG_T>(s_table);
+    }
+    load_context_state<res_T, CONFIG_T>(context, h_table, h_newstate);
+    load_context_state<res_T, CONFIG_T>(context, s_table, s_newstate);
+
+    for(int iloop = 0; iloop < CONFIG_T::n_sequence; iloop++) {
+      for(int j = 0; j < CONFIG_T::n_in; j++) {
+      #pragma HLS UNROLL
+        data_in[j] =  data[j + iloop*CONFIG_T::n_in];
+      }
+      nnet::lstm<data_T, res_T, CONFIG_T>(false,data_in,h_newstate, s_newstate, param,param_r,param_b, param_br);
+      if (CONFIG_T::n_sequence_out > 1)
+        for(int i=CONFIG_T::n_state*iloop, j=0; i<(CONFIG_T::n_state*(iloop+1)); i++,j++){
+          #pragma HLS UNROLL
+          res[i] = h_newstate[j];
+        }
+    }
+    if (CONFIG_T::n_sequence_out == 1)
+      for(int i=0; i<(CONFIG_T::n_state); i++){
+        #pragma HLS UNROLL
+        res[i] = h_newstate[i];
+      }
+
+    store_context_state<res_T, CONFIG_T>(context, h_table, h_newstate);
+    store_context_state<res_T, CONFIG_T>(context, s_table, s_newstate);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void lstm_stack(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      const unsigned context,
+      typename CONFIG_T::weight_t     param  [CONFIG_T::n_state*4*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_r[CONFIG_T::n_state*4*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t     param_b[CONFIG_T::n_state*4],
+      typename CONFIG_T::bias_t     param_br[CONFIG_T::n_state*4]
+      ) {
+
+    static typename res_T::value_type h_table[CONFIG_T::n_contexts][CONFIG_T::n_state];
+    static typename res_T::value_type s_table[CONFIG_T::n_contexts][CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_table complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=s_table complete dim=2
+    #pragma HLS RESOURCE variable=h_table core=RAM_2P_BRAM
+    #pragma HLS RESOURCE variable=s_table core=RAM_2P_BRAM
+
+    typename res_T::value_type  h_newstate[CONFIG_T::n_state];
+    typename res_T::value_type  s_newstate[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_newstate complete
+    #pragma HLS ARRAY_PARTITION variable=s_newstate complete
+
+    if (nnet::incremental_reset<CONFIG_T>()) {
+      clear_context_state<typename res_T::value_type, CONFIG_T>(h_table);
+      clear_context_state<typename res_T::value_type, CONFIG_T>(s_table);
+    }
+    load_context_state<typename res_T::value_type, CONFIG_T>(context, h_table, h_newstate);
+    load_context_state<typename res_T::value_type, CONFIG_T>(context, s_table, s_newstate);
+
+    typename data_T::value_type data_in[CONFIG_T::n_in];
+
+    DataPropagation: for(int i_in = 0; i_in < CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size; i_in++) {
+      data_T data_pack = data_stream.read();
+      DataPack: for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          data_in[i_pack] = data_pack[i_pack];
+      }
+      nnet::lstm<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(false,data_in,h_newstate, s_newstate, param,param_r,param_b, param_br);
+      if (CONFIG_T::n_sequence_out > 1){
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack_sequences: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            res_pack[i_pack] = h_newstate[i_pack];
+        }
+        res_stream.write(res_pack);
+      }
+    }
+
+    if (CONFIG_T::n_sequence_out == 1){
+      res_T res_pack;
+      #pragma HLS DATA_PACK variable=res_pack
+      ResPack: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          res_pack[i_pack] = h_newstate[i_pack];
+      }
+      res_stream.write(res_pack);
+    }
+
+    store_context_state<typename res_T::value_type, CONFIG_T>(context, h_table, h_newstate);
+    store_context_state<typename res_T::value_type, CONFIG_T>(context, s_table, s_newstate);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack(
+      data_T data[CONFIG_T::n_sequence*CONFIG_T::n_in],
+      res_T  res[CONFIG_T::n_sequence_out*CONFIG_T::n_state],
+      const unsigned context,
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+
+    static res_T h_table[CONFIG_T::n_contexts][CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_table complete dim=2
+    #pragma HLS RESOURCE variable=h_table core=RAM_2P_BRAM
+
+    res_T   h_state[CONFIG_T::n_state];
+    data_T  data_in[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=h_state complete
+    #pragma HLS ARRAY_PARTITION variable=data_in complete
+
+    if (nnet::incremental_reset<CONFIG_T>()) {
+      clear_context_state<res_T, CONFIG_T>(h_table);
+    }
+    load_context_state<res_T, CONFIG_T>(context, h_table, h_state);
+
+    for(int iloop = 0; iloop < CONFIG_T::n_sequence; iloop++) {
+      for(int j = 0; j < CONFIG_T::n_in; j++) {
+      #pragma HLS UNROLL
+        data_in[j] = data[j + iloop*CONFIG_T::n_in];
+      }
+      nnet::gru<data_T, res_T, CONFIG_T>(false,data_in,h_state,param,param_zr,param_b, param_br);
+      if (CONFIG_T::n_sequence_out > 1)
+        for(int i=CONFIG_T::n_state*iloop, j=0; i<(CONFIG_T::n_state*(iloop+1)); i++,j++){
+          #pragma HLS UNROLL
+          res[i] = h_state[j];
+        }
+    }
+    if (CONFIG_T::n_sequence_out == 1)
+      for(int i=0; i<(CONFIG_T::n_state); i++){
+        #pragma HLS UNROLL
+        res[i] = h_state[i];
+      }
+
+    store_context_state<res_T, CONFIG_T>(context, h_table, h_state);
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+  void gru_stack(
+      hls::stream<data_T> &data_stream,
+      hls::stream<res_T>  &res_stream,
+      const unsigned context,
+      typename CONFIG_T::weight_t     param   [CONFIG_T::n_state*3*CONFIG_T::n_in],
+      typename CONFIG_T::weight_t     param_zr[CONFIG_T::n_state*3*CONFIG_T::n_state],
+      typename CONFIG_T::bias_t       param_b [CONFIG_T::n_state*3],
+      typename CONFIG_T::bias_t       param_br [CONFIG_T::n_state*3]
+      ) {
+
+    static typename res_T::value_type h_table[CONFIG_T::n_contexts][CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_table complete dim=2
+    #pragma HLS RESOURCE variable=h_table core=RAM_2P_BRAM
+
+    typename res_T::value_type  h_newstate[CONFIG_T::n_state];
+    #pragma HLS ARRAY_PARTITION variable=h_newstate complete
+
+    if (nnet::incremental_reset<CONFIG_T>()) {
+      clear_context_state<typename res_T::value_type, CONFIG_T>(h_table);
+    }
+    load_context_state<typename res_T::value_type, CONFIG_T>(context, h_table, h_newstate);
+
+    typename data_T::value_type data_in[CONFIG_T::n_in];
+
+    DataPropagation: for(int i_in = 0; i_in < CONFIG_T::n_sequence*CONFIG_T::n_in / data_T::size; i_in++) {
+      data_T data_pack = data_stream.read();
+      DataPack: for (int i_pack = 0; i_pack < data_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          data_in[i_pack] = data_pack[i_pack];
+      }
+      nnet::gru<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(false,data_in,h_newstate,param,param_zr,param_b, param_br);
+      if (CONFIG_T::n_sequence_out > 1){
+        res_T res_pack;
+        #pragma HLS DATA_PACK variable=res_pack
+        ResPack_sequences: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+            #pragma HLS UNROLL
+            res_pack[i_pack] = h_newstate[i_pack];
+        }
+        res_stream.write(res_pack);
+      }
+    }
+
+    if (CONFIG_T::n_sequence_out == 1){
+      res_T res_pack;
+      #pragma HLS DATA_PACK variable=res_pack
+      ResPack: for (int i_pack = 0; i_pack < res_T::size; i_pack++) {
+          #pragma HLS UNROLL
+          res_pack[i_pack] = h_newstate[i_pack];
+      }
+      res_stream.write(res_pack);
+    }
+
+    store_context_state<typename res_T::value_type, CONFIG_T>(context, h_table, h_newstate);
+}
+
 }//end namespace
 
 #endif
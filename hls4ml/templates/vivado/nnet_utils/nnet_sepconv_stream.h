@@ -4,6 +4,7 @@
 #include "nnet_common.h"
 #include "hls_stream.h"
 #include "nnet_conv_stream.h"
+#include "nnet_dense_skip_zeros.h"
 
 namespace nnet {
 
@@ -152,16 +153,37 @@ void pointwise_mult_buffer(
     res_T res_pack;
     #pragma HLS DATA_PACK variable=res_pack
 
-    InitData: for (int id = 0; id < CONFIG_T::n_chan; id++) {
-        #pragma HLS UNROLL
-        data[id] = data_pack[id];
-    }
-
-    #pragma HLS INLINE region
-    if (CONFIG_T::strategy == nnet::latency) {
-        dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(data, res, weights, biases);
+    if (CONFIG_T::mult_config::skip_zeros) {
+        // Only the nonzero channels of the pixel are multiplied
+        // The whole pixel is compacted at once, so the lists are kept in registers
+        typedef typename CONFIG_T::mult_config mult_config;
+        typename data_T::value_type nz_data[mult_config::skip_zeros_lanes][CONFIG_T::n_chan / mult_config::skip_zeros_lanes];
+        unsigned nz_index[mult_config::skip_zeros_lanes][CONFIG_T::n_chan / mult_config::skip_zeros_lanes];
+        unsigned n_nonzero[mult_config::skip_zeros_lanes];
+        #pragma HLS ARRAY_PARTITION variable=nz_data complete dim=0
+        #pragma HLS ARRAY_PARTITION variable=nz_index complete dim=0
+        #pragma HLS ARRAY_PARTITION variable=n_nonzero complete
+        InitLanes: for (unsigned i_lane = 0; i_lane < mult_config::skip_zeros_lanes; i_lane++) {
+            #pragma HLS UNROLL
+            n_nonzero[i_lane] = 0;
+        }
+        CompactData: for (unsigned id = 0; id < CONFIG_T::n_chan; id++) {
+            #pragma HLS UNROLL
+            skip_zeros_compact<typename data_T::value_type, typename CONFIG_T::mult_config>(data_pack[id], id, nz_data, nz_index, n_nonzero);
+        }
+        dense_skip_zeros_mult<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(nz_data, nz_index, n_nonzero, res, weights, biases);
     } else {
-        dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(data, res, weights, biases);
+        InitData: for (int id = 0; id < CONFIG_T::n_chan; id++) {
+            #pragma HLS UNROLL
+            data[id] = data_pack[id];
+        }
+
+        #pragma HLS INLINE region
+        if (CONFIG_T::strategy == nnet::latency) {
+            dense_latency<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(data, res, weights, biases);
+        } else {
+            dense_resource<typename data_T::value_type, typename res_T::value_type, typename CONFIG_T::mult_config>(data, res, weights, biases);
+        }
     }
 
     CastLoop: for (unsigned jj = 0; jj < CONFIG_T::n_filt; jj++) {
@@ -0,0 +1,91 @@
+#ifndef NNET_TOPK_H_
+#define NNET_TOPK_H_
+
+#include "nnet_common.h"
+
+namespace nnet {
+
+struct topk_config {
+    static const unsigned n_in = 10;
+    static const unsigned k = 1;
+};
+
+template<class data_T, class index_T>
+struct topk_candidate {
+    data_T value;
+    index_T index;
+    bool valid;
+};
+
+// Keeps the larger of two candidates. In the balanced tree of reduce() the left operand always holds
+// the lower indices, so ties are resolved in favor of the lowest index, as in numpy.argmax
+template<class T>
+class Op_argmax{
+public:
+    T operator()(T a, T b){
+        return (!b.valid || (a.valid && a.value >= b.value)) ? a : b;
+    }
+};
+
+// Selects the k largest inputs in decreasing order, with one comparison tree per selected element
+template<class data_T, class index_T, typename CONFIG_T>
+void topk_select(
+    data_T data[CONFIG_T::n_in],
+    index_T index[CONFIG_T::k],
+    data_T value[CONFIG_T::k])
+{
+    #pragma HLS INLINE
+    typedef topk_candidate<data_T, index_T> cand_T;
+
+    cand_T cands[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=cands complete
+
+    for (unsigned i = 0; i < CONFIG_T::n_in; i++) {
+        #pragma HLS UNROLL
+        cands[i].value = data[i];
+        cands[i].index = i;
+        cands[i].valid = true;
+    }
+
+    Op_argmax<cand_T> op_argmax;
+    for (unsigned j = 0; j < CONFIG_T::k; j++) {
+        #pragma HLS UNROLL
+        cand_T best = reduce<cand_T, CONFIG_T::n_in, Op_argmax<cand_T>>(cands, op_argmax);
+        index[j] = best.index;
+        value[j] = best.value;
+        // The selected element doesn't take part in the following comparisons
+        for (unsigned i = 0; i < CONFIG_T::n_in; i++) {
+            #pragma HLS UNROLL
+            if (i == best.index) cands[i].valid = false;
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void topk(
+    data_T data[CONFIG_T::n_in],
+    res_T res[CONFIG_T::k])
+{
+    #pragma HLS PIPELINE
+    data_T value[CONFIG_T::k];
+    topk_select<data_T, res_T, CONFIG_T>(data, res, value);
+}
+
+template<class data_T, class res_T, class score_T, typename CONFIG_T>
+void topk(
+    data_T data[CONFIG_T::n_in],
+    res_T res[CONFIG_T::k],
+    score_T scores[CONFIG_T::k])
+{
+    #pragma HLS PIPELINE
+    data_T value[CONFIG_T::k];
+    topk_select<data_T, res_T, CONFIG_T>(data, res, value);
+    for (unsigned j = 0; j < CONFIG_T::k; j++) {
+        #pragma HLS UNROLL
+        scores[j] = value[j];
+    }
+}
+
+}
+
+#endif
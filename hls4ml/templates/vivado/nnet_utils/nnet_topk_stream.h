@@ -0,0 +1,77 @@
+#ifndef NNET_TOPK_STREAM_H_
+#define NNET_TOPK_STREAM_H_
+
+#include "nnet_common.h"
+#include "nnet_topk.h"
+#include "hls_stream.h"
+
+namespace nnet {
+
+template<class data_T, typename CONFIG_T>
+void topk_read_input(
+    hls::stream<data_T> &data_stream,
+    typename data_T::value_type data[CONFIG_T::n_in])
+{
+    #pragma HLS INLINE
+    TopKRead: for (unsigned i = 0; i < CONFIG_T::n_in / data_T::size; i++) {
+        #pragma HLS PIPELINE
+        data_T in_data = data_stream.read();
+        TopKReadPack: for (unsigned j = 0; j < data_T::size; j++) {
+            #pragma HLS UNROLL
+            data[i * data_T::size + j] = in_data[j];
+        }
+    }
+}
+
+template<class data_T, class res_T, typename CONFIG_T>
+void topk(
+    hls::stream<data_T> &data_stream,
+    hls::stream<res_T>  &res_stream)
+{
+    typename data_T::value_type data[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=data complete
+    topk_read_input<data_T, CONFIG_T>(data_stream, data);
+
+    typename res_T::value_type index[CONFIG_T::k];
+    typename data_T::value_type value[CONFIG_T::k];
+    topk_select<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, index, value);
+
+    res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+    for (unsigned j = 0; j < CONFIG_T::k; j++) {
+        #pragma HLS UNROLL
+        res_pack[j] = index[j];
+    }
+    res_stream.write(res_pack);
+}
+
+template<class data_T, class res_T, class score_T, typename CONFIG_T>
+void topk(
+    hls::stream<data_T>  &data_stream,
+    hls::stream<res_T>   &res_stream,
+    hls::stream<score_T> &scores_stream)
+{
+    typename data_T::value_type data[CONFIG_T::n_in];
+    #pragma HLS ARRAY_PARTITION variable=data complete
+    topk_read_input<data_T, CONFIG_T>(data_stream, data);
+
+    typename res_T::value_type index[CONFIG_T::k];
+    typename data_T::value_type value[CONFIG_T::k];
+    topk_select<typename data_T::value_type, typename res_T::value_type, CONFIG_T>(data, index, value);
+
+    res_T res_pack;
+    #pragma HLS DATA_PACK variable=res_pack
+    score_T scores_pack;
+    #pragma HLS DATA_PACK variable=scores_pack
+    for (unsigned j = 0; j < CONFIG_T::k; j++) {
+        #pragma HLS UNROLL
+        res_pack[j] = index[j];
+        scores_pack[j] = value[j];
+    }
+    res_stream.write(res_pack);
+    scores_stream.write(scores_pack);
+}
+
+}
+
+#endif
@@ -5,6 +5,7 @@ import yaml
 from shutil import copyfile, copytree, rmtree
 import numpy as np
 import os
+import re
 import glob
 from collections import OrderedDict
 
@@ -200,9 +201,16 @@ class QuartusWriter(Writer):
             # Insert weights
             elif '//hls-fpga-machine-learning insert weights' in line:
                 newline = line
+                # When the layers are compiled as separate translation units, weights are only included in the unit of their layer
+                newline += '#ifdef HLS4ML_SPLIT_LAYERS\n'
+                for layer in model.get_layers():
+                    if layer.get_attr('function_cpp', None):
+                        newline += self.__get_unit_signature(model, layer) + ';\n'
+                newline += '#else\n'
                 for layer in model.get_layers():
                     for w in layer.get_weights():
                         newline += '#include "weights/{}.h"\n'.format(w.name)
+                newline += '#endif\n'
             
             # Insert test weights
             elif '//hls-fpga-machine-learning insert test weights' in line:
@@ -226,7 +234,11 @@ class QuartusWriter(Writer):
                                     newline += '    ' + def_cpp + ';\n'
                     func = layer.get_attr('function_cpp', None)
                     if func:
+                        newline += '#ifdef HLS4ML_SPLIT_LAYERS\n'
+                        newline += '    ' + self.__get_unit_call(model, layer) + '\n'
+                        newline += '#else\n'
                         newline += '    ' + func + '\n'
+                        newline += '#endif\n'
                         if model.config.trace_output and layer.get_attr('Trace', False):
                             newline += '#ifndef HLS_SYNTHESIS\n'
                             for var in vars:
@@ -344,6 +356,17 @@ class QuartusWriter(Writer):
         f.close()
         fout.close()
 
+    def __get_all_precision(self, model):
+        all_precision = OrderedDict()
+        for layer in model.get_layers():
+            layer_precision = layer.get_layer_precision()
+            for type_name, type_var in layer_precision.items():
+                # Ensure that layer's types doesn't override existing types
+                # This can happen in case of InplaceVariable types
+                if type_name not in all_precision:
+                    all_precision[type_name] = type_var
+        return all_precision
+
     def write_defines(self, model):
         filedir = os.path.dirname(os.path.abspath(__file__))
         f = open(os.path.join(filedir, '../templates/quartus/firmware/defines.h'), 'r')
@@ -359,10 +382,7 @@ class QuartusWriter(Writer):
 
             elif '//hls-fpga-machine-learning insert layer-precision' in line:
                 newline = line
-                all_precision = OrderedDict()
-                for layer in model.get_layers():
-                    layer_precision = layer.get_layer_precision()
-                    all_precision.update(layer_precision)
+                all_precision = self.__get_all_precision(model)
                 for used_type in all_precision.values():
                     newline += used_type.definition_cpp()
             else:
@@ -396,6 +416,92 @@ class QuartusWriter(Writer):
         f.close()
         fout.close()
 
+    def __get_unit_variables(self, model, layer):
+        # Variables passed to the layer's translation unit: all inputs, followed by all outputs
+        # Inplace layers (e.g. Reshape) share the variable of their input, so duplicates are skipped
+        unit_vars = OrderedDict()
+        for inp in layer.inputs:
+            var = model.get_layer_output_variable(inp)
+            if var is not None:
+                unit_vars[var.name] = var
+        for var in layer.get_variables():
+            unit_vars[var.name] = var
+        return list(unit_vars.values())
+
+    def __get_unit_signature(self, model, layer):
+        io_type = model.config.get_config_value('IOType')
+        params = []
+        for var in self.__get_unit_variables(model, layer):
+            if io_type == 'io_stream':
+                params.append('stream<{}> &{}'.format(var.type.name, var.name))
+            else:
+                params.append('{} {}[{}]'.format(var.type.name, getattr(var, 'member_name', var.name), var.size_cpp()))
+        return 'void {}_{}(\n    {}\n)'.format(model.config.get_project_name(), layer.name, ',\n    '.join(params))
+
+    def __get_unit_call(self, model, layer):
+        args = [var.name for var in self.__get_unit_variables(model, layer)]
+        return '{}_{}({});'.format(model.config.get_project_name(), layer.name, ', '.join(args))
+
+    def write_layer_units(self, model):
+        ###################
+        ## Per-layer translation units
+        ###################
+
+        # Each layer is instantiated in a separate translation unit, so that build_lib.sh can compile the layers in parallel
+        # A unit only contains the defines, types, config and weights of its own layer; therefore, a change to one layer
+        # only changes the preprocessed source of that layer, and the object files of the other layers are reused from the cache
+        # Units are only used for GCC compilation (HLS4ML_SPLIT_LAYERS); Intel HLS synthesis still uses myproject.cpp as a whole
+        unit_dir = '{}/firmware/layers'.format(model.config.get_output_dir())
+        if not os.path.isdir(unit_dir):
+            os.makedirs(unit_dir)
+        for stale_unit in glob.glob(unit_dir + '/*.cpp'):
+            os.remove(stale_unit)
+
+        all_precision = self.__get_all_precision(model)
+
+        for layer in model.get_layers():
+            func = layer.get_attr('function_cpp', None)
+            if not func:
+                continue
+
+            unit_vars = self.__get_unit_variables(model, layer)
+
+            numbers = OrderedDict()
+            for var in unit_vars:
+                for k, v in var.get_shape():
+                    numbers['#define {} {}\n'.format(k, v)] = None
+
+            # Types are resolved as in defines.h, so that the unit and the top-level function agree on all signatures
+            unit_precision = OrderedDict()
+            for type_name in [var.type.name for var in unit_vars] + list(layer.get_layer_precision().keys()):
+                unit_precision[type_name] = all_precision[type_name]
+
+            # Struct members (io_parallel inputs/outputs) are passed as plain arrays
+            for var in unit_vars:
+                if hasattr(var, 'member_name'):
+                    func = re.sub(r'(?<![\w.])' + re.escape(var.name) + r'\b', var.member_name, func)
+
+            fout = open('{}/{}.cpp'.format(unit_dir, layer.name), 'w')
+            fout.write('// Layer {} ({}), compiled separately during GCC compilation / hls4ml.predict(...)\n\n'.format(layer.name, layer.class_name))
+            fout.write('#define HLS4ML_LAYER_UNIT\n')
+            fout.write('#include "../defines.h"\n\n')
+            fout.write(''.join(numbers) + '\n')
+            for used_type in unit_precision.values():
+                fout.write(used_type.definition_cpp())
+            fout.write('\n#include "../nnet_utils/nnet_helpers.h"\n')
+            for include in sorted(set(layer.get_attr('include_header', []))):
+                fout.write('#include "../{}"\n'.format(include))
+            fout.write('\n')
+            config = layer.get_attr('config_cpp', None)
+            if config:
+                fout.write(config + '\n\n')
+            for w in layer.get_weights():
+                fout.write('#include "../weights/{}.h"\n'.format(w.name))
+            fout.write('\n' + self.__get_unit_signature(model, layer) + ' {\n')
+            fout.write('    ' + func + '\n')
+            fout.write('}\n')
+            fout.close()
+
     def write_weights(self, model):
         for layer in model.get_layers():
             for weights in layer.get_weights():
@@ -734,6 +840,56 @@ class QuartusWriter(Writer):
                                                                                                                 o.size_cpp(),
                                                                                                                 o.member_name,
                                                                                                                 o.member_name)
+            elif '//hls-fpga-machine-learning insert batch header' in line:
+                dtype = line.split('#', 1)[1].strip()
+                if io_type == 'io_stream':
+                    args = ['{type} {name}[]'.format(type=dtype, name=v.name) for v in model_inputs + model_outputs]
+                else:
+                    args = ['{type} {name}[]'.format(type=dtype, name=v.member_name) for v in model_inputs + model_outputs]
+                args.append('unsigned n_samples')
+                newline = ''.join([indent + arg + ',\n' for arg in args[:-1]]) + indent + args[-1] + '\n'
+
+            elif '//hls-fpga-machine-learning insert batch wrapper' in line:
+                dtype = line.split('#', 1)[1].strip()
+                project_name = model.config.get_project_name()
+                newline = ''
+                if io_type == 'io_stream':
+                    # All samples are written to the input streams, the component is enqueued once per sample
+                    for i in model_inputs:
+                        newline += indent + 'stream_in<{}> {}_input;\n'.format(i.type.name, i.name)
+                    for o in model_outputs:
+                        newline += indent + 'stream_out<{}> {}_output;\n'.format(o.type.name, o.name)
+                    newline += '\n'
+                    newline += indent + 'for (unsigned i = 0; i < n_samples; i++) {\n'
+                    for i in model_inputs:
+                        newline += indent + '    nnet::convert_data<{}, {}, {}>({} + i * ({}), {}_input);\n'.format(dtype, i.type.name, i.size_cpp(), i.name, i.size_cpp(), i.name)
+                    input_params = ', '.join([f'{i.name}_input' for i in model_inputs])
+                    output_params = ', '.join([f'{o.name}_output' for o in model_outputs])
+                    newline += indent + f'    ihc_hls_enqueue_noret(&{project_name}, {input_params}, {output_params});\n'
+                    newline += indent + '}\n'
+                    newline += indent + f'ihc_hls_component_run_all({project_name});\n'
+                    newline += '\n'
+                    newline += indent + 'for (unsigned i = 0; i < n_samples; i++) {\n'
+                    for o in model_outputs:
+                        newline += indent + '    nnet::convert_data_back<{}, {}, {}>({}_output, {} + i * ({}));\n'.format(o.type.name, dtype, o.size_cpp(), o.name, o.name, o.size_cpp())
+                    newline += indent + '}\n'
+                else:
+                    # Each sample gets its own input and output struct, which the enqueued invocation reads from / writes to
+                    newline += indent + 'std::vector<input_data> inputs_ap(n_samples);\n'
+                    newline += indent + 'std::vector<output_data> outputs_ap(n_samples);\n'
+                    newline += '\n'
+                    newline += indent + 'for (unsigned i = 0; i < n_samples; i++) {\n'
+                    for i in model_inputs:
+                        newline += indent + '    nnet::convert_data<{}, {}, {}>({} + i * ({}), inputs_ap[i].{});\n'.format(dtype, i.type.name, i.size_cpp(), i.member_name, i.size_cpp(), i.member_name)
+                    newline += indent + f'    ihc_hls_enqueue(&outputs_ap[i], {project_name}, inputs_ap[i]);\n'
+                    newline += indent + '}\n'
+                    newline += indent + f'ihc_hls_component_run_all({project_name});\n'
+                    newline += '\n'
+                    newline += indent + 'for (unsigned i = 0; i < n_samples; i++) {\n'
+                    for o in model_outputs:
+                        newline += indent + '    nnet::convert_data_back<{}, {}, {}>(outputs_ap[i].{}, {} + i * ({}));\n'.format(o.type.name, dtype, o.size_cpp(), o.member_name, o.member_name, o.size_cpp())
+                    newline += indent + '}\n'
+
             elif '//hls-fpga-machine-learning insert trace_outputs' in line:
                 newline = ''
                 for layer in model.get_layers():
@@ -786,6 +942,10 @@ class QuartusWriter(Writer):
         f.close()
         fout.close()
 
+        srcpath = os.path.join(filedir, '../templates/build_pch.sh')
+        dstpath = '{}/build_pch.sh'.format(model.config.get_output_dir())
+        copyfile(srcpath, dstpath)
+
     def write_nnet_utils(self, model):
         ###################
         ## nnet_utils
@@ -1218,6 +1378,7 @@ class QuartusWriter(Writer):
         self.write_weights(model)
         self.write_defines(model)
         self.write_parameters(model)
+        self.write_layer_units(model)
         self.write_test_bench(model)
         self.write_bridge(model)
         self.write_build_script(model)
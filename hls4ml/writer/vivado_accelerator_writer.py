@@ -32,6 +32,8 @@ class VivadoAcceleratorWriter(VivadoWriter):
                 newline = '#include "{}.h"\n'.format(model.config.get_project_name())
             elif 'void myproject(' in line:
                 newline = 'void {}_axi(\n'.format(model.config.get_project_name())
+            elif 'output_axi_t out[N_OUT]' in line and self._has_context_port(model):
+                newline = line.rstrip('\n') + ',\n' + indent + 'unsigned context\n'
             elif '//hls-fpga-machine-learning insert definitions' in line:
                 newline = ''
                 newline += 'static const unsigned N_IN = {};\n'.format(inp.size())
@@ -85,6 +87,8 @@ class VivadoAcceleratorWriter(VivadoWriter):
         for line in f.readlines():
             if 'void myproject(' in line:
                 newline = 'void {}_axi(\n'.format(model.config.get_project_name())
+            elif 'output_axi_t out[N_OUT]' in line and self._has_context_port(model):
+                newline = line.rstrip('\n') + ',\n' + indent + 'unsigned context\n'
             elif '//hls-fpga-machine-learning insert include' in line:
                 newline = '#include "{}_axi.h"\n'.format(model.config.get_project_name())
             elif '//hls-fpga-machine-learning insert local vars' in line:
@@ -102,14 +106,17 @@ class VivadoAcceleratorWriter(VivadoWriter):
                     newline += indent + '#pragma HLS STREAM variable=out_local depth={}\n'\
                         .format(model.get_output_variables()[0].pragma[1])
             elif '//hls-fpga-machine-learning insert call' in line:
-                newline = indent + '{}(in_local, out_local);\n'.format(
-                    model.config.get_project_name())
+                context_var = ', context' if self._has_context_port(model) else ''
+                newline = indent + '{}(in_local, out_local{});\n'.format(
+                    model.config.get_project_name(), context_var)
             elif '//hls-fpga-machine-learning insert interface' in line:
                 if self.vivado_accelerator_config.get_interface() == 'axi_lite':
                     newline = ''
                     newline += indent + '#pragma HLS INTERFACE ap_ctrl_none port=return\n'
                     newline += indent + '#pragma HLS INTERFACE s_axilite port=in\n'
                     newline += indent + '#pragma HLS INTERFACE s_axilite port=out\n'
+                    if self._has_context_port(model):
+                        newline += indent + '#pragma HLS INTERFACE s_axilite port=context\n'
                 elif self.vivado_accelerator_config.get_interface() == 'axi_master':
                     newline = ''
                     newline += indent + '#pragma HLS INTERFACE s_axilite port=return bundle=CTRL_BUS\n'
@@ -117,10 +124,14 @@ class VivadoAcceleratorWriter(VivadoWriter):
                         .format(model.get_input_variables()[0].pragma[1])
                     newline += indent + '#pragma HLS INTERFACE m_axi depth={} port=out offset=slave bundle=OUT_BUS\n'\
                         .format(model.get_output_variables()[0].pragma[1])
+                    if self._has_context_port(model):
+                        newline += indent + '#pragma HLS INTERFACE s_axilite port=context bundle=CTRL_BUS\n'
                 elif self.vivado_accelerator_config.get_interface() == 'axi_stream':
                     newline = ''
                     newline += indent + '#pragma HLS INTERFACE axis port=in\n'
                     newline += indent + '#pragma HLS INTERFACE axis port=out\n'
+                    if self._has_context_port(model):
+                        newline += indent + '#pragma HLS INTERFACE ap_none port=context\n'
                     newline += indent + '#pragma HLS INTERFACE ap_ctrl_none port=return\n'
                     if model.config.get_config_value("IOType") == 'io_stream':
                         newline += indent + '#pragma HLS DATAFLOW\n'
@@ -256,7 +267,8 @@ class VivadoAcceleratorWriter(VivadoWriter):
                 newline = ''
             elif '{}('.format(model.config.get_project_name()) in line:
                 indent_amount = line.split(model.config.get_project_name())[0]
-                newline = indent_amount + '{}_axi(inputs,outputs);\n'.format(model.config.get_project_name())
+                context_var = ',0' if self._has_context_port(model) else ''
+                newline = indent_amount + '{}_axi(inputs,outputs{});\n'.format(model.config.get_project_name(), context_var)
             elif inp.size_cpp() in line or inp.name in line or inp.type.name in line:
                 newline = line.replace(inp.size_cpp(), 'N_IN').replace(inp.name, 'inputs').replace(inp.type.name,
                                                                                                       'input_axi_t')
@@ -301,8 +313,9 @@ class VivadoAcceleratorWriter(VivadoWriter):
                                        'output_axi_t {}_ap[N_OUT]'.format(out.name))
             elif '{}('.format(model.config.get_project_name()) in line:
                 indent_amount = line.split(model.config.get_project_name())[0]
-                newline = indent_amount + '{}_axi({}_ap,{}_ap);\n'.format(model.config.get_project_name(), inp.name,
-                                                                          out.name)
+                context_var = ',recurrent_context' if self._has_context_port(model) else ''
+                newline = indent_amount + '{}_axi({}_ap,{}_ap{});\n'.format(model.config.get_project_name(), inp.name,
+                                                                            out.name, context_var)
             elif inp.size_cpp() in line or inp.name in line or inp.type.name in line:
                 newline = line.replace(inp.size_cpp(), 'N_IN').replace(inp.type.name, 'input_axi_t')
             elif out.size_cpp() in line or out.name in line or out.type.name in line:
@@ -340,6 +353,8 @@ class VivadoAcceleratorWriter(VivadoWriter):
         f.write('set part "{}"\n'.format(self.vivado_accelerator_config.get_part()))
         f.write('variable clock_period\n')
         f.write('set clock_period {}\n'.format(model.config.get_config_value('ClockPeriod')))
+        f.write('variable reset_state\n')
+        f.write('set reset_state {}\n'.format(int(self._has_state(model))))
         if self.vivado_accelerator_config.get_interface() == 'axi_stream':
             in_bit, out_bit = self.vivado_accelerator_config.get_io_bitwidth()
             f.write('set bit_width_hls_output {}\n'.format(in_bit))
@@ -10,6 +10,7 @@ from collections import OrderedDict
 
 from hls4ml.writer.writers import Writer
 from hls4ml.backends import get_backend
+from hls4ml.model.layers import Dense, Conv1D, Conv2D, SeparableConv1D, SeparableConv2D, SimpleRNN, LSTM, GRU
 
 config_filename = 'hls4ml_config.yml'
 
@@ -95,6 +96,104 @@ class VivadoWriter(Writer):
         elif mode == 'stream':
             return '#pragma HLS STREAM variable={name} depth={depth}'.format(name=variable.name, depth=depth)
 
+    def _get_load_weights_cpp(self, model, indent):
+        load_weights = ''
+        for layer in model.get_layers():
+            for w in layer.get_weights():
+                if w.weight_class == 'CompressedWeightVariable':
+                    load_weights += indent + 'nnet::load_compressed_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.nonzeros, w.name, w.name)
+                elif w.weight_class == 'ExponentWeightVariable':
+                    load_weights += indent + 'nnet::load_exponent_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+                elif w.weight_class == 'CodebookWeightVariable':
+                    load_weights += indent + 'nnet::load_codebook_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+                else:
+                    load_weights += indent + 'nnet::load_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+        return load_weights
+
+    @staticmethod
+    def _get_timing_params(layer):
+        """
+        Parameters of a layer in the timing model of the dataflow design: initiation interval, pipeline depth and the number
+        of input tokens consumed per iteration. These are estimates; the kernels with weights are pipelined with an II equal
+        to the reuse factor, and the depth of their pipeline grows with the reuse factor and the depth of the adder tree.
+        """
+        ii = 1
+        depth = 1
+        tokens_per_iteration = 1
+        weights = layer.weights.get('weight', None)
+        if weights is not None and isinstance(layer, (Dense, Conv1D, Conv2D, SeparableConv1D, SeparableConv2D, SimpleRNN, LSTM, GRU)):
+            ii = layer.get_attr('reuse_factor', 1)
+            bias = layer.weights.get('bias', None)
+            n_terms = weights.data_length // bias.data_length if bias is not None and bias.data_length > 0 else weights.data_length
+            depth = ii + int(np.ceil(np.log2(max(n_terms, 2)))) + 1
+            if layer.get_attr('skip_zeros', False):
+                # The number of cycles spent in the product depends on the data, the kernel reports it with busy()
+                ii = 1
+                depth = int(np.ceil(np.log2(max(n_terms, 2)))) + 2
+        if isinstance(layer, Dense):
+            # The whole input is read before the product is computed
+            in_var = layer.get_input_variable()
+            in_type = in_var.type
+            token_size = in_type.n_elem // in_type.n_pack if in_type.unpack else in_type.n_elem * in_type.n_pack
+            tokens_per_iteration = max(in_var.size() // token_size, 1)
+            if tokens_per_iteration > 1 and not layer.get_attr('skip_zeros', False) and not layer.get_attr('shift_add', False):
+                # The product is accumulated as the input is read (dense_incremental), one beat every beat_ii cycles
+                beat_ii = int(np.ceil(layer.get_attr('reuse_factor', 1) / tokens_per_iteration))
+                ii = tokens_per_iteration * beat_ii
+                depth = (tokens_per_iteration - 1) * (beat_ii - 1) + beat_ii + int(np.ceil(np.log2(token_size + 1))) + 1
+        return ii, depth, tokens_per_iteration
+
+    @staticmethod
+    def _plan_arena(model):
+        """
+        Assigns the intermediate outputs of an io_parallel design to arena buffers, used instead of local arrays in C
+        simulation. An output is live from the layer producing it to the last layer using it (including the layers using it
+        through inplace variables, which have the same name). Outputs whose lifetimes don't overlap share a buffer.
+        Returns the list of outputs assigned to each buffer.
+        """
+        layers = list(model.get_layers())
+        model_vars = [v.name for v in model.get_input_variables() + model.get_output_variables()]
+
+        last_use = {}
+        for i, layer in enumerate(layers):
+            for inp in layer.inputs:
+                var = model.get_layer_output_variable(inp)
+                if var is not None:
+                    last_use[var.name] = i
+
+        def size_estimate(var):
+            width = getattr(var.type.precision, 'width', 32)
+            return var.size() * ((width + 7) // 8)
+
+        buffers = [] # (variables, size estimate, last use)
+        for i, layer in enumerate(layers):
+            for var in layer.get_variables():
+                if var.name in model_vars or var.definition_cpp() is None:
+                    continue
+                end = max(last_use.get(var.name, i), i)
+                size = size_estimate(var)
+                free = [b for b in buffers if b[2] < i]
+                if len(free) > 0:
+                    # The smallest buffer that is large enough, otherwise the largest one
+                    large_enough = [b for b in free if b[1] >= size]
+                    buffer = min(large_enough, key=lambda b: b[1]) if len(large_enough) > 0 else max(free, key=lambda b: b[1])
+                    buffer[0].append(var)
+                    buffer[1] = max(buffer[1], size)
+                    buffer[2] = end
+                else:
+                    buffers.append([[var], size, end])
+
+        return [b[0] for b in buffers]
+
+    def _has_context_port(self, model):
+        # Recurrent layers with several contexts ('Contexts') use the state of the context given to the top level function
+        return any(layer.get_attr('n_contexts', 1) > 1 for layer in model.get_layers())
+
+    def _has_state(self, model):
+        # Layers that keep state in static variables between calls (incremental inference, multi-context recurrent layers)
+        return any(layer.get_attr('incremental', False) or layer.get_attr('kv_cache', False) or layer.get_attr('n_contexts', 1) > 1
+                   for layer in model.get_layers())
+
     def write_project_cpp(self, model):
         ###################
         ## myproject.cpp
@@ -111,9 +210,25 @@ class VivadoWriter(Writer):
 
         indent = '    '
 
+        arena = []
+        if model.config.get_config_value('IOType') == 'io_parallel':
+            arena = self._plan_arena(model)
+        arena_buffer = {var.name: i for i, buffer in enumerate(arena) for var in buffer}
+
         for line in f.readlines():
             #Add headers to weights and biases
-            if 'myproject' in line:
+            if '//hls-fpga-machine-learning insert arena' in line:
+                newline = ''
+                if len(arena) > 0:
+                    newline += '#ifndef __SYNTHESIS__\n'
+                    newline += '// Outputs of the layers in C simulation; outputs that are not used at the same time share a buffer\n'
+                    for i, buffer in enumerate(arena):
+                        size = '0'
+                        for var in reversed(buffer):
+                            size = 'nnet::arena_bytes(sizeof({}) * {}, {})'.format(var.type.name, var.size_cpp(), size)
+                        newline += 'alignas(64) static unsigned char {}_arena_{}[{}];\n'.format(model.config.get_project_name(), i, size)
+                    newline += '#endif\n'
+            elif 'myproject' in line:
                 newline = line.replace('myproject', model.config.get_project_name())
             elif '//hls-fpga-machine-learning insert header' in line:
                 inputs_str = ', '.join([i.definition_cpp(as_reference=True) for i in model_inputs])
@@ -123,20 +238,15 @@ class VivadoWriter(Writer):
                 newline = ''
                 newline += indent + inputs_str + ',\n'
                 newline += indent + outputs_str
+                if self._has_context_port(model):
+                    newline += ',\n' + indent + 'unsigned context'
                 if len(model_brams) > 0:
                     newline += ',\n' + brams_str
                 newline += '\n'
 
             elif '//hls-fpga-machine-learning insert load weights' in line:
                 newline = line
-                for layer in model.get_layers():
-                    for w in layer.get_weights():
-                        if w.weight_class == 'CompressedWeightVariable':
-                            newline += indent + '    nnet::load_compressed_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.nonzeros, w.name, w.name)
-                        elif w.weight_class == 'ExponentWeightVariable':
-                            newline += indent + '    nnet::load_exponent_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
-                        else:
-                            newline += indent + '    nnet::load_weights_from_txt<{}, {}>({}, "{}.txt");\n'.format(w.type.name, w.data_length, w.name, w.name)
+                newline += self._get_load_weights_cpp(model, indent + '    ')
 
             #Add input/output type
             elif '//hls-fpga-machine-learning insert IO' in line:
@@ -151,6 +261,8 @@ class VivadoWriter(Writer):
                     for o in model_outputs: newline += indent + self._make_array_pragma(o) + '\n'
                     # TODO discussed adding a handle for setting the interface mode for individual input and output arrays (16.03.2020)
                     # Probably the handle doesn't need to be exposed to the user but should be just set in hls_model.py
+                    if self._has_context_port(model):
+                        all_inputs.append('context')
                     newline += indent + '#pragma HLS INTERFACE ap_vld port={},{} \n'.format(','.join(all_inputs), ','.join(all_outputs))
                     if model.config.model_strategy.lower() == 'resource':
                         newline += indent + '#pragma HLS DATAFLOW \n'
@@ -158,23 +270,39 @@ class VivadoWriter(Writer):
                         newline += indent + '#pragma HLS PIPELINE \n'
                 if io_type == 'io_stream':
                     newline += indent + '#pragma HLS INTERFACE axis port={},{} \n'.format(','.join(all_inputs), ','.join(all_outputs))
+                    if self._has_context_port(model):
+                        newline += indent + '#pragma HLS INTERFACE ap_none port=context \n'
                     if all_brams:
                         newline += indent + '#pragma HLS INTERFACE bram port={} \n'.format(','.join(all_brams))
                     newline += indent + '#pragma HLS DATAFLOW \n'
 
             elif '//hls-fpga-machine-learning insert layers' in line:
                 newline = line + '\n'
+                timing_model = model.config.timing_model and model.config.get_config_value('IOType') == 'io_stream'
                 for layer in model.get_layers():
                     vars = layer.get_variables()
                     for var in vars:
                         if var not in model_inputs and var not in model_outputs:
                             def_cpp = var.definition_cpp()
-                            if def_cpp is not None:
+                            if def_cpp is not None and var.name in arena_buffer:
+                                newline += '#ifndef __SYNTHESIS__\n'
+                                newline += '    {type} (&{name})[{size}] = nnet::arena_array<{type}, {size}>({project}_arena_{buffer});\n'.format(
+                                    type=var.type.name, name=var.name, size=var.size_cpp(), project=model.config.get_project_name(), buffer=arena_buffer[var.name])
+                                newline += '#else\n'
+                                newline += '    ' + def_cpp + ';\n'
+                                if var.pragma:
+                                    newline += '    ' + self._make_array_pragma(var) + '\n'
+                                newline += '#endif\n'
+                            elif def_cpp is not None:
                                 newline += '    ' + def_cpp + ';\n'
                                 if var.pragma:
                                     newline += '    ' + self._make_array_pragma(var) + '\n'
                     func = layer.get_attr('function_cpp', None)
                     if func:
+                        if timing_model:
+                            newline += '#ifndef __SYNTHESIS__\n'
+                            newline += '    hls::timing::begin_process("{}", {}, {}, {});\n'.format(layer.name, *self._get_timing_params(layer))
+                            newline += '#endif\n'
                         func = [func]
                         if len(func) == 1:
                             newline += '    ' + func[0] + ' // ' + layer.name + '\n'
@@ -188,6 +316,10 @@ class VivadoWriter(Writer):
                                 newline += '    nnet::save_layer_output<{}>({}, "{}", {});\n'.format(var.type.name, var.name, layer.name, var.size_cpp())
                             newline += '#endif\n'
                         newline += '\n'
+                if timing_model:
+                    newline += '#ifndef __SYNTHESIS__\n'
+                    newline += '    hls::timing::end_process();\n'
+                    newline += '#endif\n'
 
             #Just copy line
             else:
@@ -227,6 +359,8 @@ class VivadoWriter(Writer):
                 newline = ''
                 newline += indent + inputs_str + ',\n'
                 newline += indent + outputs_str
+                if self._has_context_port(model):
+                    newline += ',\n' + indent + 'unsigned context'
                 if len(model_brams) > 0:
                     newline += ',\n' + brams_str
                 newline += '\n'
@@ -397,8 +531,10 @@ class VivadoWriter(Writer):
                 output_vars = ','.join([o.name for o in model_outputs])
                 bram_vars   =','.join([b.name for b in model_brams])
 
+                context_var = '0' if self._has_context_port(model) else None
+
                 # Concatenate the input, output, and bram variables. Filter out empty/null values
-                all_vars = ','.join(filter(None, [input_vars, output_vars, bram_vars]))
+                all_vars = ','.join(filter(None, [input_vars, output_vars, context_var, bram_vars]))
 
                 top_level = indent + '{}({});\n'.format(model.config.get_project_name(), all_vars)
 
@@ -473,9 +609,10 @@ class VivadoWriter(Writer):
                 input_vars = ','.join([i.name + '_ap' for i in model_inputs])
                 bram_vars   =','.join([b.name for b in model_brams])
                 output_vars = ','.join([o.name + '_ap' for o in model_outputs])
+                context_var = 'recurrent_context' if self._has_context_port(model) else None
 
                 # Concatenate the input, output, and bram variables. Filter out empty/null values
-                all_vars = ','.join(filter(None, [input_vars, output_vars, bram_vars]))
+                all_vars = ','.join(filter(None, [input_vars, output_vars, context_var, bram_vars]))
 
                 top_level = indent + '{}({});\n'.format(model.config.get_project_name(), all_vars)
                 newline += top_level
@@ -484,6 +621,38 @@ class VivadoWriter(Writer):
 
                 for o in model_outputs:
                     newline += indent + 'nnet::convert_data<{}, {}, {}>({}_ap, {});\n'.format(o.type.name, dtype, o.size_cpp(), o.name, o.name)
+            elif '//hls-fpga-machine-learning insert weights declarations' in line:
+                newline = line
+                for w in model.get_weight_variables():
+                    if w.storage.lower() != 'bram':
+                        newline += 'extern ' + w.definition_cpp() + ';\n'
+
+            elif '//hls-fpga-machine-learning insert load weights' in line:
+                newline = self._get_load_weights_cpp(model, indent + indent)
+
+            elif '//hls-fpga-machine-learning insert set weights' in line:
+                newline = ''
+                for layer in model.get_layers():
+                    weights = list(layer.get_weights())
+                    # Only arrays of plain values can be replaced; the layout of compressed, exponent and codebook weights depends on the values
+                    if len(weights) == 0 or any(w.weight_class != 'WeightVariable' for w in weights):
+                        continue
+                    newline += indent + indent + 'case {}:\n'.format(layer.index)
+                    for w in weights:
+                        newline += indent + indent + indent + 'offset += nnet::copy_weights_from_buffer<{}, {}>({}, (const char *) data + offset * element_size, element_size);\n'.format(w.type.name, w.data_length, w.name)
+                    newline += indent + indent + indent + 'break;\n'
+
+            elif '//hls-fpga-machine-learning insert fifo depths' in line:
+                newline = ''
+                fifos = OrderedDict()
+                for layer in model.get_layers():
+                    for var in layer.get_variables():
+                        if var in model_inputs or var in model_outputs or not isinstance(var.pragma, tuple) or var.pragma[0] != 'stream':
+                            continue
+                        fifos[var.name] = var.pragma[1]
+                for name, depth in fifos.items():
+                    newline += indent + 'hls::timing::set_fifo_depth("{}", {});\n'.format(name, depth)
+
             elif '//hls-fpga-machine-learning insert trace_outputs' in line:
                 newline = ''
                 for layer in model.get_layers():
@@ -516,6 +685,8 @@ class VivadoWriter(Writer):
         f.write('set part "{}"\n'.format(model.config.get_config_value('Part')))
         f.write('variable clock_period\n')
         f.write('set clock_period {}\n'.format(model.config.get_config_value('ClockPeriod')))
+        f.write('variable reset_state\n')
+        f.write('set reset_state {}\n'.format(int(self._has_state(model))))
         f.close()
 
         ###################
@@ -549,6 +720,10 @@ class VivadoWriter(Writer):
         f.close()
         fout.close()
 
+        srcpath = os.path.join(filedir,'../templates/build_pch.sh')
+        dstpath = '{}/build_pch.sh'.format(model.config.get_output_dir())
+        copyfile(srcpath, dstpath)
+
     def write_nnet_utils(self, model):
         ###################
         ## nnet_utils
@@ -0,0 +1,264 @@
+import pytest
+import shutil
+import subprocess
+from pathlib import Path
+
+test_root_path = Path(__file__).parent
+ac_types_path = test_root_path.parent.parent / 'hls4ml/templates/quartus/ac_types'
+
+# Exercises conversions (all quantization and overflow modes), arithmetic, bit access and conversions to C types,
+# printing every result bit-by-bit, so the output of the reference and the fast ac_types can be compared exactly
+test_source = r'''
+#include <cstdio>
+#ifdef HLS4ML_FAST_AC_TYPES
+#include "ac_fast.h"
+#else
+#include "ac_int.h"
+#include "ac_fixed.h"
+#endif
+
+template<class T>
+void dump(const char *name, const T &x) {
+    printf("%s", name);
+    for (int i = 0; i < (T::width + 31) / 32; i++) printf(" %08x", x.template slc<32>(32 * i).to_uint());
+    printf("\n");
+}
+
+#define DUMP(x) dump(#x, x)
+
+static const double values[] = {
+    0, 1, -1, 0.5, -0.5, 0.375, -0.375, 0.625, -0.625, 1.5, -1.5, 2.5, -2.5, 3.1415926, -3.1415926, 100.123, -100.123,
+    127.99, -127.99, 128, -128, 129.5, -129.5, 1000.0009, -1000.0009, 1e-7, -1e-7, 1e6, -1e6, 1e30, -1e30, 1e45, -1e45,
+    0.000244140625, -0.000244140625, 7.99609375, -7.99609375, 255.5, 4096.25, -4096.25
+};
+static const int n_values = sizeof(values) / sizeof(values[0]);
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+struct from_double {
+    static void run(const char *name) {
+        for (int k = 0; k < n_values; k++) {
+            ac_fixed<W, I, S, Q, O> x = values[k];
+            printf("%s %d", name, k);
+            DUMP(x);
+            printf("%s %d %.17g %d %d %d\n", name, k, x.to_double(), x.to_int(), x > values[k], x == values[k]);
+        }
+    }
+};
+
+template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, class T>
+void convert(const char *name, const T *src, int n) {
+    for (int k = 0; k < n; k++) {
+        ac_fixed<W, I, S, Q, O> x = src[k];
+        printf("%s %d", name, k);
+        DUMP(x);
+    }
+}
+
+#define CONVERT_O(SW, SI, SS, W, I, S, Q) \
+    convert<W, I, S, Q, AC_WRAP>("cvt<" #SW "," #SI "," #SS "> -> <" #W "," #I "," #S "," #Q ",WRAP>", src_##SW##_##SI, n_values); \
+    convert<W, I, S, Q, AC_SAT>("cvt<" #SW "," #SI "," #SS "> -> <" #W "," #I "," #S "," #Q ",SAT>", src_##SW##_##SI, n_values); \
+    convert<W, I, S, Q, AC_SAT_ZERO>("cvt<" #SW "," #SI "," #SS "> -> <" #W "," #I "," #S "," #Q ",SAT_ZERO>", src_##SW##_##SI, n_values); \
+    convert<W, I, S, Q, AC_SAT_SYM>("cvt<" #SW "," #SI "," #SS "> -> <" #W "," #I "," #S "," #Q ",SAT_SYM>", src_##SW##_##SI, n_values);
+
+#define CONVERT_Q(SW, SI, SS, W, I, S) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_TRN) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_RND) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_TRN_ZERO) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_RND_ZERO) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_RND_INF) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_RND_MIN_INF) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_RND_CONV) \
+    CONVERT_O(SW, SI, SS, W, I, S, AC_RND_CONV_ODD)
+
+#define CONVERT_ALL(SW, SI, SS) \
+    CONVERT_Q(SW, SI, SS, 8, 3, true) \
+    CONVERT_Q(SW, SI, SS, 8, 3, false) \
+    CONVERT_Q(SW, SI, SS, 6, 8, true) \
+    CONVERT_Q(SW, SI, SS, 10, -2, true) \
+    CONVERT_Q(SW, SI, SS, 1, 1, true) \
+    CONVERT_Q(SW, SI, SS, 1, 0, false) \
+    CONVERT_Q(SW, SI, SS, 24, 12, true) \
+    CONVERT_Q(SW, SI, SS, 50, 20, false) \
+    CONVERT_Q(SW, SI, SS, 90, 40, true)
+
+#define FROM_DOUBLE_O(W, I, S, Q) \
+    from_double<W, I, S, Q, AC_WRAP>::run("dbl<" #W "," #I "," #S "," #Q ",WRAP>"); \
+    from_double<W, I, S, Q, AC_SAT>::run("dbl<" #W "," #I "," #S "," #Q ",SAT>"); \
+    from_double<W, I, S, Q, AC_SAT_ZERO>::run("dbl<" #W "," #I "," #S "," #Q ",SAT_ZERO>"); \
+    from_double<W, I, S, Q, AC_SAT_SYM>::run("dbl<" #W "," #I "," #S "," #Q ",SAT_SYM>");
+
+#define FROM_DOUBLE(W, I, S) \
+    FROM_DOUBLE_O(W, I, S, AC_TRN) \
+    FROM_DOUBLE_O(W, I, S, AC_RND) \
+    FROM_DOUBLE_O(W, I, S, AC_TRN_ZERO) \
+    FROM_DOUBLE_O(W, I, S, AC_RND_ZERO) \
+    FROM_DOUBLE_O(W, I, S, AC_RND_INF) \
+    FROM_DOUBLE_O(W, I, S, AC_RND_MIN_INF) \
+    FROM_DOUBLE_O(W, I, S, AC_RND_CONV) \
+    FROM_DOUBLE_O(W, I, S, AC_RND_CONV_ODD)
+
+template<class T1, class T2>
+void binary_ops(const char *name, const T1 &a, const T2 &b) {
+    printf("%s\n", name);
+    DUMP(a * b);
+    DUMP(a + b);
+    DUMP(a - b);
+    DUMP(a & b);
+    DUMP(a | b);
+    DUMP(a ^ b);
+    if (b != 0) DUMP(a / b);
+    printf("rel %d %d %d %d %d %d\n", a == b, a != b, a < b, a <= b, a > b, a >= b);
+}
+
+template<class T>
+void unary_ops(const char *name, T a) {
+    printf("%s\n", name);
+    DUMP(-a);
+    DUMP(~a);
+    DUMP(a.bit_complement());
+    printf("not %d\n", !a);
+    a++;
+    DUMP(a);
+    --a;
+    --a;
+    DUMP(a);
+    DUMP(a.to_ac_int());
+    printf("int %d %u %lld %.17g\n", a.to_int(), a.to_uint(), a.to_int64(), a.to_double());
+}
+
+template<class T>
+void int_ops(const char *name, const T &a) {
+    printf("%s\n", name);
+    DUMP(a * 3);
+    DUMP(a + 7);
+    DUMP(a - 100000);
+    DUMP(a / 3);
+    DUMP(a / -7);
+    DUMP(3 * a);
+    DUMP(-5 - a);
+    DUMP(a & 0x5a5a);
+    DUMP(a >> 3);
+    DUMP(a << 2);
+    DUMP(a >> -2);
+    DUMP(a << 70);
+    DUMP(a >> 70);
+    printf("rel %d %d %d %d\n", a > 2, a < -3, 5 >= a, a == 0);
+    T b = a;
+    b += 1;
+    DUMP(b);
+    b *= -3;
+    DUMP(b);
+    b -= 100;
+    DUMP(b);
+    b /= 7;
+    DUMP(b);
+    b >>= 1;
+    DUMP(b);
+    b <<= 3;
+    DUMP(b);
+}
+
+int main() {
+    // Conversions between ac_fixed types
+    ac_fixed<18, 8, true> src_18_8[n_values];
+    ac_fixed<40, 16, true> src_40_16[n_values];
+    ac_fixed<12, 4, false> src_12_4[n_values];
+    ac_fixed<70, 30, true> src_70_30[n_values];
+    for (int k = 0; k < n_values; k++) {
+        src_18_8[k] = values[k];
+        src_40_16[k] = values[k];
+        src_12_4[k] = values[k];
+        src_70_30[k] = values[k];
+    }
+    CONVERT_ALL(18, 8, true)
+    CONVERT_ALL(40, 16, true)
+    CONVERT_ALL(12, 4, false)
+    CONVERT_ALL(70, 30, true)
+
+    // Conversions from double
+    FROM_DOUBLE(8, 3, true)
+    FROM_DOUBLE(8, 3, false)
+    FROM_DOUBLE(16, 6, true)
+    FROM_DOUBLE(1, 1, true)
+    FROM_DOUBLE(40, 20, true)
+    FROM_DOUBLE(64, 32, false)
+    FROM_DOUBLE(100, 60, true)
+
+    // Arithmetic
+    for (int k = 0; k < n_values; k++) {
+        for (int l = 0; l < n_values; l += 3) {
+            binary_ops("fx18x16", src_18_8[k], ac_fixed<16, 6, true>(values[l]));
+            binary_ops("fx12x40", src_12_4[k], src_40_16[l]);
+            binary_ops("fx70x40", src_70_30[k], src_40_16[l]);
+            binary_ops("fx40xint", src_40_16[k], ac_int<10, false>(values[l]));
+            binary_ops("intx12", ac_int<24, true>(values[l]), src_12_4[k]);
+        }
+        unary_ops("un18", src_18_8[k]);
+        unary_ops("un12", src_12_4[k]);
+        unary_ops("un70", src_70_30[k]);
+        int_ops("int18", src_18_8[k]);
+        int_ops("int12", src_12_4[k]);
+        int_ops("int40", src_40_16[k]);
+    }
+
+    // ac_int
+    for (int k = 0; k < n_values; k++) {
+        ac_int<20, true> a = values[k];
+        ac_int<33, false> b = values[k] * 77;
+        ac_int<64, true> c = values[k] * 1e12;
+        ac_int<100, true> d = c * c;
+        ac_int<7, true> e = k - 20;
+        DUMP(a); DUMP(b); DUMP(c); DUMP(d);
+        DUMP(a * b); DUMP(a + b); DUMP(a - b); DUMP(b - a); DUMP(c * a); DUMP(d + c);
+        if (a != 0) { DUMP(b / a); DUMP(b % a); DUMP(d / a); DUMP(d % a); DUMP(c / a); }
+        if (b != 0) { DUMP(a / b); DUMP(a % b); }
+        DUMP(a << e); DUMP(a >> e); DUMP(d << e); DUMP(d >> e); DUMP((b << ac_int<5, false>(k))); DUMP((b >> ac_int<5, false>(k)));
+        DUMP(-a); DUMP(~b); DUMP(b.bit_complement()); DUMP(a & b); DUMP(a | b); DUMP(a ^ d);
+        DUMP(a * 3); DUMP(b + 1u); DUMP(a % 7); DUMP(100 / (a | 1)); DUMP(a << 3); DUMP(b >> 5);
+        printf("rel %d %d %d %d %d\n", a < b, d > c, a == e, a < 0, b >= 5u);
+        printf("conv %d %u %lld %llu %.17g %.17g %.17g\n", a.to_int(), b.to_uint(), c.to_int64(), b.to_uint64(), a.to_double(), c.to_double(), d.to_double());
+        printf("idx %lld %llu\n", (long long) a, (unsigned long long) b);
+        ac_int<20, true> f = a;
+        f += 5; f *= b; f -= 3; f /= 2; f %= 1000; f <<= 2; f >>= 1; f &= 0x3ff0; f |= 3; f ^= 0x55;
+        DUMP(f);
+        f++; f--; --f;
+        DUMP(f);
+        DUMP(d.slc<37>(11)); DUMP(a.slc<4>(3)); DUMP(b.slc<16>(20));
+        d.set_slc(30, b); DUMP(d);
+        a.set_slc(2, ac_int<5, false>(k)); DUMP(a);
+        a[19] = 1; a[0] = 0; DUMP(a);
+        b[32] = k & 1; DUMP(b);
+        printf("bits %d %d %d\n", (bool) a[19], (bool) b[0], (bool) d[99]);
+    }
+
+    // ac_fixed bit and slice access
+    for (int k = 0; k < n_values; k++) {
+        ac_fixed<18, 8, true> x = src_18_8[k];
+        ac_fixed<70, 30, true> y = src_70_30[k];
+        DUMP(x.slc<5>(3)); DUMP(y.slc<40>(20)); DUMP(y.slc<8>(65));
+        x[x.width - 1] = 1; DUMP(x);
+        x.set_slc(4, ac_int<6, true>(k - 20)); DUMP(x);
+        y.set_slc(40, ac_int<20, false>(k * 12345)); DUMP(y);
+        printf("bits %d %d\n", (bool) x[17], (bool) y[3]);
+        printf("dbl %.17g %.17g %.17g\n", x.to_double(), y.to_double(), src_40_16[k].to_double());
+    }
+
+    return 0;
+}
+'''
+
+def run_test_program(build_dir, name, flags=[]):
+    binary = str(build_dir / name)
+    cmd = ['g++', '-std=c++11', '-O1', '-I' + str(ac_types_path), str(build_dir / 'test_ac_types.cpp'), '-o', binary] + flags
+    subprocess.run(cmd, check=True)
+    return subprocess.run([binary], check=True, capture_output=True, text=True).stdout.splitlines()
+
+@pytest.mark.skipif(shutil.which('g++') is None, reason='Requires g++')
+def test_ac_fast_types(tmp_path):
+    (tmp_path / 'test_ac_types.cpp').write_text(test_source)
+    ref = run_test_program(tmp_path, 'ref')
+    fast = run_test_program(tmp_path, 'fast', ['-DHLS4ML_FAST_AC_TYPES'])
+
+    assert len(ref) == len(fast)
+    mismatches = [(r, f) for r, f in zip(ref, fast) if r != f]
+    assert mismatches == []
@@ -0,0 +1,39 @@
+import pytest
+import hls4ml
+import numpy as np
+import re
+from pathlib import Path
+from tensorflow.keras.models import Model
+from tensorflow.keras.layers import Input, Dense, Activation, Add
+
+test_root_path = Path(__file__).parent
+
+def test_arena():
+    # In C simulation of io_parallel designs, outputs of the layers that are not used at the same time share a buffer
+    inp = Input(shape=(8,))
+    x1 = Dense(8, name='fc1')(inp)
+    x = Activation('relu', name='relu1')(x1)
+    x = Dense(8, name='fc2')(x)
+    x = Activation('relu', name='relu2')(x)
+    x = Dense(8, name='fc3')(x)
+    x = Add(name='add')([x1, x])
+    out = Dense(3, name='fc4')(x)
+    model = Model(inputs=inp, outputs=out)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>')
+    output_dir = str(test_root_path / 'hls4mlprj_arena')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_parallel', output_dir=output_dir)
+    hls_model.compile()
+
+    with open(output_dir + '/firmware/myproject.cpp') as f:
+        src = f.read()
+    buffers = dict(re.findall(r'\(&(\w+)\)\[.*?\] = nnet::arena_array<.*?>\((myproject_arena_\d+)\)', src))
+    # fc1 is used by the last layer, so it has its own buffer; the other outputs alternate between two buffers
+    assert len(buffers) == 6
+    assert len(set(buffers.values())) == 3
+    fc1_buffer = buffers.pop(hls_model.graph['fc1'].get_output_variable().name)
+    assert fc1_buffer not in buffers.values()
+
+    X = np.random.rand(100, 8)
+    np.testing.assert_allclose(hls_model.predict(X), model.predict(X), rtol=0, atol=0.05)
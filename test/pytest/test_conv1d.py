@@ -25,6 +25,7 @@ def keras_model():
 @pytest.fixture   
 @pytest.mark.parametrize('backend, io_type, strategy', [
                                       ('Quartus', 'io_parallel', 'resource'),
+                                      ('Quartus', 'io_stream', 'resource'),
                                       ('Vivado', 'io_parallel', 'resource'),
 
                                       ('Vivado', 'io_parallel', 'latency'),
@@ -58,6 +59,7 @@ def hls_model(keras_model, backend, io_type, strategy):
 
 @pytest.mark.parametrize('backend, io_type, strategy', [
                                       ('Quartus', 'io_parallel', 'resource'),
+                                      ('Quartus', 'io_stream', 'resource'),
                                       ('Vivado', 'io_parallel', 'resource'),
 
                                       ('Vivado', 'io_parallel', 'latency'),
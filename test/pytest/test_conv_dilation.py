@@ -0,0 +1,78 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Conv1D, Conv2D
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('io_type,implementation', [
+    ('io_parallel', 'LineBuffer'),
+    ('io_stream', 'LineBuffer'),
+    ('io_stream', 'Encoded'),
+])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('padding', ['same', 'valid'])
+def test_conv1d_dilation(io_type, implementation, strategy, padding):
+    # A stack of dilated causal-like layers, as found in temporal convolutional networks
+    model = Sequential()
+    model.add(Conv1D(4, kernel_size=3, dilation_rate=2, padding=padding, input_shape=(32, 2), name='conv1'))
+    model.add(Conv1D(3, kernel_size=3, dilation_rate=4, padding=padding, name='conv2'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = strategy
+    config['Model']['ConvImplementation'] = implementation
+    output_dir = str(test_root_path / 'hls4mlprj_conv1d_dilation_{}_{}_{}_{}'.format(io_type, implementation, strategy, padding))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    hls_model.compile()
+
+    # The dilated kernel keeps the multiplications of the undilated one
+    assert hls_model.graph['conv2'].get_weights('weight').data.size == 3 * 4 * 3
+
+    X = np.random.rand(20, 32, 2)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
+
+@pytest.mark.parametrize('io_type,implementation', [
+    ('io_parallel', 'LineBuffer'),
+    ('io_stream', 'LineBuffer'),
+    ('io_stream', 'Encoded'),
+])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('padding', ['same', 'valid'])
+def test_conv2d_dilation(io_type, implementation, strategy, padding):
+    model = Sequential()
+    model.add(Conv2D(2, kernel_size=(3, 3), dilation_rate=(2, 3), padding=padding, input_shape=(14, 16, 2), name='conv1'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = strategy
+    config['Model']['ConvImplementation'] = implementation
+    output_dir = str(test_root_path / 'hls4mlprj_conv2d_dilation_{}_{}_{}_{}'.format(io_type, implementation, strategy, padding))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    hls_model.compile()
+
+    X = np.random.rand(20, 14, 16, 2)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
+
+@pytest.mark.parametrize('padding', ['same', 'valid'])
+def test_conv2d_dilation_quartus(padding):
+    # The square 3x3 kernel would otherwise map to Winograd, which only handles contiguous kernels
+    model = Sequential()
+    model.add(Conv2D(2, kernel_size=(3, 3), dilation_rate=(2, 3), padding=padding, input_shape=(14, 16, 2), name='conv1'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ac_fixed<24,10,true>')
+    output_dir = str(test_root_path / 'hls4mlprj_conv2d_dilation_quartus_{}'.format(padding))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_parallel', backend='Quartus', output_dir=output_dir)
+    hls_model.compile()
+
+    X = np.random.rand(20, 14, 16, 2)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
@@ -0,0 +1,50 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Conv1DTranspose, Conv2DTranspose
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('padding', ['same', 'valid'])
+def test_conv1d_transpose(io_type, strategy, padding):
+    model = Sequential()
+    model.add(Conv1DTranspose(3, kernel_size=5, strides=2, padding=padding, input_shape=(8, 2), name='tconv'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = strategy
+    output_dir = str(test_root_path / 'hls4mlprj_conv1d_transpose_{}_{}_{}'.format(io_type, strategy, padding))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    hls_model.compile()
+
+    X = np.random.rand(20, 8, 2)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('padding', ['same', 'valid'])
+def test_conv2d_transpose(io_type, strategy, padding):
+    # Kernel sizes that are not multiples of the strides leave zero taps in some of the phases
+    model = Sequential()
+    model.add(Conv2DTranspose(2, kernel_size=(3, 4), strides=(2, 3), padding=padding, input_shape=(5, 4, 3), name='tconv'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = strategy
+    output_dir = str(test_root_path / 'hls4mlprj_conv2d_transpose_{}_{}_{}'.format(io_type, strategy, padding))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    hls_model.compile()
+
+    # One multiplication of a window of ceil(k / s) inputs per spatial dimension computes all stride phases
+    assert hls_model.graph['tconv'].get_weights('weight').data.size == 2 * 2 * 3 * (2 * 3) * 2
+
+    X = np.random.rand(20, 5, 4, 3)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
@@ -0,0 +1,32 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Conv2D, Flatten, Dense
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('reuse_factor', [1, 4, 16, 48])
+def test_dense_incremental(strategy, reuse_factor):
+    # The dense layer reads the flattened image one pixel at a time and accumulates its product as the pixels arrive
+    model = Sequential()
+    model.add(Conv2D(3, kernel_size=(3, 3), input_shape=(6, 6, 2), name='conv1'))
+    model.add(Flatten(name='flatten'))
+    model.add(Dense(5, name='fc1'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = 'Resource'
+    config['LayerName']['fc1']['Strategy'] = strategy
+    config['LayerName']['fc1']['ReuseFactor'] = reuse_factor
+    config['LayerName']['fc1']['ShiftAdd'] = False
+    output_dir = str(test_root_path / 'hls4mlprj_dense_incremental_{}_rf{}'.format(strategy, reuse_factor))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+    hls_model.compile()
+
+    X = np.random.rand(20, 6, 6, 2)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.05)
@@ -0,0 +1,84 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential, Model
+from tensorflow.keras.layers import Input, Conv1D, MaxPooling1D, Activation, LSTM, MultiHeadAttention
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('step', [2, 4])
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+def test_incremental_conv1d(step, strategy):
+    window = 20
+    model = Sequential()
+    model.add(Conv1D(4, kernel_size=3, input_shape=(window, 3), name='conv1'))
+    model.add(Activation('relu', name='relu1'))
+    model.add(MaxPooling1D(pool_size=2, name='pool1'))
+    model.add(Conv1D(2, kernel_size=3, name='conv2'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = strategy
+    config['Model']['IncrementalStep'] = step
+    output_dir = str(test_root_path / 'hls4mlprj_incremental_conv1d_{}_{}'.format(step, strategy))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+    hls_model.compile()
+
+    # The reset of the synthesized design clears the state kept between calls
+    with open(output_dir + '/project.tcl') as f:
+        assert 'set reset_state 1\n' in f.readlines()
+
+    # Each call reads the next step samples of the series (a multiple of the stride of the pooling layer)
+    n_calls = window // step + 10
+    series = np.random.rand(n_calls * step, 3)
+    hls_model.reset_state()
+    y_hls = hls_model.predict(series.reshape(n_calls, step, 3)).reshape(n_calls, -1, 2)
+
+    # After the window is filled, the outputs are the newest outputs of the model over the window
+    windows = np.stack([series[end - window:end] for end in range(window, n_calls * step + 1, step)])
+    y_keras = model.predict(windows)[:, -y_hls.shape[1]:]
+    np.testing.assert_allclose(y_hls[-len(windows):], y_keras, rtol=0, atol=0.02)
+
+@pytest.mark.parametrize('step', [1, 3])
+def test_incremental_lstm(step):
+    # The recurrent state is kept between calls, the calls process the whole series
+    model = Sequential()
+    model.add(LSTM(4, input_shape=(12, 3), return_sequences=True, name='lstm1'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,8>')
+    config['Model']['IncrementalStep'] = step
+    output_dir = str(test_root_path / 'hls4mlprj_incremental_lstm_{}'.format(step))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+    hls_model.compile()
+
+    X = np.random.rand(12, 3)
+    y_keras = model.predict(X[np.newaxis])[0]
+    hls_model.reset_state()
+    y_hls = hls_model.predict(X.reshape(12 // step, step, 3)).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
+
+@pytest.mark.parametrize('step', [1, 2])
+def test_incremental_mha(step):
+    # The keys and values of the window are cached, each call only computes the attention of the new tokens
+    window = 8
+    inp = Input(shape=(window, 4), name='input1')
+    out = MultiHeadAttention(num_heads=2, key_dim=3, name='mha1')(inp, inp)
+    model = Model(inputs=inp, outputs=out)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,8>')
+    config['Model']['IncrementalStep'] = step
+    output_dir = str(test_root_path / 'hls4mlprj_incremental_mha_{}'.format(step))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_parallel', output_dir=output_dir)
+    hls_model.compile()
+
+    n_calls = window // step + 6
+    series = np.random.rand(n_calls * step, 4)
+    hls_model.reset_state()
+    y_hls = hls_model.predict(series.reshape(n_calls, step, 4)).reshape(n_calls, step, 4)
+
+    windows = np.stack([series[end - window:end] for end in range(window, n_calls * step + 1, step)])
+    y_keras = model.predict(windows)[:, -step:]
+    np.testing.assert_allclose(y_hls[-len(windows):], y_keras, rtol=0, atol=0.05)
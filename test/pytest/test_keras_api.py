@@ -152,7 +152,8 @@ padds_options=['same', 'valid']
 @pytest.mark.parametrize('chans', chans_options)
 @pytest.mark.parametrize('padds',  padds_options)
 @pytest.mark.parametrize('backend', ['Vivado', 'Quartus'])
-def test_conv2d(chans, padds, backend):
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_conv2d(chans, padds, backend, io_type):
     model = tf.keras.models.Sequential()
     input_shape = (28,28,3)
     model.add(Conv2D(filters=32,
@@ -169,8 +170,8 @@ def test_conv2d(chans, padds, backend):
     keras_prediction = model.predict(X_input)
     
     config = hls4ml.utils.config_from_keras_model(model)
-    output_dir = str(test_root_path / 'hls4mlprj_keras_api_conv2d_{}_{}_{}'.format(backend, chans, padds))
-    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, backend=backend)
+    output_dir = str(test_root_path / 'hls4mlprj_keras_api_conv2d_{}_{}_{}_{}'.format(backend, chans, padds, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir, backend=backend, io_type=io_type)
     hls_model.compile()
     hls_prediction = hls_model.predict(X_input).reshape(keras_prediction.shape)
 
@@ -1,5 +1,6 @@
 import pytest
 import hls4ml
+from hls4ml.model.types import CodebookType
 import numpy as np
 from pathlib import Path
 from tensorflow.keras.utils import to_categorical
@@ -9,7 +10,7 @@ from sklearn.preprocessing import LabelEncoder, StandardScaler
 from tensorflow.keras.models import Sequential, Model, model_from_json
 from tensorflow.keras.optimizers import Adam
 from tensorflow.keras.regularizers import l1
-from tensorflow.keras.layers import Activation, BatchNormalization, Input
+from tensorflow.keras.layers import Activation, BatchNormalization, Input, Dense
 from qkeras.qlayers import QDense, QActivation
 from qkeras.quantizers import quantized_bits, quantized_relu, ternary, binary
 from qkeras.utils import _add_supported_quantized_objects; co = {}; _add_supported_quantized_objects(co)
@@ -145,6 +146,162 @@ def test_single_dense_activation_exact(randX_100_16, bits, alpha, backend, io_ty
   # For now allow matching within 1 bit
   np.testing.assert_allclose(y_qkeras.ravel(), y_hls4ml.ravel(), atol=2**-bits, rtol=1.0)
 
+@pytest.mark.parametrize('alpha', ['auto_po2', 'auto'])
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_single_dense_integer_only(randX_100_16, alpha, io_type):
+  '''
+  Test the integer-only mode, which folds the per-channel alpha scale of a QDense
+  layer into its requantization epilogue instead of a separate ApplyAlpha layer
+  '''
+  X = randX_100_16
+  bits = 8
+  model = Sequential()
+  model.add(QDense(16, input_shape=(16,), name='fc1',
+                  kernel_quantizer=quantized_bits(bits,0,alpha=alpha), bias_quantizer=quantized_bits(bits,0,alpha=1),
+                  kernel_initializer='lecun_uniform'))
+  model.add(QActivation(activation=quantized_relu(bits,0), name='relu1'))
+  model.compile()
+
+  config = hls4ml.utils.config_from_keras_model(model, granularity='name')
+  config['LayerName']['fc1']['IntegerOnly'] = True
+  output_dir = str(test_root_path / 'hls4mlprj_qkeras_single_dense_integer_only_{}_{}'.format(alpha, io_type))
+  hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                       hls_config=config,
+                                                       output_dir=output_dir,
+                                                       backend='Vivado',
+                                                       io_type=io_type)
+  hls_model.compile()
+
+  assert 'fc1_alpha' not in hls_model.graph
+  assert hls_model.graph['fc1'].get_attr('requant', False)
+
+  y_qkeras = model.predict(X)
+  y_hls4ml = hls_model.predict(X)
+  np.testing.assert_allclose(y_qkeras.ravel(), y_hls4ml.ravel(), atol=2**-(bits-2), rtol=1.0)
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_single_dense_shift_add(randX_100_16, io_type):
+  '''
+  Test that the shift-add products generated for constant weights match the multiplier products exactly
+  '''
+  X = randX_100_16
+  model = Sequential()
+  model.add(QDense(16, input_shape=(16,), name='fc1',
+                  kernel_quantizer=quantized_bits(6,0,alpha=1), bias_quantizer=quantized_bits(6,0,alpha=1),
+                  kernel_initializer='lecun_uniform'))
+  model.compile()
+
+  y_hls4ml = []
+  for shift_add in [False, True]:
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name')
+    config['LayerName']['fc1']['ShiftAdd'] = shift_add
+    output_dir = str(test_root_path / 'hls4mlprj_qkeras_single_dense_shift_add_{}_{}'.format(shift_add, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                         hls_config=config,
+                                                         output_dir=output_dir,
+                                                         backend='Vivado',
+                                                         io_type=io_type)
+    hls_model.compile()
+    assert hls_model.graph['fc1'].get_attr('shift_add', False) == shift_add
+    y_hls4ml.append(hls_model.predict(X))
+
+  np.testing.assert_array_equal(y_hls4ml[0], y_hls4ml[1])
+
+@pytest.mark.parametrize('weight_precision', ['ap_fixed<6,2>', 'ap_fixed<6,2,AP_RND,AP_SAT>', 'ap_fixed<5,1,AP_RND_CONV,AP_WRAP>',
+                                              'ap_fixed<7,3,AP_RND_ZERO,AP_SAT_SYM>'])
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_single_dense_shift_add_off_grid(randX_100_16, weight_precision, io_type):
+  '''
+  Test that the shift-add products of weights that are not representable in the weight type (and partly out of its
+  range) match the multiplier products exactly, i.e., the weights are rounded and saturated/wrapped the same way
+  '''
+  X = randX_100_16
+  model = Sequential()
+  model.add(Dense(16, input_shape=(16,), name='fc1'))
+  model.compile()
+  model.layers[0].set_weights([np.random.uniform(-3, 3, (16, 16)), np.random.uniform(-1, 1, 16)])
+
+  y_hls4ml = []
+  for shift_add in [False, True]:
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<24,10>')
+    config['LayerName']['fc1']['Precision']['weight'] = weight_precision
+    config['LayerName']['fc1']['ShiftAdd'] = shift_add
+    output_dir = str(test_root_path / 'hls4mlprj_single_dense_shift_add_off_grid_{}_{}_{}'.format(
+        weight_precision.replace('<', '_').replace('>', '').replace(',', '_'), shift_add, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                         hls_config=config,
+                                                         output_dir=output_dir,
+                                                         backend='Vivado',
+                                                         io_type=io_type)
+    hls_model.compile()
+    assert hls_model.graph['fc1'].get_attr('shift_add', False) == shift_add
+    y_hls4ml.append(hls_model.predict(X))
+
+  np.testing.assert_array_equal(y_hls4ml[0], y_hls4ml[1])
+
+@pytest.mark.parametrize('strategy,reuse_factor', [('Latency', 1), ('Resource', 1), ('Resource', 4), ('Resource', 32)])
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_single_dense_codebook(randX_100_16, strategy, reuse_factor, io_type):
+  '''
+  Test that the codebook products of weights sharing a few distinct values match the multiplier products exactly
+  '''
+  X = randX_100_16
+  model = Sequential()
+  model.add(QDense(16, input_shape=(16,), name='fc1',
+                  kernel_quantizer=quantized_bits(3,0,alpha=1), bias_quantizer=quantized_bits(6,0,alpha=1),
+                  kernel_initializer='lecun_uniform'))
+  model.compile()
+
+  y_hls4ml = []
+  for codebook in [False, True]:
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name')
+    config['Model']['Strategy'] = strategy
+    config['LayerName']['fc1']['ReuseFactor'] = reuse_factor
+    config['LayerName']['fc1']['Codebook'] = codebook
+    config['LayerName']['fc1']['ShiftAdd'] = False
+    output_dir = str(test_root_path / 'hls4mlprj_qkeras_single_dense_codebook_{}_{}_{}_{}'.format(codebook, strategy, reuse_factor, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                         hls_config=config,
+                                                         output_dir=output_dir,
+                                                         backend='Vivado',
+                                                         io_type=io_type)
+    hls_model.compile()
+    assert isinstance(hls_model.graph['fc1'].get_weights('weight').type, CodebookType) == codebook
+    y_hls4ml.append(hls_model.predict(X))
+
+  np.testing.assert_array_equal(y_hls4ml[0], y_hls4ml[1])
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_single_dense_lut_mult(randX_100_16, io_type):
+  '''
+  Test that the products of 4-bit inputs and 4-bit weights use the truth-table product and match QKeras
+  '''
+  X = randX_100_16
+  model = Sequential()
+  model.add(QActivation(activation=quantized_bits(4,0,alpha=1), input_shape=(16,), name='qinput'))
+  model.add(QDense(16, name='fc1',
+                  kernel_quantizer=quantized_bits(4,0,alpha=1), bias_quantizer=quantized_bits(4,0,alpha=1),
+                  kernel_initializer='lecun_uniform'))
+  model.compile()
+
+  config = hls4ml.utils.config_from_keras_model(model, granularity='name')
+  config['LayerName']['fc1']['ShiftAdd'] = False
+  output_dir = str(test_root_path / 'hls4mlprj_qkeras_single_dense_lut_mult_{}'.format(io_type))
+  hls_model = hls4ml.converters.convert_from_keras_model(model,
+                                                       hls_config=config,
+                                                       output_dir=output_dir,
+                                                       backend='Vivado',
+                                                       io_type=io_type)
+  hls_model.compile()
+
+  fc1 = hls_model.graph['fc1']
+  product_type = hls4ml.backends.get_backend('Vivado').product_type(fc1.get_input_variable().type.precision, fc1.get_weights('weight').type.precision)
+  assert product_type == 'lut_mult'
+
+  y_qkeras = model.predict(X)
+  y_hls4ml = hls_model.predict(X)
+  np.testing.assert_allclose(y_qkeras.ravel(), y_hls4ml.ravel(), atol=2**-4, rtol=1.0)
+
 @pytest.fixture
 def make_btnn(test_no, N, kernel_quantizer, bias_quantizer, activation_quantizer, use_batchnorm, is_xnor):
   shape = (N,)
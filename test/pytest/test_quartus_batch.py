@@ -0,0 +1,35 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Model
+from tensorflow.keras.layers import Input, Dense, Concatenate
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_quartus_batch_predict(io_type):
+    # The Quartus bridge processes all samples in one call; each row must match the prediction of that sample alone
+    in1 = Input(shape=(6,))
+    in2 = Input(shape=(4,))
+    x = Concatenate()([in1, in2])
+    out = Dense(5)(x)
+    model = Model(inputs=[in1, in2], outputs=out)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ac_fixed<18,8,true>')
+    output_dir = str(test_root_path / 'hls4mlprj_quartus_batch_{}'.format(io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, backend='Quartus', io_type=io_type, output_dir=output_dir)
+    hls_model.compile()
+
+    X1 = np.random.rand(50, 6)
+    X2 = np.random.rand(50, 4)
+    y_batch = hls_model.predict([X1, X2])
+    assert y_batch.shape == (50, 5)
+
+    for i in range(0, 50, 7):
+        y_single = hls_model.predict([np.ascontiguousarray(X1[i]), np.ascontiguousarray(X2[i])])
+        np.testing.assert_array_equal(y_single, y_batch[i])
+
+    y_keras = model.predict([X1, X2])
+    np.testing.assert_allclose(y_batch, y_keras, rtol=0, atol=0.05)
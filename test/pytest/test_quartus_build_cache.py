@@ -0,0 +1,54 @@
+import pytest
+import hls4ml
+import numpy as np
+import os
+import shutil
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense
+
+test_root_path = Path(__file__).parent
+
+def test_quartus_build_cache(monkeypatch):
+    # Layers are compiled as separate, cached translation units; a change to one layer should only recompile that layer
+    cache_dir = test_root_path / 'hls4mlprj_quartus_build_cache' / 'cache'
+    shutil.rmtree(cache_dir, ignore_errors=True)
+    monkeypatch.setenv('HLS4ML_CACHE_DIR', str(cache_dir))
+
+    model = Sequential()
+    model.add(Dense(8, input_shape=(10,), name='fc1'))
+    model.add(Dense(6, name='fc2'))
+    model.add(Dense(4, name='fc3'))
+    model.compile()
+
+    X = np.random.rand(20, 10)
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ac_fixed<18,8,true>')
+    output_dir = str(test_root_path / 'hls4mlprj_quartus_build_cache' / 'prj_a')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, backend='Quartus', output_dir=output_dir)
+    hls_model.compile()
+    y_a = hls_model.predict(X)
+
+    units = os.listdir(output_dir + '/firmware/layers')
+    assert 'fc1.cpp' in units and 'fc2.cpp' in units and 'fc3.cpp' in units
+    objects_a = set(os.listdir(cache_dir / 'objects'))
+
+    # Same model written to a different directory: every object is taken from the cache
+    output_dir = str(test_root_path / 'hls4mlprj_quartus_build_cache' / 'prj_b')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, backend='Quartus', output_dir=output_dir)
+    hls_model.compile()
+    assert set(os.listdir(cache_dir / 'objects')) == objects_a
+    # The precompiled header doesn't depend on the model, so it is shared by both projects
+    assert len(os.listdir(cache_dir / 'pch')) == 1
+    np.testing.assert_array_equal(hls_model.predict(X), y_a)
+
+    # Changing the accumulator of fc2 only rebuilds fc2, the top-level function and the bridge
+    config['LayerName']['fc2']['Precision']['accum'] = 'ac_fixed<24,10,true>'
+    output_dir = str(test_root_path / 'hls4mlprj_quartus_build_cache' / 'prj_c')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, backend='Quartus', output_dir=output_dir)
+    hls_model.compile()
+    objects_c = set(os.listdir(cache_dir / 'objects'))
+    assert len(objects_c - objects_a) == 3
+
+    y_keras = model.predict(X)
+    np.testing.assert_allclose(hls_model.predict(X), y_keras, rtol=0, atol=0.05)
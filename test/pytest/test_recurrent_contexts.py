@@ -0,0 +1,43 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import LSTM, GRU
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('backend', ['Vivado', 'VivadoAccelerator'])
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('rnn_layer', [LSTM, GRU])
+def test_recurrent_contexts(io_type, rnn_layer, backend):
+    n_contexts, n_chunks, chunk = 4, 3, 5
+
+    # The same weights over the whole series, to compute the reference
+    full_model = Sequential()
+    full_model.add(rnn_layer(4, input_shape=(n_chunks * chunk, 3), return_sequences=True, name='rnn1'))
+    full_model.compile()
+    model = Sequential()
+    model.add(rnn_layer(4, input_shape=(chunk, 3), return_sequences=True, name='rnn1'))
+    model.compile()
+    model.set_weights(full_model.get_weights())
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<24,8>')
+    config['LayerName'] = {'rnn1': {'Contexts': n_contexts}}
+    output_dir = str(test_root_path / 'hls4mlprj_recurrent_contexts_{}_{}_{}'.format(rnn_layer.__name__.lower(), io_type, backend))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir,
+                                                           backend=backend)
+    hls_model.compile()
+    hls_model.reset_state()
+
+    # Each context processes its series in chunks, the calls of the contexts are interleaved
+    X = np.random.rand(n_contexts, n_chunks * chunk, 3)
+    y_hls = np.zeros((n_contexts, n_chunks * chunk, 4))
+    for i_chunk in range(n_chunks):
+        for context in np.random.permutation(n_contexts):
+            hls_model.set_context(int(context))
+            x = X[context:context + 1, i_chunk * chunk:(i_chunk + 1) * chunk]
+            y_hls[context, i_chunk * chunk:(i_chunk + 1) * chunk] = hls_model.predict(x).reshape(chunk, 4)
+
+    y_keras = full_model.predict(X)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
@@ -65,9 +65,11 @@ def test_rnn_parsing(rnn_layer, return_sequences):
 
 @pytest.mark.parametrize('rnn_layer,backend, io_type', [
                             (SimpleRNN, 'Quartus', 'io_parallel'),
+                            (SimpleRNN, 'Quartus', 'io_stream'),
                             (LSTM, 'Vivado', 'io_parallel'),
                             (LSTM, 'Quartus', 'io_parallel'),
                             (LSTM, 'Vivado', 'io_stream'),
+                            (LSTM, 'Quartus', 'io_stream'),
                             (GRU, 'Vivado', 'io_parallel'), 
                             (GRU, 'Vivado', 'io_stream'),
                             (GRU, 'Quartus', 'io_parallel'), 
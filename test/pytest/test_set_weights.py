@@ -0,0 +1,56 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense, Activation
+
+test_root_path = Path(__file__).parent
+
+def make_model():
+    model = Sequential()
+    model.add(Dense(8, input_shape=(10,), name='fc1'))
+    model.add(Activation('relu', name='relu1'))
+    model.add(Dense(4, name='fc2'))
+    model.compile()
+    return model
+
+@pytest.mark.parametrize('strategy', ['Latency', 'Resource'])
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+def test_set_weights(strategy, io_type):
+    # Replacing the weights of a compiled model should give the same predictions as compiling a model with the new weights
+    model = make_model()
+    new_model = make_model()
+    X = np.random.rand(20, 10)
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ap_fixed<18,8>')
+    config['Model']['Strategy'] = strategy
+    config['Model']['ReuseFactor'] = 2
+    output_dir = str(test_root_path / 'hls4mlprj_set_weights_{}_{}'.format(strategy, io_type))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    hls_model.compile()
+    y_old = hls_model.predict(X)
+
+    output_dir = str(test_root_path / 'hls4mlprj_set_weights_{}_{}_ref'.format(strategy, io_type))
+    hls_new_model = hls4ml.converters.convert_from_keras_model(new_model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    hls_new_model.compile()
+    y_new = hls_new_model.predict(X)
+
+    new_weights = {layer.name: dict(zip(['kernel', 'bias'], layer.get_weights())) for layer in new_model.layers if layer.get_weights()}
+    hls_model.set_weights(new_weights)
+    np.testing.assert_array_equal(hls_model.predict(X), y_new)
+    assert not np.array_equal(y_new, y_old)
+
+def test_set_weights_shift_add():
+    # Shift-add code generation depends on the values of the weights, so they cannot be replaced without recompiling
+    model = make_model()
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<18,8>')
+    config['LayerName']['fc1']['Precision']['weight'] = 'ap_fixed<6,2>'
+    config['LayerName']['fc1']['ShiftAdd'] = True
+    output_dir = str(test_root_path / 'hls4mlprj_set_weights_shift_add')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, output_dir=output_dir)
+    hls_model.compile()
+
+    new_weights = {'fc1': {'kernel': np.random.rand(10, 8)}}
+    with pytest.raises(Exception):
+        hls_model.set_weights(new_weights)
@@ -0,0 +1,72 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense, Conv1D, Activation
+
+test_root_path = Path(__file__).parent
+
+def sparse_input(shape, zero_fraction):
+    X = np.random.rand(*shape)
+    X[np.random.rand(*shape) < zero_fraction] = 0
+    return X
+
+@pytest.mark.parametrize('reuse_factor', [1, 4, 16])
+def test_dense_skip_zeros(reuse_factor):
+    model = Sequential()
+    model.add(Dense(16, input_shape=(16,), name='fc1'))
+    model.add(Activation('relu', name='relu1'))
+    model.add(Dense(8, name='fc2'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = 'Resource'
+    config['Model']['ReuseFactor'] = reuse_factor
+    config['LayerName']['fc2']['SkipZeros'] = True
+    output_dir = str(test_root_path / 'hls4mlprj_dense_skip_zeros_rf{}'.format(reuse_factor))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+    hls_model.compile()
+
+    X = sparse_input((100, 16), 0.5)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
+
+def test_dense_skip_zeros_timing():
+    model = Sequential()
+    model.add(Dense(8, input_shape=(32,), name='fc1'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = 'Resource'
+    config['LayerName']['fc1']['ReuseFactor'] = 8
+    config['LayerName']['fc1']['SkipZeros'] = True
+    output_dir = str(test_root_path / 'hls4mlprj_dense_skip_zeros_timing')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+    hls_model.compile()
+
+    # The layer spends fewer cycles on sparser inputs
+    dense_report = hls_model.estimate_timing(sparse_input((4, 32), 0))
+    sparse_report = hls_model.estimate_timing(sparse_input((4, 32), 0.9))
+    assert sparse_report['latency'] < dense_report['latency']
+    assert sparse_report['layers']['fc1']['interval'] < dense_report['layers']['fc1']['interval']
+
+def test_pointwise_skip_zeros():
+    model = Sequential()
+    model.add(Conv1D(6, 1, input_shape=(10, 4), name='conv1'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<24,10>')
+    config['Model']['Strategy'] = 'Resource'
+    config['LayerName']['conv1']['ReuseFactor'] = 2
+    config['LayerName']['conv1']['SkipZeros'] = True
+    output_dir = str(test_root_path / 'hls4mlprj_pointwise_skip_zeros')
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+    hls_model.compile()
+    assert hls_model.graph['conv1'].get_attr('skip_zeros')
+
+    X = sparse_input((20, 10, 4), 0.6)
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
@@ -57,3 +57,36 @@ def test_softmax(backend, strategy, generate_data, input_shape, io_type, functio
     print('Accuracy hls4ml relative to keras: {}'.format(acc_hls4ml))
 
     assert acc_hls4ml >= 0.98
+
+
+@pytest.mark.parametrize('strategy', ['stable'])
+@pytest.mark.parametrize('function,input_shape', [
+                            (flat_distribution, (16,)),
+                            (high_accuracy_distribution, (16,)),
+                            (high_accuracy_distribution, (4, 16))
+                        ])
+def test_softmax_multibeat(strategy, generate_data, input_shape, function):
+    X = generate_data
+    model = tf.keras.models.Sequential()
+    model.add(tf.keras.layers.Activation(input_shape=input_shape, activation='softmax', name='softmax'))
+    model.compile()
+
+    cfg = hls4ml.utils.config_from_keras_model(model, granularity='name')
+    cfg['LayerName']['softmax']['Strategy'] = strategy
+    cfg['LayerName']['softmax']['inv_table_t'] = 'ap_fixed<18,8,AP_RND,AP_SAT>'
+    cfg['LayerName']['softmax']['exp_table_t'] = 'ap_fixed<18,8,AP_RND,AP_SAT>'
+    # Stream the softmax axis as 4 words of 4 elements
+    cfg['LayerName']['softmax']['PackSize'] = 4
+
+    odir = str(test_root_path / 'hls4mlprj_softmax_multibeat_{}_{}_{}').format(strategy, function.__name__, str(input_shape))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=cfg, io_type='io_stream',
+                                                           output_dir=odir, backend='Vivado')
+    hls_model.compile()
+
+    y_keras = model.predict(X)
+    y_hls4ml = hls_model.predict(X).reshape(y_keras.shape)
+    acc_hls4ml = accuracy_score(np.argmax(y_keras, axis=-1).ravel(), np.argmax(y_hls4ml, axis=-1).ravel())
+
+    print('Accuracy hls4ml relative to keras: {}'.format(acc_hls4ml))
+
+    assert acc_hls4ml >= 0.98
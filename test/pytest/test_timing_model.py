@@ -0,0 +1,55 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Conv1D, Activation
+
+test_root_path = Path(__file__).parent
+
+@pytest.fixture(scope='module')
+def model():
+    model = Sequential()
+    model.add(Conv1D(4, 3, input_shape=(32, 2), name='conv1'))
+    model.add(Activation('relu', name='relu1'))
+    model.add(Conv1D(4, 3, name='conv2'))
+    model.compile()
+    return model
+
+def make_hls_model(model, name, conv2_reuse):
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<18,8>')
+    config['Model']['Strategy'] = 'Resource'
+    config['LayerName']['conv2']['ReuseFactor'] = conv2_reuse
+    output_dir = str(test_root_path / 'hls4mlprj_timing_model_{}'.format(name))
+    return hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type='io_stream', output_dir=output_dir)
+
+def test_timing_model(model):
+    X = np.random.rand(2, 32, 2)
+
+    hls_model = make_hls_model(model, 'rf1', 1)
+    hls_model.compile()
+    y = hls_model.predict(X)
+    report = hls_model.estimate_timing(X)
+    # The timing model doesn't change the results
+    np.testing.assert_array_equal(hls_model.predict(X), y)
+    assert report['latency'] > 0
+    assert set(report['layers'].keys()) >= {'conv1', 'relu1', 'conv2'}
+
+    # A larger reuse factor of the last layer makes it the bottleneck of the design
+    slow_model = make_hls_model(model, 'rf6', 6)
+    slow_model.compile()
+    slow_report = slow_model.estimate_timing(X)
+    assert slow_report['interval'] > report['interval']
+    assert slow_report['latency'] > report['latency']
+    assert slow_report['interval'] == slow_report['layers']['conv2']['interval']
+    assert all(fifo['full_stalls'] == 0 for fifo in slow_report['fifos'].values())
+
+    # With shallow FIFOs, the producers wait for the bottleneck
+    shallow_model = make_hls_model(model, 'rf6_shallow', 6)
+    for layer in shallow_model.get_layers():
+        if layer.name in ['conv1', 'relu1']:
+            layer.get_output_variable().pragma = ('stream', 2)
+    shallow_model.compile()
+    shallow_report = shallow_model.estimate_timing(X)
+    assert shallow_report['latency'] == slow_report['latency']
+    assert all(fifo['full_stalls'] > 0 and fifo['max_occupancy'] <= 2 for fifo in shallow_report['fifos'].values())
@@ -0,0 +1,38 @@
+import pytest
+import hls4ml
+import numpy as np
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense, Activation
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('io_type', ['io_parallel', 'io_stream'])
+@pytest.mark.parametrize('k, scores', [(1, False), (3, True)])
+def test_topk(io_type, k, scores):
+    # A softmax at the output is replaced with the indices of the k largest inputs (and optionally their values)
+    model = Sequential()
+    model.add(Dense(10, input_shape=(12,), name='fc1'))
+    model.add(Activation('softmax', name='softmax'))
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<18,8>')
+    config['LayerName']['softmax']['TopK'] = k
+    config['LayerName']['softmax']['TopKScores'] = scores
+    output_dir = str(test_root_path / 'hls4mlprj_topk_{}_{}'.format(io_type, k))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, io_type=io_type, output_dir=output_dir)
+    assert hls_model.graph['softmax'].class_name == 'TopK'
+    hls_model.compile()
+
+    X = np.random.rand(200, 12)
+    logits = X @ model.layers[0].get_weights()[0] + model.layers[0].get_weights()[1]
+    y = hls_model.predict(X)
+    if scores:
+        indices, values = y
+        np.testing.assert_allclose(values, np.take_along_axis(logits, indices.astype(int), axis=1), rtol=0, atol=0.05)
+        assert (np.diff(values, axis=1) <= 0).all()
+    else:
+        indices = y.reshape(-1, 1)
+    ref = np.argsort(-logits, axis=1, kind='stable')[:, :k]
+    # Fixed-point rounding of the logits may swap near-ties
+    assert np.mean(np.any(indices.astype(int) != ref, axis=1)) < 0.05
@@ -0,0 +1,44 @@
+import pytest
+import hls4ml
+import numpy as np
+import os
+import shutil
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Dense
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('backend', ['Vivado', 'VivadoAccelerator'])
+def test_vivado_precompiled_header(monkeypatch, backend):
+    # The model-independent headers are precompiled once and shared by the projects through the cache
+    cache_dir = test_root_path / 'hls4mlprj_vivado_build_cache_{}'.format(backend) / 'cache'
+    shutil.rmtree(cache_dir, ignore_errors=True)
+    monkeypatch.setenv('HLS4ML_CACHE_DIR', str(cache_dir))
+
+    model = Sequential()
+    model.add(Dense(8, input_shape=(10,), name='fc1'))
+    model.add(Dense(4, name='fc2'))
+    model.compile()
+
+    X = np.random.rand(20, 10)
+
+    config = hls4ml.utils.config_from_keras_model(model, granularity='name', default_precision='ap_fixed<18,8>')
+    y_hls = []
+    for prj in ['prj_a', 'prj_b']:
+        output_dir = str(test_root_path / 'hls4mlprj_vivado_build_cache_{}'.format(backend) / prj)
+        hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, backend=backend, output_dir=output_dir)
+        hls_model.compile()
+        y_hls.append(hls_model.predict(X))
+
+        # The project uses the cached precompiled header
+        pch = Path(output_dir) / 'firmware' / 'nnet_utils' / 'nnet_precompiled.h.gch'
+        assert pch.is_symlink()
+        assert pch.resolve().parent == (cache_dir / 'pch').resolve()
+
+    # The precompiled header doesn't depend on the model, so it is shared by both projects
+    assert len(os.listdir(cache_dir / 'pch')) == 1
+    np.testing.assert_array_equal(y_hls[0], y_hls[1])
+
+    y_keras = model.predict(X)
+    np.testing.assert_allclose(y_hls[1], y_keras, rtol=0, atol=0.05)
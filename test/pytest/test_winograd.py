@@ -0,0 +1,53 @@
+import pytest
+import hls4ml
+import numpy as np
+from fractions import Fraction
+from pathlib import Path
+from tensorflow.keras.models import Sequential
+from tensorflow.keras.layers import Conv1D, Conv2D
+from hls4ml.backends.quartus.passes.convolution_winograd import winograd_matrices
+
+test_root_path = Path(__file__).parent
+
+@pytest.mark.parametrize('m, r', [(2, 3), (4, 3), (6, 3), (2, 5), (4, 5)])
+def test_winograd_matrices(m, r):
+    # A' [(G g) * (B' d)] must equal the correlation of d and g exactly, with integer B' and A'
+    AT, G, BT = winograd_matrices(m, r)
+    assert all(b.denominator == 1 for row in BT for b in row)
+    assert all(a.denominator == 1 for row in AT for a in row)
+
+    n = m + r - 1
+    rng = np.random.default_rng(0)
+    d = [Fraction(int(x)) for x in rng.integers(-8, 8, n)]
+    g = [Fraction(int(x)) for x in rng.integers(-8, 8, r)]
+    U = [sum(G[i][k] * g[k] for k in range(r)) for i in range(n)]
+    V = [sum(BT[i][j] * d[j] for j in range(n)) for i in range(n)]
+    y = [sum(AT[i][j] * U[j] * V[j] for j in range(n)) for i in range(m)]
+    expected = [sum(g[k] * d[i + k] for k in range(r)) for i in range(m)]
+    assert y == expected
+
+@pytest.mark.parametrize('dims', [1, 2])
+@pytest.mark.parametrize('kernel_size, tile', [(3, 2), (3, 4), (3, 6), (5, 2), (5, 4)])
+def test_winograd_conv(dims, kernel_size, tile):
+    model = Sequential()
+    if dims == 1:
+        model.add(Conv1D(4, kernel_size, padding='same', input_shape=(14, 3)))
+        X = np.random.rand(10, 14, 3)
+    else:
+        model.add(Conv2D(4, (kernel_size, kernel_size), padding='same', input_shape=(14, 13, 3)))
+        X = np.random.rand(10, 14, 13, 3)
+    model.compile()
+
+    config = hls4ml.utils.config_from_keras_model(model, default_precision='ac_fixed<18,8,true>')
+    config['Model']['WinogradTile'] = tile
+    output_dir = str(test_root_path / 'hls4mlprj_winograd_conv{}d_{}_{}'.format(dims, kernel_size, tile))
+    hls_model = hls4ml.converters.convert_from_keras_model(model, hls_config=config, backend='Quartus', io_type='io_parallel', output_dir=output_dir)
+    hls_model.compile()
+
+    conv = list(hls_model.get_layers())[1]
+    assert conv.get_attr('winograd_tile') == tile
+    assert conv.get_attr('impl_filt_width') == tile + kernel_size - 1
+
+    y_keras = model.predict(X)
+    y_hls = hls_model.predict(X).reshape(y_keras.shape)
+    np.testing.assert_allclose(y_hls, y_keras, rtol=0, atol=0.02)
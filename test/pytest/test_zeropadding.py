@@ -46,6 +46,7 @@ def keras_model_2d():
 
 @pytest.mark.parametrize('backend, io_type', [
                             ('Quartus', 'io_parallel'),
+                            ('Quartus', 'io_stream'),
 
                             ('Vivado', 'io_parallel'),
                             ('Vivado','io_stream')